@@ -1413,7 +1413,19 @@ QString qFormatLogMessage(QtMsgType type, const QMessageLogContext &context, con
 {
     QString message;
 
-    const auto locker = qt_scoped_lock(QMessagePattern::mutex);
+    auto locker = qt_unique_lock(QMessagePattern::mutex);
+
+#if !defined(QT_BOOTSTRAPPED) && QT_CONFIG(datestring)
+    // Formatting the current date and time is comparatively expensive and
+    // does not need the pattern, so it is done after releasing the mutex,
+    // instead of serializing all threads that log at the same time on it.
+    struct DeferredTime
+    {
+        qsizetype position;
+        QString format;
+    };
+    QVarLengthArray<DeferredTime, 2> deferredTimes;
+#endif
 
     QMessagePattern *pattern = qMessagePattern();
     if (!pattern) {
@@ -1503,10 +1515,8 @@ QString qFormatLogMessage(QtMsgType type, const QMessageLogContext &context, con
                 uint ms = QDeadlineTimer::current().deadline();
                 message.append(QString::asprintf("%6d.%03d", uint(ms / 1000), uint(ms % 1000)));
 #if QT_CONFIG(datestring)
-            } else if (timeFormat.isEmpty()) {
-                    message.append(QDateTime::currentDateTime().toString(Qt::ISODate));
             } else {
-                message.append(QDateTime::currentDateTime().toString(timeFormat));
+                deferredTimes.append({ message.size(), std::move(timeFormat) });
 #endif // QT_CONFIG(datestring)
             }
 #endif // !QT_BOOTSTRAPPED
@@ -1526,6 +1536,18 @@ QString qFormatLogMessage(QtMsgType type, const QMessageLogContext &context, con
             message.append(QLatin1StringView(token));
         }
     }
+
+#if !defined(QT_BOOTSTRAPPED) && QT_CONFIG(datestring)
+    if (!deferredTimes.isEmpty()) {
+        locker.unlock();
+        const QDateTime now = QDateTime::currentDateTime();
+        // back to front, so that the earlier positions stay valid
+        for (auto it = deferredTimes.crbegin(); it != deferredTimes.crend(); ++it) {
+            message.insert(it->position, it->format.isEmpty() ? now.toString(Qt::ISODate)
+                                                              : now.toString(it->format));
+        }
+    }
+#endif
     return message;
 }
 
@@ -97,7 +97,7 @@ public:
 
     bool entryMatches(const QString & fileName, const QFileInfo &fileInfo);
     void pushDirectory(const QFileInfo &fileInfo);
-    void checkAndPushDirectory(const QFileInfo &);
+    void checkAndPushDirectory(const QString &fileName, const QFileInfo &);
     bool matchesFilters(const QString &fileName, const QFileInfo &fi) const;
 
     std::unique_ptr<QAbstractFileEngine> engine;
@@ -191,7 +191,7 @@ void QDirIteratorPrivate::pushDirectory(const QFileInfo &fileInfo)
 
 inline bool QDirIteratorPrivate::entryMatches(const QString & fileName, const QFileInfo &fileInfo)
 {
-    checkAndPushDirectory(fileInfo);
+    checkAndPushDirectory(fileName, fileInfo);
 
     if (matchesFilters(fileName, fileInfo)) {
         currentFileInfo = nextFileInfo;
@@ -251,7 +251,7 @@ void QDirIteratorPrivate::advance()
 /*!
     \internal
  */
-void QDirIteratorPrivate::checkAndPushDirectory(const QFileInfo &fileInfo)
+void QDirIteratorPrivate::checkAndPushDirectory(const QString &fileName, const QFileInfo &fileInfo)
 {
     // If we're doing flat iteration, we're done.
     if (!(iteratorFlags & QDirIterator::Subdirectories))
@@ -266,7 +266,6 @@ void QDirIteratorPrivate::checkAndPushDirectory(const QFileInfo &fileInfo)
         return;
 
     // Never follow . and ..
-    QString fileName = fileInfo.fileName();
     if ("."_L1 == fileName || ".."_L1 == fileName)
         return;
 
@@ -644,6 +644,21 @@ bool QFileDevice::setPermissions(Permissions permissions)
     memory is unmapped.  It is unspecified whether modifications made
     to the file made after the mapping is created will be visible through
     the mapped memory. This enum value was introduced in Qt 5.4.
+    \value MapPrefaultOption Read the whole mapped range into memory
+    before map() returns, so that later accesses do not fault. This enum
+    value was introduced in Qt 6.5.
+    \value MapSequentialAccessOption Hint that the mapped memory will be
+    accessed sequentially, so the operating system can read ahead more
+    aggressively and drop pages behind the access. This enum value was
+    introduced in Qt 6.5.
+    \value MapRandomAccessOption Hint that the mapped memory will be
+    accessed in random order, so the operating system should not read
+    ahead. This enum value was introduced in Qt 6.5.
+
+    The last three options are hints: platforms that do not support them
+    ignore them, and map() does not fail because of them.
+    MapSequentialAccessOption and MapRandomAccessOption are mutually
+    exclusive; passing both is the same as passing neither.
 */
 
 /*!
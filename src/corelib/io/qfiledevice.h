@@ -84,7 +84,10 @@ public:
 
     enum MemoryMapFlag {
         NoOptions = 0,
-        MapPrivateOption = 0x0001
+        MapPrivateOption = 0x0001,
+        MapPrefaultOption = 0x0002,
+        MapSequentialAccessOption = 0x0004,
+        MapRandomAccessOption = 0x0008
     };
     Q_DECLARE_FLAGS(MemoryMapFlags, MemoryMapFlag)
 
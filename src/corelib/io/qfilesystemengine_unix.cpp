@@ -583,6 +583,14 @@ void QFileSystemMetaData::fillFromDirEnt(const QT_DIRENT &entry)
 #else
     Q_UNUSED(entry);
 #endif
+
+#if !defined(UF_HIDDEN)
+    // Without file flags, whether an entry is hidden depends only on its
+    // name, so answer it here instead of in a later fillMetaData() call.
+    knownFlagsMask |= QFileSystemMetaData::HiddenAttribute;
+    if (entry.d_name[0] == '.')
+        entryFlags |= QFileSystemMetaData::HiddenAttribute;
+#endif
 }
 
 //static
@@ -59,7 +59,10 @@ bool QFileSystemIterator::advance(QFileSystemEntry &fileEntry, QFileSystemMetaDa
         if (dirEntry) {
             qsizetype len = strlen(dirEntry->d_name);
             if (checkNameDecodable(dirEntry->d_name, len)) {
-                fileEntry = QFileSystemEntry(nativePath + QByteArray(dirEntry->d_name, len), QFileSystemEntry::FromNativePath());
+                QByteArray filePath;
+                filePath.reserve(nativePath.size() + len);
+                filePath.append(nativePath).append(dirEntry->d_name, len);
+                fileEntry = QFileSystemEntry(filePath, QFileSystemEntry::FromNativePath());
                 metaData.fillFromDirEnt(*dirEntry);
                 return true;
             }
@@ -11,6 +11,7 @@
 #include <qfile.h>
 #include <qfileinfo.h>
 #include <qscopeguard.h>
+#include <qset.h>
 #include <qsocketnotifier.h>
 #include <qvarlengtharray.h>
 
@@ -238,13 +239,11 @@ QStringList QInotifyFileSystemWatcherEngine::addPaths(const QStringList &paths,
         QFileInfo fi(path);
         bool isDir = fi.isDir();
         auto sg = qScopeGuard([&]{ unhandled.push_back(path); });
-        if (isDir) {
-            if (directories->contains(path))
-                continue;
-        } else {
-            if (files->contains(path))
-                continue;
-        }
+        // Look the path up in our own hash rather than in the (potentially
+        // huge) lists, which would make adding many paths quadratic.
+        const auto existing = pathToID.constFind(path);
+        if (existing != pathToID.cend() && (*existing < 0) == isDir)
+            continue;
 
         int wd = inotify_add_watch(inotifyFd,
                                    QFile::encodeName(path),
@@ -290,6 +289,7 @@ QStringList QInotifyFileSystemWatcherEngine::removePaths(const QStringList &path
                                                          QStringList *directories)
 {
     QStringList unhandled;
+    QSet<QString> removedFiles, removedDirectories;
     for (const QString &path : paths) {
         int id = pathToID.take(path);
 
@@ -315,13 +315,18 @@ QStringList QInotifyFileSystemWatcherEngine::removePaths(const QStringList &path
 
         sg.dismiss();
 
-        if (id < 0) {
-            directories->removeAll(path);
-        } else {
-            files->removeAll(path);
-        }
+        if (id < 0)
+            removedDirectories.insert(path);
+        else
+            removedFiles.insert(path);
     }
 
+    // Prune the lists in one pass each, instead of once per removed path
+    if (!removedDirectories.isEmpty())
+        directories->removeIf([&](const QString &p) { return removedDirectories.contains(p); });
+    if (!removedFiles.isEmpty())
+        files->removeIf([&](const QString &p) { return removedFiles.contains(p); });
+
     return unhandled;
 }
 
@@ -342,10 +347,11 @@ void QInotifyFileSystemWatcherEngine::readFromInotify()
     while (at < end) {
         inotify_event *event = reinterpret_cast<inotify_event *>(at);
 
-        if (eventForId.contains(event->wd))
-            eventForId[event->wd]->mask |= event->mask;
+        inotify_event *&coalesced = eventForId[event->wd];
+        if (coalesced)
+            coalesced->mask |= event->mask;
         else
-            eventForId.insert(event->wd, event);
+            coalesced = event;
 
         at += sizeof(inotify_event) + event->len;
     }
@@ -534,6 +534,31 @@ bool QFSFileEngine::setFileTime(const QDateTime &newDate, FileTime time)
     return true;
 }
 
+static void adviseMapping(void *address, size_t size, QFile::MemoryMapFlags flags)
+{
+    // These are only hints, so failures are deliberately ignored
+    int advice = -1;
+#if defined(MADV_SEQUENTIAL) && defined(MADV_RANDOM)
+    const auto accessFlags = flags & (QFileDevice::MapSequentialAccessOption
+                                      | QFileDevice::MapRandomAccessOption);
+    if (accessFlags == QFileDevice::MapSequentialAccessOption)
+        advice = MADV_SEQUENTIAL;
+    else if (accessFlags == QFileDevice::MapRandomAccessOption)
+        advice = MADV_RANDOM;
+#endif
+    if (advice != -1)
+        madvise(address, size, advice);
+
+#ifdef MADV_WILLNEED
+    bool populated = false;
+#  ifdef MAP_POPULATE
+    populated = !(flags & QFileDevice::MapPrivateOption);
+#  endif
+    if ((flags & QFileDevice::MapPrefaultOption) && !populated)
+        madvise(address, size, MADV_WILLNEED);
+#endif
+}
+
 uchar *QFSFileEnginePrivate::map(qint64 offset, qint64 size, QFile::MemoryMapFlags flags)
 {
     qint64 maxFileOffset = std::numeric_limits<QT_OFF_T>::max();
@@ -575,6 +600,12 @@ uchar *QFSFileEnginePrivate::map(qint64 offset, qint64 size, QFile::MemoryMapFla
         sharemode = MAP_PRIVATE;
         access |= PROT_WRITE;
     }
+#ifdef MAP_POPULATE
+    // Populating a private writable mapping would break copy-on-write for
+    // every page, so leave those to the MADV_WILLNEED hint below.
+    if ((flags & QFileDevice::MapPrefaultOption) && sharemode == MAP_SHARED)
+        sharemode |= MAP_POPULATE;
+#endif
 
 #if defined(Q_OS_INTEGRITY)
     int pageSize = sysconf(_SC_PAGESIZE);
@@ -595,6 +626,7 @@ uchar *QFSFileEnginePrivate::map(qint64 offset, qint64 size, QFile::MemoryMapFla
     void *mapAddress = QT_MMAP((void*)nullptr, realSize,
                    access, sharemode, nativeHandle(), realOffset);
     if (MAP_FAILED != mapAddress) {
+        adviseMapping(mapAddress, realSize, flags);
         uchar *address = extra + static_cast<uchar*>(mapAddress);
         maps[address] = {extra, realSize};
         return address;
@@ -1040,8 +1040,13 @@ qint64 QIODevice::read(char *data, qint64 maxSize)
 
 /*!
     \internal
+
+    If \a bypassBuffer is \c true, data that is not already buffered is read
+    from the device straight into \a data, even if \a maxSize is smaller than
+    the read buffer chunk size. Callers use this when they know there is
+    nothing to gain from buffering, such as when reading the whole device.
 */
-qint64 QIODevicePrivate::read(char *data, qint64 maxSize, bool peeking)
+qint64 QIODevicePrivate::read(char *data, qint64 maxSize, bool peeking, bool bypassBuffer)
 {
     Q_Q(QIODevice);
 
@@ -1079,7 +1084,8 @@ qint64 QIODevicePrivate::read(char *data, qint64 maxSize, bool peeking)
             // Make sure the device is positioned correctly.
             if (sequential || pos == devicePos || q->seek(pos)) {
                 madeBufferReadsOnly = false; // fix readData attempt
-                if ((!buffered || maxSize >= readBufferChunkSize) && !keepDataInBuffer) {
+                if ((!buffered || bypassBuffer || maxSize >= readBufferChunkSize)
+                        && !keepDataInBuffer) {
                     // Read big chunk directly to output buffer
                     readFromDevice = q->readData(data, maxSize);
                     deviceAtEof = (readFromDevice != maxSize);
@@ -1262,12 +1268,13 @@ QByteArray QIODevice::readAll()
             }
         } while (readResult > 0);
     } else {
-        // Read it all in one go.
+        // Read it all in one go. Nothing would be left over to keep in the
+        // read buffer, so read straight into the result.
         readBytes -= d->pos;
         if (readBytes >= MaxByteArraySize)
             readBytes = MaxByteArraySize;
         result.resize(readBytes);
-        readBytes = d->read(result.data(), readBytes);
+        readBytes = d->read(result.data(), readBytes, false, true);
     }
 
     if (readBytes <= 0)
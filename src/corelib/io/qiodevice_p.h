@@ -144,7 +144,7 @@ public:
     void setReadChannelCount(int count);
     void setWriteChannelCount(int count);
 
-    qint64 read(char *data, qint64 maxSize, bool peeking = false);
+    qint64 read(char *data, qint64 maxSize, bool peeking = false, bool bypassBuffer = false);
     qint64 readLine(char *data, qint64 maxSize);
     virtual qint64 peek(char *data, qint64 maxSize);
     virtual QByteArray peek(qint64 maxSize);
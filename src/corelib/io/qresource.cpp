@@ -5,6 +5,7 @@
 #include "qresource.h"
 #include "qresource_p.h"
 #include "qresource_iterator_p.h"
+#include "qcache.h"
 #include "qset.h"
 #include <private/qlocking_p.h>
 #include "qdebug.h"
@@ -111,6 +112,7 @@ private:
     inline int findOffset(int node) const { return node * (14 + (version >= 0x02 ? 8 : 0)); } //sizeof each tree element
     uint hash(int node) const;
     QString name(int node) const;
+    bool nameEquals(int node, QStringView name) const;
     short flags(int node) const;
 public:
     mutable QAtomicInt ref;
@@ -168,9 +170,27 @@ struct QResourceGlobalData
     QRecursiveMutex resourceMutex;
     ResourceList resourceList;
     QStringList resourceSearchPaths;
+
+    // Recently decompressed payloads, keyed by their compressed data. Only
+    // ever locked on its own, never while acquiring resourceMutex.
+    static constexpr qsizetype DecompressedCacheCost = 4 * 1024 * 1024;
+    QBasicMutex decompressedMutex;
+    QCache<const uchar *, QByteArray> decompressed{DecompressedCacheCost};
 };
 Q_GLOBAL_STATIC(QResourceGlobalData, resourceGlobalData)
 
+// Called when resource data goes away, as its address may be reused for
+// different data later: when a library unregisters its resources on unload,
+// and when resources registered at run time are unregistered.
+static void clearDecompressedCache()
+{
+    if (resourceGlobalData.isDestroyed())
+        return;
+    QResourceGlobalData *global = resourceGlobalData();
+    const auto locker = qt_scoped_lock(global->decompressedMutex);
+    global->decompressed.clear();
+}
+
 static inline QRecursiveMutex &resourceMutex()
 { return resourceGlobalData->resourceMutex; }
 
@@ -670,8 +690,9 @@ const uchar *QResource::data() const
     compressed. If the resource is a directory or an error occurs while
     decompressing, a null QByteArray is returned.
 
-    \note If the data was compressed, this function will decompress every time
-    it is called. The result is not cached between calls.
+    \note If the data was compressed, this function decompresses it unless
+    it was decompressed recently; a small amount of recently decompressed
+    data is kept in a process-wide cache.
 
     \sa uncompressedSize(), size(), compressionAlgorithm(), isFile()
 */
@@ -689,13 +710,25 @@ QByteArray QResource::uncompressedData() const
     if (d->compressionAlgo == NoCompression)
         return QByteArray::fromRawData(reinterpret_cast<const char *>(d->data), n);
 
+    QResourceGlobalData *global = resourceGlobalData.isDestroyed() ? nullptr : resourceGlobalData();
+    if (global) {
+        const auto locker = qt_scoped_lock(global->decompressedMutex);
+        if (const QByteArray *cached = global->decompressed.object(d->data))
+            return *cached;
+    }
+
     // decompress
     QByteArray result(n, Qt::Uninitialized);
     n = d->decompress(result.data(), n);
     if (n < 0)
-        result.clear();
-    else
-        result.truncate(n);
+        return QByteArray();
+    result.truncate(n);
+
+    if (global) {
+        // the cache rejects (and deletes) entries that exceed its capacity
+        const auto locker = qt_scoped_lock(global->decompressedMutex);
+        global->decompressed.insert(d->data, new QByteArray(result), result.size());
+    }
     return result;
 }
 
@@ -767,6 +800,27 @@ inline QString QResourceRoot::name(int node) const
     return ret;
 }
 
+inline bool QResourceRoot::nameEquals(int node, QStringView name) const
+{
+    if (!node) // root
+        return name.isEmpty();
+    const int offset = findOffset(node);
+
+    qint32 name_offset = qFromBigEndian<qint32>(tree + offset);
+    const quint16 name_length = qFromBigEndian<qint16>(names + name_offset);
+    if (name_length != name.size())
+        return false;
+    name_offset += 2;
+    name_offset += 4; // jump past hash
+
+    const uchar *data = names + name_offset;
+    for (qsizetype i = 0; i < name.size(); ++i, data += 2) {
+        if (qFromBigEndian<char16_t>(data) != name[i].unicode())
+            return false;
+    }
+    return true;
+}
+
 int QResourceRoot::findNode(const QString &_path, const QLocale &locale) const
 {
     QString path = _path;
@@ -833,7 +887,7 @@ int QResourceRoot::findNode(const QString &_path, const QLocale &locale) const
                 --sub_node;
             for (; sub_node < child + child_count && hash(sub_node) == h;
                  ++sub_node) { // here we go...
-                if (name(sub_node) == segment) {
+                if (nameEquals(sub_node, segment)) {
                     found = true;
                     int offset = findOffset(sub_node);
 #ifdef DEBUG_RESOURCE_MATCH
@@ -1014,15 +1068,19 @@ Q_CORE_EXPORT bool qUnregisterResourceData(int version, const unsigned char *tre
     if (version >= 0x01 && version <= 0x3) {
         QResourceRoot res(version, tree, name, data);
         ResourceList *list = resourceList();
+        bool removed = false;
         for (int i = 0; i < list->size();) {
             if (*list->at(i) == res) {
                 QResourceRoot *root = list->takeAt(i);
                 if (!root->ref.deref())
                     delete root;
+                removed = true;
             } else {
                 ++i;
             }
         }
+        if (removed)
+            clearDecompressedCache();
         return true;
     }
     return false;
@@ -1037,7 +1095,7 @@ class QDynamicBufferResourceRoot : public QResourceRoot
 
 public:
     inline QDynamicBufferResourceRoot(const QString &_root) : root(_root), buffer(nullptr) { }
-    inline ~QDynamicBufferResourceRoot() { }
+    inline ~QDynamicBufferResourceRoot() { clearDecompressedCache(); }
     inline const uchar *mappingBuffer() const { return buffer; }
     QString mappingRoot() const override { return root; }
     ResourceRootType type() const override { return Resource_Buffer; }
@@ -1112,6 +1170,7 @@ public:
         : QDynamicBufferResourceRoot(_root), unmapPointer(nullptr), unmapLength(0)
     { }
     ~QDynamicFileResourceRoot() {
+        clearDecompressedCache();
 #if defined(QT_USE_MMAP)
         if (unmapPointer) {
             munmap(reinterpret_cast<char *>(unmapPointer), unmapLength);
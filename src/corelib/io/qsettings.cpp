@@ -1158,7 +1158,7 @@ void QConfFileSettingsPrivate::remove(const QString &key)
 
     QSettingsKey theKey(key, caseSensitivity);
     QSettingsKey prefix(key + u'/', caseSensitivity);
-    const auto locker = qt_scoped_lock(confFile->mutex);
+    QWriteLocker locker(&confFile->lock);
 
     ensureSectionParsed(confFile, theKey);
     ensureSectionParsed(confFile, prefix);
@@ -1186,7 +1186,7 @@ void QConfFileSettingsPrivate::set(const QString &key, const QVariant &value)
     QConfFile *confFile = confFiles.at(0);
 
     QSettingsKey theKey(key, caseSensitivity, nextPosition++);
-    const auto locker = qt_scoped_lock(confFile->mutex);
+    QWriteLocker locker(&confFile->lock);
     confFile->removedKeys.remove(theKey);
     confFile->addedKeys.insert(theKey, value);
 }
@@ -1194,31 +1194,55 @@ void QConfFileSettingsPrivate::set(const QString &key, const QVariant &value)
 std::optional<QVariant> QConfFileSettingsPrivate::get(const QString &key) const
 {
     QSettingsKey theKey(key, caseSensitivity);
-    ParsedSettingsMap::const_iterator j;
-    bool found = false;
 
     for (auto confFile : qAsConst(confFiles)) {
-        const auto locker = qt_scoped_lock(confFile->mutex);
-
-        if (!confFile->addedKeys.isEmpty()) {
-            j = confFile->addedKeys.constFind(theKey);
-            found = (j != confFile->addedKeys.constEnd());
+        std::optional<QVariant> value;
+        bool looked = false;
+        {
+            // Many QSettings objects, possibly in different threads, read
+            // the same file; let them do so concurrently unless the section
+            // holding the key has yet to be parsed.
+            QReadLocker locker(&confFile->lock);
+            if (unparsedSection(confFile, theKey) == confFile->unparsedIniSections.cend()) {
+                value = findKey(confFile, theKey);
+                looked = true;
+            }
         }
-        if (!found) {
+        if (!looked) {
+            QWriteLocker locker(&confFile->lock);
             ensureSectionParsed(confFile, theKey);
-            j = confFile->originalKeys.constFind(theKey);
-            found = (j != confFile->originalKeys.constEnd()
-                     && !confFile->removedKeys.contains(theKey));
+            value = findKey(confFile, theKey);
         }
 
-        if (found)
-            return *j;
+        if (value)
+            return value;
         if (!fallbacks)
             break;
     }
     return std::nullopt;
 }
 
+/*!
+    \internal
+
+    Returns the value of \a key in \a confFile, taking changes that have not
+    been synced yet into account. The caller must hold the file's lock and
+    have made sure the key's section was parsed.
+*/
+std::optional<QVariant> QConfFileSettingsPrivate::findKey(const QConfFile *confFile,
+                                                         const QSettingsKey &key)
+{
+    if (!confFile->addedKeys.isEmpty()) {
+        auto j = confFile->addedKeys.constFind(key);
+        if (j != confFile->addedKeys.constEnd())
+            return *j;
+    }
+    auto j = confFile->originalKeys.constFind(key);
+    if (j != confFile->originalKeys.constEnd() && !confFile->removedKeys.contains(key))
+        return *j;
+    return std::nullopt;
+}
+
 QStringList QConfFileSettingsPrivate::children(const QString &prefix, ChildSpec spec) const
 {
     QStringList result;
@@ -1227,7 +1251,7 @@ QStringList QConfFileSettingsPrivate::children(const QString &prefix, ChildSpec
     qsizetype startPos = prefix.size();
 
     for (auto confFile : qAsConst(confFiles)) {
-        const auto locker = qt_scoped_lock(confFile->mutex);
+        QWriteLocker locker(&confFile->lock);
 
         if (thePrefix.isEmpty())
             ensureAllSectionsParsed(confFile);
@@ -1266,7 +1290,7 @@ void QConfFileSettingsPrivate::clear()
     // Note: First config file is always the most specific.
     QConfFile *confFile = confFiles.at(0);
 
-    const auto locker = qt_scoped_lock(confFile->mutex);
+    QWriteLocker locker(&confFile->lock);
     ensureAllSectionsParsed(confFile);
     confFile->addedKeys.clear();
     confFile->removedKeys = confFile->originalKeys;
@@ -1278,7 +1302,7 @@ void QConfFileSettingsPrivate::sync()
     // error we just try to go on and make the best of it
 
     for (auto confFile : qAsConst(confFiles)) {
-        const auto locker = qt_scoped_lock(confFile->mutex);
+        QWriteLocker locker(&confFile->lock);
         syncConfFile(confFile);
     }
 }
@@ -1834,27 +1858,43 @@ void QConfFileSettingsPrivate::ensureAllSectionsParsed(QConfFile *confFile) cons
     confFile->unparsedIniSections.clear();
 }
 
-void QConfFileSettingsPrivate::ensureSectionParsed(QConfFile *confFile,
-                                                   const QSettingsKey &key) const
+/*!
+    \internal
+
+    Returns the not yet parsed INI section of \a confFile that \a key
+    belongs to, or the end iterator if there is none.
+*/
+UnparsedSettingsMap::const_iterator
+QConfFileSettingsPrivate::unparsedSection(const QConfFile *confFile, const QSettingsKey &key)
 {
-    if (confFile->unparsedIniSections.isEmpty())
-        return;
+    const UnparsedSettingsMap &sections = confFile->unparsedIniSections;
+    if (sections.isEmpty())
+        return sections.cend();
 
-    UnparsedSettingsMap::iterator i;
+    UnparsedSettingsMap::const_iterator i;
 
     qsizetype indexOfSlash = key.indexOf(u'/');
     if (indexOfSlash != -1) {
-        i = confFile->unparsedIniSections.upperBound(key);
-        if (i == confFile->unparsedIniSections.begin())
-            return;
+        i = sections.upperBound(key);
+        if (i == sections.cbegin())
+            return sections.cend();
         --i;
         if (i.key().isEmpty() || !key.startsWith(i.key()))
-            return;
+            return sections.cend();
     } else {
-        i = confFile->unparsedIniSections.begin();
-        if (i == confFile->unparsedIniSections.end() || !i.key().isEmpty())
-            return;
+        i = sections.cbegin();
+        if (i == sections.cend() || !i.key().isEmpty())
+            return sections.cend();
     }
+    return i;
+}
+
+void QConfFileSettingsPrivate::ensureSectionParsed(QConfFile *confFile,
+                                                   const QSettingsKey &key) const
+{
+    const auto i = unparsedSection(confFile, key);
+    if (i == confFile->unparsedIniSections.cend())
+        return;
 
     if (!QConfFileSettingsPrivate::readIniSection(i.key(), i.value(), &confFile->originalKeys))
         setStatus(QSettings::FormatError);
@@ -18,6 +18,7 @@
 #include "QtCore/qdatetime.h"
 #include "QtCore/qmap.h"
 #include "QtCore/qmutex.h"
+#include "QtCore/qreadwritelock.h"
 #include "QtCore/qiodevice.h"
 #include "QtCore/qstack.h"
 #include "QtCore/qstringlist.h"
@@ -131,7 +132,7 @@ public:
     ParsedSettingsMap addedKeys;
     ParsedSettingsMap removedKeys;
     QAtomicInt ref;
-    QMutex mutex;
+    QReadWriteLock lock; // reading keys only needs the read lock
     bool userPerms;
 
 private:
@@ -258,6 +259,9 @@ private:
 #endif
     void ensureAllSectionsParsed(QConfFile *confFile) const;
     void ensureSectionParsed(QConfFile *confFile, const QSettingsKey &key) const;
+    static UnparsedSettingsMap::const_iterator unparsedSection(const QConfFile *confFile,
+                                                               const QSettingsKey &key);
+    static std::optional<QVariant> findKey(const QConfFile *confFile, const QSettingsKey &key);
 
     QList<QConfFile *> confFiles;
     QSettings::ReadFunc readFunc;
@@ -829,6 +829,16 @@ static inline void appendToUser(QString &appendTo, QStringView value, QUrl::Form
         appendTo += value;
 }
 
+// Same as above, but if nothing needs recoding and appendTo is still null,
+// the result shares the stored component instead of copying it.
+static inline void appendToUser(QString &appendTo, const QString &value, QUrl::FormattingOptions options,
+                                const ushort *actions)
+{
+    if ((options & 0xFFFF0000) == QUrl::PrettyDecoded
+            || !qt_urlRecode(appendTo, value, options, actions))
+        appendTo += value;
+}
+
 inline void QUrlPrivate::appendAuthority(QString &appendTo, QUrl::FormattingOptions options, Section appendingTo) const
 {
     if ((options & QUrl::RemoveUserInfo) != QUrl::RemoveUserInfo) {
@@ -922,8 +932,12 @@ inline void QUrlPrivate::appendPath(QString &appendTo, QUrl::FormattingOptions o
             thePathView.chop(1);
     }
 
-    appendToUser(appendTo, thePathView, options,
-                 appendingTo == FullUrl || options & QUrl::EncodeDelimiters ? pathInUrl : pathInIsolation);
+    const ushort *actions =
+            appendingTo == FullUrl || options & QUrl::EncodeDelimiters ? pathInUrl : pathInIsolation;
+    if (thePathView.data() == thePath.constData() && thePathView.size() == thePath.size())
+        appendToUser(appendTo, thePath, options, actions);
+    else
+        appendToUser(appendTo, thePathView, options, actions);
 }
 
 inline void QUrlPrivate::appendFragment(QString &appendTo, QUrl::FormattingOptions options, Section appendingTo) const
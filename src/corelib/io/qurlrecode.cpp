@@ -333,6 +333,41 @@ static void unicodeToEncodedUtf8(QString &result, char16_t *&output, const char1
     }
 }
 
+/*
+ * Returns the first character at or after \a input that is not an ASCII
+ * letter or digit. Those are unreserved in every component, so no action
+ * table ever asks for them to be recoded.
+ */
+#ifdef __SSE2__
+static const char16_t *simdSkipAlphaNumeric(const char16_t *input, const char16_t *end)
+{
+    const __m128i lowerA = _mm_set1_epi16('a' - 1);
+    const __m128i lowerZ = _mm_set1_epi16('z' + 1);
+    const __m128i digit0 = _mm_set1_epi16('0' - 1);
+    const __m128i digit9 = _mm_set1_epi16('9' + 1);
+    const __m128i caseBit = _mm_set1_epi16(0x20);
+
+    for ( ; input + 8 <= end; input += 8) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input));
+        // folding the case bit maps 'A'-'Z' onto 'a'-'z' and nothing else onto it
+        const __m128i folded = _mm_or_si128(data, caseBit);
+        const __m128i isLetter = _mm_and_si128(_mm_cmpgt_epi16(folded, lowerA),
+                                               _mm_cmplt_epi16(folded, lowerZ));
+        const __m128i isDigit = _mm_and_si128(_mm_cmpgt_epi16(data, digit0),
+                                              _mm_cmplt_epi16(data, digit9));
+        const uint mask = ~uint(_mm_movemask_epi8(_mm_or_si128(isLetter, isDigit))) & 0xffffu;
+        if (mask)
+            return input + qCountTrailingZeroBits(mask) / 2;
+    }
+    return input;
+}
+#else
+static const char16_t *simdSkipAlphaNumeric(const char16_t *input, const char16_t *)
+{
+    return input;
+}
+#endif
+
 static int recode(QString &result, const char16_t *begin, const char16_t *end,
                   QUrl::ComponentFormattingOptions encoding, const uchar *actionTable,
                   bool retryBadEncoding)
@@ -344,7 +379,15 @@ static int recode(QString &result, const char16_t *begin, const char16_t *end,
     EncodingAction action = EncodeCharacter;
     for ( ; input != end; ++input) {
         char16_t c;
+        // skip over letters and digits in bulk, then
         // try a run where no change is necessary
+        if (const char16_t *run = simdSkipAlphaNumeric(input, end); run != input) {
+            if (output) {
+                memcpy(output, input, (run - input) * sizeof(char16_t));
+                output += run - input;
+            }
+            input = run;
+        }
         for ( ; input != end; ++input) {
             c = *input;
             if (c < 0x20U)
@@ -91,6 +91,11 @@ void QMimeDatabasePrivate::loadProviders()
     Providers currentProviders;
     std::swap(m_providers, currentProviders);
 
+#ifdef Q_OS_UNIX
+    // the providers may have been updated, so forget what they told us
+    m_fileResults.clear();
+#endif
+
     m_providers.reserve(mimeDirs.size() + (needInternalDB ? 1 : 0));
 
     for (const QString &mimeDir : mimeDirs) {
@@ -452,7 +457,31 @@ QMimeType QMimeDatabasePrivate::mimeTypeForFile(const QString &fileName,
     // In addition we want to follow symlinks.
     const QByteArray nativeFilePath = QFile::encodeName(fileName);
     QT_STATBUF statBuffer;
+    FileResult fileResult = {};
+    bool cacheResult = false;
     if (QT_STAT(nativeFilePath.constData(), &statBuffer) == 0) {
+        if (S_ISREG(statBuffer.st_mode) && mode != QMimeDatabase::MatchExtension) {
+            fileResult.device = qint64(statBuffer.st_dev);
+            fileResult.inode = qint64(statBuffer.st_ino);
+            fileResult.size = qint64(statBuffer.st_size);
+            fileResult.mtime = qint64(statBuffer.st_mtime) * 1000 * 1000 * 1000;
+            fileResult.ctime = qint64(statBuffer.st_ctime) * 1000 * 1000 * 1000;
+#  ifdef Q_OS_LINUX
+            fileResult.mtime += statBuffer.st_mtim.tv_nsec;
+            fileResult.ctime += statBuffer.st_ctim.tv_nsec;
+#  endif
+            fileResult.mode = mode;
+
+            // providers() may reload the database and clear the cache, so call it first
+            providers();
+            const FileResult *cached = m_fileResults.object(fileName);
+            if (cached && cached->device == fileResult.device && cached->inode == fileResult.inode
+                    && cached->size == fileResult.size && cached->mtime == fileResult.mtime
+                    && cached->ctime == fileResult.ctime && cached->mode == mode) {
+                return cached->mimeType;
+            }
+            cacheResult = true;
+        }
         if (S_ISDIR(statBuffer.st_mode))
             return mimeTypeForName(directoryMimeType());
         if (S_ISCHR(statBuffer.st_mode))
@@ -470,18 +499,27 @@ QMimeType QMimeDatabasePrivate::mimeTypeForFile(const QString &fileName,
         return mimeTypeForName(directoryMimeType());
 #endif
 
+    QMimeType result;
     switch (mode) {
     case QMimeDatabase::MatchDefault:
+        result = mimeTypeForFileNameAndData(fileName, nullptr);
         break;
     case QMimeDatabase::MatchExtension:
         return mimeTypeForFileExtension(fileName);
     case QMimeDatabase::MatchContent: {
         QFile file(fileName);
-        return mimeTypeForData(&file);
+        result = mimeTypeForData(&file);
+        break;
     }
     }
-    // MatchDefault:
-    return mimeTypeForFileNameAndData(fileName, nullptr);
+
+#ifdef Q_OS_UNIX
+    if (cacheResult) {
+        fileResult.mimeType = result;
+        m_fileResults.insert(fileName, new FileResult(std::move(fileResult)));
+    }
+#endif
+    return result;
 }
 
 QList<QMimeType> QMimeDatabasePrivate::allMimeTypes()
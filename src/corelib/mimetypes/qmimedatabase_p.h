@@ -24,6 +24,7 @@ QT_REQUIRE_CONFIG(mimetype);
 #include "qmimetype_p.h"
 #include "qmimeglobpattern_p.h"
 
+#include <QtCore/qcache.h>
 #include <QtCore/qelapsedtimer.h>
 #include <QtCore/qlist.h>
 #include <QtCore/qmutex.h>
@@ -84,6 +85,23 @@ private:
     mutable Providers m_providers;
     QElapsedTimer m_lastCheck;
 
+#ifdef Q_OS_UNIX
+    // Results of mimeTypeForFile() for regular files, valid for as long as
+    // the file (device, inode, size, modification and status change times)
+    // stays the same.
+    struct FileResult
+    {
+        qint64 device;
+        qint64 inode;
+        qint64 size;
+        qint64 mtime;
+        qint64 ctime;
+        QMimeDatabase::MatchMode mode;
+        QMimeType mimeType;
+    };
+    QCache<QString, FileResult> m_fileResults{4096};
+#endif
+
 public:
     QMutex mutex;
 };
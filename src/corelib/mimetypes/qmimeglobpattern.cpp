@@ -107,7 +107,17 @@ bool QMimeGlobPattern::matchFileName(const QString &inputFileName) const
     // The constructor takes care of putting case-insensitive patterns in lowercase.
     const QString fileName = m_caseSensitivity == Qt::CaseInsensitive
             ? inputFileName.toLower() : inputFileName;
+    return matchLowerCasedFileName(fileName);
+}
 
+/*!
+    \internal
+    Same as matchFileName(), but \a fileName must already be lowercase if this
+    pattern is case-insensitive. This lets QMimeGlobPatternList lowercase the
+    file name once instead of once per pattern.
+*/
+bool QMimeGlobPattern::matchLowerCasedFileName(const QString &fileName) const
+{
     const int patternLength = m_pattern.length();
     if (!patternLength)
         return false;
@@ -153,8 +163,7 @@ bool QMimeGlobPattern::matchFileName(const QString &inputFileName) const
     case OtherPattern:
         // Other fallback patterns: slow but correct method
 #if QT_CONFIG(regularexpression)
-        auto rx = QRegularExpression::fromWildcard(m_pattern);
-        return rx.match(fileName).hasMatch();
+        return m_regExp.match(fileName).hasMatch();
 #else
         return false;
 #endif
@@ -223,11 +232,14 @@ void QMimeGlobPatternList::match(QMimeGlobMatchResult &result,
                                  const QString &fileName) const
 {
 
+    QString lowerCaseFileName;
     QMimeGlobPatternList::const_iterator it = this->constBegin();
     const QMimeGlobPatternList::const_iterator endIt = this->constEnd();
     for (; it != endIt; ++it) {
         const QMimeGlobPattern &glob = *it;
-        if (glob.matchFileName(fileName)) {
+        if (!glob.isCaseSensitive() && lowerCaseFileName.isNull())
+            lowerCaseFileName = fileName.toLower();
+        if (glob.matchLowerCasedFileName(glob.isCaseSensitive() ? fileName : lowerCaseFileName)) {
             const QString pattern = glob.pattern();
             const int suffixLen = isSimplePattern(pattern) ? pattern.length() - 2 : 0;
             result.addMatch(glob.mimeType(), glob.weight(), pattern, suffixLen);
@@ -21,6 +21,9 @@ QT_REQUIRE_CONFIG(mimetype);
 
 #include <QtCore/qstringlist.h>
 #include <QtCore/qhash.h>
+#if QT_CONFIG(regularexpression)
+#include <QtCore/qregularexpression.h>
+#endif
 
 QT_BEGIN_NAMESPACE
 
@@ -49,6 +52,11 @@ public:
         m_caseSensitivity(s),
         m_patternType(detectPatternType(m_pattern))
     {
+#if QT_CONFIG(regularexpression)
+        // compile the fallback patterns once, instead of on each match
+        if (m_patternType == OtherPattern)
+            m_regExp = QRegularExpression::fromWildcard(m_pattern);
+#endif
     }
 
     void swap(QMimeGlobPattern &other) noexcept
@@ -58,9 +66,13 @@ public:
         qSwap(m_weight,          other.m_weight);
         qSwap(m_caseSensitivity, other.m_caseSensitivity);
         qSwap(m_patternType,     other.m_patternType);
+#if QT_CONFIG(regularexpression)
+        qSwap(m_regExp,          other.m_regExp);
+#endif
     }
 
     bool matchFileName(const QString &inputFileName) const;
+    bool matchLowerCasedFileName(const QString &fileName) const;
 
     inline const QString &pattern() const { return m_pattern; }
     inline unsigned weight() const { return m_weight; }
@@ -83,6 +95,9 @@ private:
     int m_weight;
     Qt::CaseSensitivity m_caseSensitivity;
     PatternType m_patternType;
+#if QT_CONFIG(regularexpression)
+    QRegularExpression m_regExp;
+#endif
 };
 Q_DECLARE_SHARED(QMimeGlobPattern)
 
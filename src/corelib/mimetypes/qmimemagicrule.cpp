@@ -12,6 +12,8 @@
 #include <QtCore/QDebug>
 #include <qendian.h>
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 using namespace Qt::StringLiterals;
@@ -71,15 +73,20 @@ bool QMimeMagicRule::matchSubstring(const char *dataPtr, int dataSize, int range
     if (!mask) {
         // callgrind says QByteArray::indexOf is much slower, since our strings are typically too
         // short for be worth Boyer-Moore matching (1 to 71 bytes, 11 bytes on average).
-        bool found = false;
-        for (int i = rangeStart; i < rangeStart + rangeLength; ++i) {
-            if (i + valueLength > dataSize)
+        // Instead, let memchr() find the candidate positions for the first byte.
+        const qsizetype lastStart = qMin(qsizetype(rangeStart) + rangeLength, qsizetype(dataSize) - valueLength + 1);
+        const char *p = dataPtr + rangeStart;
+        const char *const end = dataPtr + lastStart;
+        bool found = valueLength == 0 && p < end;
+        while (!found && p < end) {
+            p = static_cast<const char *>(memchr(p, valueData[0], end - p));
+            if (!p)
                 break;
-
-            if (memcmp(valueData, dataPtr + i, valueLength) == 0) {
+            if (memcmp(valueData + 1, p + 1, valueLength - 1) == 0) {
                 found = true;
                 break;
             }
+            ++p;
         }
         if (!found)
             return false;
@@ -100,8 +107,10 @@ bool QMimeMagicRule::matchSubstring(const char *dataPtr, int dataSize, int range
                     break;
                 }
             }
-            if (valid)
+            if (valid) {
                 found = true;
+                break;
+            }
         }
         if (!found)
             return false;
@@ -116,6 +125,13 @@ bool QMimeMagicRule::matchString(const QByteArray &data) const
     return QMimeMagicRule::matchSubstring(data.constData(), data.size(), m_startPos, rangeLength, m_pattern.size(), m_pattern.constData(), m_mask.constData());
 }
 
+bool QMimeMagicRule::matchUnmaskedString(const QByteArray &data) const
+{
+    // same as matchString(), for the common case of a mask that is all ones
+    const int rangeLength = m_endPos - m_startPos + 1;
+    return QMimeMagicRule::matchSubstring(data.constData(), data.size(), m_startPos, rangeLength, m_pattern.size(), m_pattern.constData(), nullptr);
+}
+
 template <typename T>
 bool QMimeMagicRule::matchNumber(const QByteArray &data) const
 {
@@ -257,7 +273,10 @@ QMimeMagicRule::QMimeMagicRule(const QString &type,
             m_mask.fill(char(-1), m_pattern.size());
         }
         m_mask.squeeze();
-        m_matchFunction = &QMimeMagicRule::matchString;
+        if (std::all_of(m_mask.cbegin(), m_mask.cend(), [](char c) { return c == char(-1); }))
+            m_matchFunction = &QMimeMagicRule::matchUnmaskedString;
+        else
+            m_matchFunction = &QMimeMagicRule::matchString;
         break;
     case Byte:
         if (m_number <= quint8(-1)) {
@@ -82,6 +82,7 @@ private:
 private:
     // match functions
     bool matchString(const QByteArray &data) const;
+    bool matchUnmaskedString(const QByteArray &data) const;
     template <typename T>
     bool matchNumber(const QByteArray &data) const;
 };
@@ -19,6 +19,8 @@
 #include <QDateTime>
 #include <QtEndian>
 
+#include <algorithm>
+
 #if QT_CONFIG(mimetype_database)
 #  if defined(Q_CC_MSVC)
 #    pragma section(".qtmimedatabase", read, shared)
@@ -681,6 +683,10 @@ void QMimeXMLProvider::findByMagic(const QByteArray &data, int *accuracyPtr, QMi
     QString candidateName;
     bool foundOne = false;
     for (const QMimeMagicRuleMatcher &matcher : qAsConst(m_magicMatchers)) {
+        // the matchers are sorted by decreasing priority, so
+        // none of the remaining ones can beat what we found
+        if (int(matcher.priority()) <= *accuracyPtr)
+            break;
         if (matcher.matches(data)) {
             const int priority = matcher.priority();
             if (priority > *accuracyPtr) {
@@ -818,7 +824,14 @@ void QMimeXMLProvider::addAllMimeTypes(QList<QMimeType> &result)
 
 void QMimeXMLProvider::addMagicMatcher(const QMimeMagicRuleMatcher &matcher)
 {
-    m_magicMatchers.append(matcher);
+    // keep the list sorted by decreasing priority, in order of addition
+    // for equal ones, so that findByMagic() can stop early
+    const auto byPriority = [](unsigned priority, const QMimeMagicRuleMatcher &m) {
+        return priority > m.priority();
+    };
+    const auto it = std::upper_bound(m_magicMatchers.begin(), m_magicMatchers.end(),
+                                     matcher.priority(), byPriority);
+    m_magicMatchers.insert(it, matcher);
 }
 
 QT_END_NAMESPACE
@@ -249,6 +249,7 @@ void QFactoryLoader::update()
     }
     if (!d->extraSearchPath.isEmpty())
         d->updateSinglePath(d->extraSearchPath);
+    QLibraryPrivate::saveMetaDataCache();
 #else
     Q_D(QFactoryLoader);
     qCDebug(lcFactoryLoader) << "ignoring" << d->iid
@@ -51,6 +51,7 @@ public:
     { return parse(QByteArrayView(reinterpret_cast<const char *>(metaData.data), metaData.size)); }
 
     QJsonObject toJson() const;     // only for QLibrary & QPluginLoader
+    void setCachedData(const QCborMap &map) { data = map; }   // only for QLibrary's cache
 
     // if data is not a map, toMap() returns empty, so shall these functions
     QCborMap toCbor() const                         { return data.toMap(); }
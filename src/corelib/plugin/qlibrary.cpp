@@ -6,14 +6,19 @@
 
 #include <q20algorithm.h>
 #include <qbytearraymatcher.h>
+#include <qcborarray.h>
 #include <qdebug.h>
 #include <qendian.h>
 #include <qfile.h>
 #include <qfileinfo.h>
+#include <qhash.h>
 #include <qjsondocument.h>
 #include <qmap.h>
 #include <qmutex.h>
 #include <qoperatingsystemversion.h>
+#if QT_CONFIG(temporaryfile)
+#include <qsavefile.h>
+#endif
 #include <qstringlist.h>
 
 #ifdef Q_OS_MAC
@@ -30,6 +35,10 @@
 
 #include <qtcore_tracepoints_p.h>
 
+#ifdef Q_OS_UNIX
+#  include "qplatformdefs.h"
+#endif
+
 QT_BEGIN_NAMESPACE
 
 using namespace Qt::StringLiterals;
@@ -197,6 +206,252 @@ static QLibraryScanResult qt_find_pattern(const char *s, qsizetype s_len, QStrin
     return { i, s_len - i };
 }
 
+namespace {
+/*
+  Identifies the version of a plugin file that a cached metadata entry was
+  read from. Any change to the file (or its replacement by another one at
+  the same path) changes at least one of these.
+*/
+struct PluginFileStamp
+{
+    qint64 size = -1;
+    qint64 mtime = 0;           // nanoseconds since the epoch
+    qint64 inode = 0;
+    qint64 device = 0;
+
+    static PluginFileStamp fromFile(const QString &fileName)
+    {
+        PluginFileStamp stamp;
+#ifdef Q_OS_UNIX
+        QT_STATBUF st;
+        if (QT_STAT(QFile::encodeName(fileName).constData(), &st) == 0) {
+            stamp.size = st.st_size;
+            stamp.mtime = qint64(st.st_mtime) * 1000 * 1000 * 1000;
+#  ifdef Q_OS_LINUX
+            stamp.mtime += st.st_mtim.tv_nsec;
+#  endif
+            stamp.inode = qint64(st.st_ino);
+            stamp.device = qint64(st.st_dev);
+        }
+#else
+        QFileInfo info(fileName);
+        if (info.exists()) {
+            stamp.size = info.size();
+            stamp.mtime = info.lastModified().toMSecsSinceEpoch() * 1000 * 1000;
+        }
+#endif
+        return stamp;
+    }
+
+    bool isValid() const { return size >= 0; }
+
+    friend bool operator==(const PluginFileStamp &s1, const PluginFileStamp &s2)
+    {
+        return s1.size == s2.size && s1.mtime == s2.mtime
+                && s1.inode == s2.inode && s1.device == s2.device;
+    }
+};
+
+/*
+  The on-disk plugin metadata cache.
+
+  If the QT_PLUGIN_METADATA_CACHE environment variable names a file, the
+  metadata that findPatternUnloaded() extracts from each plugin is kept
+  there, keyed by the plugin's file name and validated against its
+  PluginFileStamp. A plugin whose entry is still fresh then costs a single
+  stat() instead of opening, mapping and scanning the binary, which adds up
+  with many plugins on a slow filesystem.
+
+  The file is read on first use and written back, if anything changed, by
+  QLibraryPrivate::saveMetaDataCache(), which QFactoryLoader calls after
+  each scan of the plugin directories. The first time it is written, the
+  entries of plugins that no longer exist are dropped.
+*/
+class PluginMetaDataCache
+{
+public:
+    PluginMetaDataCache() : fileName(qEnvironmentVariable("QT_PLUGIN_METADATA_CACHE")) {}
+
+    bool isEnabled() const { return !fileName.isEmpty(); }
+    bool lookup(const QString &library, const PluginFileStamp &stamp, QPluginParsedMetaData *metaData);
+    void insert(const QString &library, const PluginFileStamp &stamp, const QCborMap &metaData);
+    void save();
+#ifdef QT_BUILD_INTERNAL
+    void reset();
+#endif
+
+private:
+    struct Entry {
+        PluginFileStamp stamp;
+        QCborMap metaData;
+        bool used = false;      // looked up or scanned by this process
+    };
+    void ensureLoaded();
+    void prune();
+
+    QMutex mutex;
+    QString fileName;
+    QHash<QString, Entry> entries;
+    bool loaded = false;
+    bool pruned = false;
+    bool dirty = false;
+};
+} // unnamed namespace
+
+Q_GLOBAL_STATIC(PluginMetaDataCache, pluginMetaDataCache)
+
+// The cache file is a CBOR map of the Qt version that wrote it and of the
+// plugin file names to [size, mtime, inode, device, metadata] arrays.
+static constexpr QLatin1StringView CacheQtVersionKey("qt");
+static constexpr QLatin1StringView CachePluginsKey("plugins");
+
+void PluginMetaDataCache::ensureLoaded()
+{
+    if (loaded)
+        return;
+    loaded = true;
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    const QCborMap cache = QCborValue::fromCbor(file.readAll()).toMap();
+    if (cache.value(CacheQtVersionKey).toInteger() != QT_VERSION) {
+        // written by another Qt version, whose metadata format may differ
+        return;
+    }
+
+    const QCborMap plugins = cache.value(CachePluginsKey).toMap();
+    entries.reserve(plugins.size());
+    for (auto it : plugins) {
+        const QCborArray entry = it.second.toArray();
+        if (entry.size() != 5 || !entry.at(4).isMap())
+            continue;
+        PluginFileStamp stamp;
+        stamp.size = entry.at(0).toInteger();
+        stamp.mtime = entry.at(1).toInteger();
+        stamp.inode = entry.at(2).toInteger();
+        stamp.device = entry.at(3).toInteger();
+        entries.insert(it.first.toString(), { stamp, entry.at(4).toMap(), false });
+    }
+    qCDebug(qt_lcDebugPlugins, "Loaded %lld plugin metadata entries from %ls",
+            qlonglong(entries.size()), qUtf16Printable(fileName));
+}
+
+bool PluginMetaDataCache::lookup(const QString &library, const PluginFileStamp &stamp,
+                                 QPluginParsedMetaData *metaData)
+{
+    if (!stamp.isValid())
+        return false;
+
+    QMutexLocker locker(&mutex);
+    ensureLoaded();
+    auto it = entries.find(library);
+    if (it == entries.end() || !(it->stamp == stamp))
+        return false;
+    it->used = true;
+    metaData->setCachedData(it->metaData);
+    return true;
+}
+
+void PluginMetaDataCache::insert(const QString &library, const PluginFileStamp &stamp,
+                                 const QCborMap &metaData)
+{
+    if (!stamp.isValid())
+        return;
+
+    QMutexLocker locker(&mutex);
+    ensureLoaded();
+    entries.insert(library, { stamp, metaData, true });
+    dirty = true;
+}
+
+void PluginMetaDataCache::prune()
+{
+    // The plugins used by this process are known to exist; check the others
+    for (auto it = entries.begin(); it != entries.end(); ) {
+        if (!it->used && !PluginFileStamp::fromFile(it.key()).isValid()) {
+            it = entries.erase(it);
+            dirty = true;
+        } else {
+            ++it;
+        }
+    }
+}
+
+void PluginMetaDataCache::save()
+{
+    QMutexLocker locker(&mutex);
+    if (loaded && !pruned) {
+        pruned = true;
+        prune();
+    }
+    if (!dirty)
+        return;
+    dirty = false;
+
+    QCborMap plugins;
+    for (auto it = entries.cbegin(); it != entries.cend(); ++it) {
+        const PluginFileStamp &stamp = it->stamp;
+        plugins.insert(it.key(), QCborArray{ stamp.size, stamp.mtime, stamp.inode,
+                                             stamp.device, it->metaData });
+    }
+    QCborMap cache;
+    cache.insert(CacheQtVersionKey, QT_VERSION);
+    cache.insert(CachePluginsKey, plugins);
+
+#if QT_CONFIG(temporaryfile)
+    QSaveFile file(fileName);
+#else
+    QFile file(fileName);
+#endif
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(qt_lcDebugPlugins, "%ls: cannot write plugin metadata cache: %ls",
+                  qUtf16Printable(fileName), qUtf16Printable(file.errorString()));
+        return;
+    }
+    file.write(cache.toCborValue().toCbor());
+#if QT_CONFIG(temporaryfile)
+    file.commit();
+#endif
+}
+
+#ifdef QT_BUILD_INTERNAL
+// Starts over with the file that QT_PLUGIN_METADATA_CACHE names now. Only
+// autotests call this, so isEnabled() can read fileName without locking.
+void PluginMetaDataCache::reset()
+{
+    QMutexLocker locker(&mutex);
+    fileName = qEnvironmentVariable("QT_PLUGIN_METADATA_CACHE");
+    entries.clear();
+    loaded = pruned = dirty = false;
+}
+#endif
+
+/*!
+    \internal
+
+    Writes the plugin metadata cache back to disk if it is enabled and
+    plugins have been scanned since it was last written.
+*/
+void QLibraryPrivate::saveMetaDataCache()
+{
+    if (pluginMetaDataCache.exists() && pluginMetaDataCache->isEnabled())
+        pluginMetaDataCache->save();
+}
+
+#ifdef QT_BUILD_INTERNAL
+// Note: Suitable only for autotests. Writes the plugin metadata cache back
+// to disk and forgets it, so that the next plugin scan reads the file that
+// QT_PLUGIN_METADATA_CACHE then names, if any.
+void Q_AUTOTEST_EXPORT qt_resetPluginMetaDataCache()
+{
+    QLibraryPrivate::saveMetaDataCache();
+    if (PluginMetaDataCache *cache = pluginMetaDataCache())
+        cache->reset();
+}
+#endif
+
 /*
   This opens the specified library, mmaps it into memory, and searches
   for the QT_PLUGIN_VERIFICATION_DATA.  The advantage of this approach is that
@@ -209,6 +464,19 @@ static QLibraryScanResult qt_find_pattern(const char *s, qsizetype s_len, QStrin
 */
 static bool findPatternUnloaded(const QString &library, QLibraryPrivate *lib)
 {
+    PluginMetaDataCache *cache = pluginMetaDataCache();
+    if (cache && !cache->isEnabled())
+        cache = nullptr;
+    PluginFileStamp stamp;
+    if (cache) {
+        stamp = PluginFileStamp::fromFile(library);
+        if (cache->lookup(library, stamp, &lib->metaData)) {
+            qCDebug(qt_lcDebugPlugins, "Found cached metadata for lib %ls",
+                    qUtf16Printable(library));
+            return true;
+        }
+    }
+
     QFile file(library);
     if (!file.open(QIODevice::ReadOnly)) {
         if (lib)
@@ -257,6 +525,8 @@ static bool findPatternUnloaded(const QString &library, QLibraryPrivate *lib)
             qCDebug(qt_lcDebugPlugins, "Found metadata in lib %ls, metadata=\n%s\n",
                     qUtf16Printable(library),
                     QJsonDocument(lib->metaData.toJson()).toJson().constData());
+            if (cache)
+                cache->insert(library, stamp, lib->metaData.toCbor());
             return true;
         }
     } else {
@@ -69,6 +69,7 @@ public:
                                          QLibrary::LoadHints loadHints = { });
     static QStringList suffixes_sys(const QString &fullVersion);
     static QStringList prefixes_sys();
+    static void saveMetaDataCache();
 
     QAtomicPointer<std::remove_pointer<QtPluginInstanceFunction>::type> instanceFactory;
     QAtomicPointer<std::remove_pointer<Handle>::type> pHnd;
@@ -183,6 +183,7 @@ public:
     static constexpr quint64 IndefiniteLength = (std::numeric_limits<quint64>::max)();
 
     QIODevice *device;
+    const QByteArray *currentByteArray = nullptr;
     CborEncoder encoder;
     QStack<CborEncoder> containerStack;
     bool deleteDevice = false;
@@ -248,7 +249,16 @@ static CborError qt_cbor_encoder_write_callback(void *self, const void *data, si
     auto that = static_cast<QCborStreamWriterPrivate *>(self);
     if (!that->device)
         return CborNoError;
-    qint64 written = that->device->write(static_cast<const char *>(data), len);
+    qint64 written;
+    const QByteArray *ba = that->currentByteArray;
+    if (ba && data == ba->constData() && len == size_t(ba->size())) {
+        // Pass the payload of append(const QByteArray &) on as a QByteArray,
+        // so buffered devices can keep a shallow copy instead of copying it
+        // into their write buffer.
+        written = that->device->write(*ba);
+    } else {
+        written = that->device->write(static_cast<const char *>(data), len);
+    }
     return (written == qsizetype(len) ? CborNoError : CborErrorIO);
 }
 
@@ -391,13 +401,17 @@ void QCborStreamWriter::append(QCborNegativeInteger n)
 }
 
 /*!
-   \fn void QCborStreamWriter::append(const QByteArray &ba)
    \overload
 
    Appends the byte array \a ba to the stream, creating a CBOR Byte String
    value. QCborStreamWriter will attempt to write the entire string in one
    chunk.
 
+   The contents of \a ba are handed to the device with
+   QIODevice::write(const QByteArray &), so devices that buffer their output,
+   like QTcpSocket or QLocalSocket, can hold on to large payloads without
+   copying them.
+
    The following example will load and append the contents of a file to the
    stream:
 
@@ -409,6 +423,12 @@ void QCborStreamWriter::append(QCborNegativeInteger n)
    \sa appendByteString(), QCborStreamReader::isByteArray(),
        QCborStreamReader::readByteArray()
  */
+void QCborStreamWriter::append(const QByteArray &ba)
+{
+    d->currentByteArray = &ba;
+    appendByteString(ba.constData(), ba.size());
+    d->currentByteArray = nullptr;
+}
 
 /*!
    \overload
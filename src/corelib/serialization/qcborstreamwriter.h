@@ -40,7 +40,7 @@ public:
     void append(quint64 u);
     void append(qint64 i);
     void append(QCborNegativeInteger n);
-    void append(const QByteArray &ba)       { appendByteString(ba.constData(), ba.size()); }
+    void append(const QByteArray &ba);
     void append(QLatin1StringView str);
     void append(QStringView str);
     void append(QCborTag tag);
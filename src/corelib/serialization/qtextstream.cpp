@@ -376,8 +376,12 @@ bool QTextStreamPrivate::fillReadBuffer(qint64 maxBytes)
            QtDebugUtils::toPrintable(buf, bytesRead, 32).constData(), int(sizeof(buf)), int(bytesRead));
 #endif
 
+    // decode straight into the read buffer, without a temporary QString
     int oldReadBufferSize = readBuffer.size();
-    readBuffer += toUtf16(QByteArrayView(buf, bytesRead));
+    readBuffer.resize(oldReadBufferSize + toUtf16.requiredSpace(bytesRead));
+    const QChar *decodedEnd = toUtf16.appendToBuffer(readBuffer.data() + oldReadBufferSize,
+                                                     QByteArrayView(buf, bytesRead));
+    readBuffer.truncate(decodedEnd - readBuffer.constData());
 
     // remove all '\r\n' in the string.
     if (readBuffer.size() > oldReadBufferSize && textModeEnabled) {
@@ -538,6 +542,29 @@ bool QTextStreamPrivate::scan(const QChar **ptr, int *length, int maxlen, TokenD
         }
         chPtr += startOffset;
 
+        if (delimiter == EndOfLine) {
+            // Look for the line end with the (vectorized) QStringView search
+            // instead of inspecting each character in the loop below.
+            int available = endOffset - startOffset;
+            if (maxlen)
+                available = qMin(available, maxlen - totalSize);
+            const QStringView chunk(chPtr, available);
+            const qsizetype newline = chunk.indexOf(u'\n');
+            if (newline >= 0) {
+                const QChar previous = newline ? chunk.at(newline - 1) : lastChar;
+                foundToken = true;
+                delimSize = (previous == u'\r') ? 2 : 1;
+                consumeDelimiter = true;
+                available = int(newline) + 1;
+            }
+            if (available) {
+                totalSize += available;
+                startOffset += available;
+                lastChar = chunk.at(available - 1);
+            }
+            continue;
+        }
+
         for (; !foundToken && startOffset < endOffset && (!maxlen || totalSize < maxlen); ++startOffset) {
             const QChar ch = *chPtr++;
             ++totalSize;
@@ -556,12 +583,7 @@ bool QTextStreamPrivate::scan(const QChar **ptr, int *length, int maxlen, TokenD
                 }
                 break;
             case EndOfLine:
-                if (ch == u'\n') {
-                    foundToken = true;
-                    delimSize = (lastChar == u'\r') ? 2 : 1;
-                    consumeDelimiter = true;
-                }
-                lastChar = ch;
+                Q_UNREACHABLE();
                 break;
             }
         }
@@ -1606,6 +1628,10 @@ QTextStreamPrivate::NumberParsingStatus QTextStreamPrivate::getNumber(qulonglong
     scan(nullptr, nullptr, 0, NotSpace);
     consumeLastToken();
 
+    // Look up the locale's symbols once, not for every character
+    const QString negativeSign = locale.negativeSign();
+    const QString positiveSign = locale.positiveSign();
+
     // detect int encoding
     int base = params.integerBase;
     if (base == 0) {
@@ -1631,7 +1657,7 @@ QTextStreamPrivate::NumberParsingStatus QTextStreamPrivate::getNumber(qulonglong
                 base = 10;
             }
             ungetChar(ch2);
-        } else if (ch == locale.negativeSign() || ch == locale.positiveSign() || ch.isDigit()) {
+        } else if (ch == negativeSign || ch == positiveSign || ch.isDigit()) {
             base = 10;
         } else {
             ungetChar(ch);
@@ -1704,7 +1730,7 @@ QTextStreamPrivate::NumberParsingStatus QTextStreamPrivate::getNumber(qulonglong
         int ndigits = 0;
         if (!getChar(&sign))
             return npsMissingDigit;
-        if (sign != locale.negativeSign() && sign != locale.positiveSign()) {
+        if (sign != negativeSign && sign != positiveSign) {
             if (!sign.isDigit()) {
                 ungetChar(sign);
                 return npsMissingDigit;
@@ -1713,12 +1739,14 @@ QTextStreamPrivate::NumberParsingStatus QTextStreamPrivate::getNumber(qulonglong
             ndigits++;
         }
         // Parse digits
+        const QString groupSeparator =
+                locale != QLocale::c() ? locale.groupSeparator() : QString();
         QChar ch;
         while (getChar(&ch)) {
             if (ch.isDigit()) {
                 val *= 10;
                 val += ch.digitValue();
-            } else if (locale != QLocale::c() && ch == locale.groupSeparator()) {
+            } else if (!groupSeparator.isEmpty() && ch == groupSeparator) {
                 continue;
             } else {
                 ungetChar(ch);
@@ -1728,7 +1756,7 @@ QTextStreamPrivate::NumberParsingStatus QTextStreamPrivate::getNumber(qulonglong
         }
         if (ndigits == 0)
             return npsMissingDigit;
-        if (sign == locale.negativeSign()) {
+        if (sign == negativeSign) {
             qlonglong ival = qlonglong(val);
             if (ival > 0)
                 ival = -ival;
@@ -1835,6 +1863,14 @@ bool QTextStreamPrivate::getReal(double *f)
     scan(nullptr, nullptr, 0, NotSpace);
     consumeLastToken();
 
+    // Look up the locale's symbols once, not for every character
+    const QString decimalPoint = locale.decimalPoint().toLower();
+    const QString exponential = locale.exponential().toLower();
+    const QString negativeSign = locale.negativeSign().toLower();
+    const QString positiveSign = locale.positiveSign().toLower();
+    const QString groupSeparator = // backward-compatibility
+            locale != QLocale::c() ? locale.groupSeparator().toLower() : QString();
+
     const int BufferSize = 128;
     char buf[BufferSize];
     int i = 0;
@@ -1863,15 +1899,13 @@ bool QTextStreamPrivate::getReal(double *f)
             break;
         default: {
             QChar lc = c.toLower();
-            if (lc == locale.decimalPoint().toLower())
+            if (lc == decimalPoint)
                 input = InputDot;
-            else if (lc == locale.exponential().toLower())
+            else if (lc == exponential)
                 input = InputExp;
-            else if (lc == locale.negativeSign().toLower()
-                     || lc == locale.positiveSign().toLower())
+            else if (lc == negativeSign || lc == positiveSign)
                 input = InputSign;
-            else if (locale != QLocale::c() // backward-compatibility
-                     && lc == locale.groupSeparator().toLower())
+            else if (!groupSeparator.isEmpty() && lc == groupSeparator)
                 input = InputDigit; // well, it isn't a digit, but no one cares.
             else
                 input = None;
@@ -1917,8 +1951,14 @@ bool QTextStreamPrivate::getReal(double *f)
         *f = -qInf();
         return true;
     }
+    // buf only holds Latin-1, so widen it on the stack instead of
+    // allocating a QString for the conversion
+    char16_t wideBuf[BufferSize];
+    const qsizetype length = qstrlen(buf);
+    const uchar *latin1 = reinterpret_cast<const uchar *>(buf);
+    std::copy(latin1, latin1 + length, wideBuf);
     bool ok;
-    *f = locale.toDouble(QString::fromLatin1(buf), &ok);
+    *f = locale.toDouble(QStringView(wideBuf, length), &ok);
     return ok;
 }
 
@@ -14,7 +14,9 @@
 #include <qbuffer.h>
 #include <qscopeguard.h>
 #include <qcoreapplication.h>
+#include <private/qsimd_p.h>
 
+#include <algorithm>
 #include <iterator>
 #include "qxmlstream_p.h"
 #include "qxmlstreamparser_p.h"
@@ -41,6 +43,72 @@ auto reversed(Range &r)
 
 template <typename Range>
 void reversed(const Range &&) = delete;
+
+/*
+    Returns the number of characters at the start of [ptr, end) that the
+    fastScan functions can copy into the text buffer without looking at them
+    individually: everything from U+0020 to U+FFFD, except '<', '&' and the
+    two characters \a stop1 and \a stop2 (which the caller treats as
+    delimiters). Line ends, tabs and other control characters all stop the
+    run, so that line counting and normalization stay with the caller.
+*/
+qsizetype plainTextRunLength(const char16_t *ptr, const char16_t *end,
+                             char16_t stop1, char16_t stop2) noexcept
+{
+    const char16_t *begin = ptr;
+#ifdef __SSE2__
+    // There is no unsigned 16-bit comparison in SSE2, so flip the sign bit
+    // and compare signed instead.
+    const __m128i signFlip = _mm_set1_epi16(short(0x8000));
+    const __m128i lowerBound = _mm_set1_epi16(short(0x0020 ^ 0x8000));
+    const __m128i upperBound = _mm_set1_epi16(short(0xfffd ^ 0x8000));
+    const __m128i lessThan = _mm_set1_epi16('<');
+    const __m128i ampersand = _mm_set1_epi16('&');
+    const __m128i firstStop = _mm_set1_epi16(short(stop1));
+    const __m128i secondStop = _mm_set1_epi16(short(stop2));
+
+    for ( ; end - ptr >= 8; ptr += 8) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr));
+        const __m128i flipped = _mm_xor_si128(data, signFlip);
+        __m128i special = _mm_or_si128(_mm_cmplt_epi16(flipped, lowerBound),
+                                       _mm_cmpgt_epi16(flipped, upperBound));
+        special = _mm_or_si128(special, _mm_or_si128(_mm_cmpeq_epi16(data, lessThan),
+                                                     _mm_cmpeq_epi16(data, ampersand)));
+        special = _mm_or_si128(special, _mm_or_si128(_mm_cmpeq_epi16(data, firstStop),
+                                                     _mm_cmpeq_epi16(data, secondStop)));
+        if (const uint mask = _mm_movemask_epi8(special))
+            return ptr - begin + qCountTrailingZeroBits(mask) / 2;
+    }
+#endif
+    for ( ; ptr != end; ++ptr) {
+        const char16_t c = *ptr;
+        if (c < 0x20 || c > 0xfffd || c == '<' || c == '&' || c == stop1 || c == stop2)
+            break;
+    }
+    return ptr - begin;
+}
+
+/*
+    Returns the number of spaces and tabs at the start of [ptr, end).
+*/
+qsizetype blankRunLength(const char16_t *ptr, const char16_t *end) noexcept
+{
+    const char16_t *begin = ptr;
+#ifdef __SSE2__
+    const __m128i space = _mm_set1_epi16(' ');
+    const __m128i tab = _mm_set1_epi16('\t');
+    for ( ; end - ptr >= 8; ptr += 8) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr));
+        const __m128i blank = _mm_or_si128(_mm_cmpeq_epi16(data, space),
+                                           _mm_cmpeq_epi16(data, tab));
+        if (const uint mask = ~uint(_mm_movemask_epi8(blank)) & 0xffffU)
+            return ptr - begin + qCountTrailingZeroBits(mask) / 2;
+    }
+#endif
+    while (ptr != end && (*ptr == ' ' || *ptr == '\t'))
+        ++ptr;
+    return ptr - begin;
+}
 }
 
 /*!
@@ -1112,6 +1180,50 @@ bool QXmlStreamReaderPrivate::scanAttType()
     return false;
 }
 
+/*!
+  \internal
+
+  Appends the longest run of characters at the current read position that
+  needs no individual treatment to textBuffer, and returns its length. See
+  plainTextRunLength() for the exact set of characters; \a stop1 and \a
+  stop2 are the additional delimiters of the calling scanner.
+
+  Characters that were pushed back with putChar() are always handed out one
+  by one through getChar(), so this returns 0 while the put stack is not
+  empty.
+ */
+inline qsizetype QXmlStreamReaderPrivate::fastScanPlainText(char16_t stop1, char16_t stop2)
+{
+    if (putStack.size())
+        return 0;
+    const char16_t *data = reinterpret_cast<const char16_t *>(readBuffer.constData());
+    const qsizetype n = plainTextRunLength(data + readBufferPos, data + readBuffer.size(),
+                                           stop1, stop2);
+    if (n) {
+        textBuffer.append(readBuffer.constData() + readBufferPos, n);
+        readBufferPos += n;
+    }
+    return n;
+}
+
+/*!
+  \internal
+
+  Same as fastScanPlainText(), but for runs of spaces and tabs.
+ */
+inline qsizetype QXmlStreamReaderPrivate::fastScanBlanks()
+{
+    if (putStack.size())
+        return 0;
+    const char16_t *data = reinterpret_cast<const char16_t *>(readBuffer.constData());
+    const qsizetype n = blankRunLength(data + readBufferPos, data + readBuffer.size());
+    if (n) {
+        textBuffer.append(readBuffer.constData() + readBufferPos, n);
+        readBufferPos += n;
+    }
+    return n;
+}
+
 /*!
  \internal
 
@@ -1128,7 +1240,10 @@ inline qsizetype QXmlStreamReaderPrivate::fastScanLiteralContent()
 {
     qsizetype n = 0;
     uint c;
-    while ((c = getChar()) != StreamEOF) {
+    for (;;) {
+        n += fastScanPlainText(u'"', u'\'');
+        if ((c = getChar()) == StreamEOF)
+            break;
         switch (ushort(c)) {
         case 0xfffe:
         case 0xffff:
@@ -1178,7 +1293,10 @@ inline qsizetype QXmlStreamReaderPrivate::fastScanSpace()
 {
     qsizetype n = 0;
     uint c;
-    while ((c = getChar()) != StreamEOF) {
+    for (;;) {
+        n += fastScanBlanks();
+        if ((c = getChar()) == StreamEOF)
+            break;
         switch (c) {
         case '\r':
             if ((c = filterCarriageReturn()) == 0)
@@ -1211,7 +1329,17 @@ inline qsizetype QXmlStreamReaderPrivate::fastScanContentCharList()
 {
     qsizetype n = 0;
     uint c;
-    while ((c = getChar()) != StreamEOF) {
+    for (;;) {
+        if (const qsizetype run = fastScanPlainText(u']', u']')) {
+            if (isWhitespace) {
+                const QStringView text = QStringView(textBuffer).last(run);
+                isWhitespace = std::all_of(text.begin(), text.end(),
+                                           [](QChar ch) { return ch == u' '; });
+            }
+            n += run;
+        }
+        if ((c = getChar()) == StreamEOF)
+            break;
         switch (ushort(c)) {
         case 0xfffe:
         case 0xffff:
@@ -1459,6 +1587,7 @@ void QXmlStreamReaderPrivate::putReplacementInAttributeValue(QStringView s)
 uint QXmlStreamReaderPrivate::getChar_helper()
 {
     constexpr qsizetype BUFFER_SIZE = 8192;
+    constexpr qsizetype DATA_CHUNK_SIZE = 64 * 1024;
     characterOffset += readBufferPos;
     readBufferPos = 0;
     if (readBuffer.size())
@@ -1470,12 +1599,24 @@ uint QXmlStreamReaderPrivate::getChar_helper()
         qint64 nbytesreadOrMinus1 = device->read(rawReadBuffer.data() + nbytesread, BUFFER_SIZE - nbytesread);
         nbytesread += qMax(nbytesreadOrMinus1, qint64{0});
     } else {
-        if (nbytesread)
-            rawReadBuffer += dataBuffer;
-        else
-            rawReadBuffer = dataBuffer;
+        // Large documents passed in via addData() are decoded chunk by chunk,
+        // like device input, instead of being converted to UTF-16 in one go.
+        // Removing from the front of a QByteArray does not move the data.
+        if (dataBuffer.size() > DATA_CHUNK_SIZE) {
+            const QByteArrayView chunk = QByteArrayView(dataBuffer).first(DATA_CHUNK_SIZE);
+            if (nbytesread)
+                rawReadBuffer += chunk;
+            else
+                rawReadBuffer = chunk.toByteArray();
+            dataBuffer.remove(0, DATA_CHUNK_SIZE);
+        } else {
+            if (nbytesread)
+                rawReadBuffer += dataBuffer;
+            else
+                rawReadBuffer = dataBuffer;
+            dataBuffer.clear();
+        }
         nbytesread = rawReadBuffer.size();
-        dataBuffer.clear();
     }
     if (!nbytesread) {
         atEnd = true;
@@ -468,6 +468,8 @@ public:
 
     // scan optimization functions. Not strictly necessary but LALR is
     // not very well suited for scanning fast
+    qsizetype fastScanPlainText(char16_t stop1, char16_t stop2);
+    qsizetype fastScanBlanks();
     qsizetype fastScanLiteralContent();
     qsizetype fastScanSpace();
     qsizetype fastScanContentCharList();
@@ -76,9 +76,14 @@ void BitOStream::write(QByteArrayView src, bool compressed)
     }
 
     write(byteLen);
+    // We're on the byte boundary now, integers end there.
+    Q_ASSERT(!(bitsSet % 8));
 
     if (compressed) {
-        huffman_encode_string(src, *this);
+        const auto oldSize = buffer.size();
+        buffer.resize(oldSize + byteLen);
+        huffman_encode_string(src, buffer.data() + oldSize);
+        bitsSet += quint64(byteLen) * 8;
     } else {
         bitsSet += quint64(src.size()) * 8;
         buffer.insert(buffer.end(), src.begin(), src.end());
@@ -269,8 +274,9 @@ bool BitIStream::read(QByteArray *dstPtr)
                 return true;
             }
 
-            BitIStream slice(first + offset / 8, first + offset / 8 + len);
-            if (huffman_decode_string(slice, &dst)) {
+            dst.clear();
+            const QByteArrayView encoded(first + offset / 8, len);
+            if (huffman_decode_string(encoded, &dst)) {
                 offset += quint64(len) * 8;
                 return true;
             }
@@ -97,10 +97,10 @@ bool FieldLookupTable::SearchEntry::operator < (const SearchEntry &rhs)const
 
     // Later added - smaller is chunk index (since we push_front).
     if (leftChunkIndex != rightChunkIndex)
-        return leftChunkIndex > rightChunkIndex;
+        return leftChunkIndex < rightChunkIndex;
 
     // Later added - smaller is offset.
-    return offset > rhs.offset;
+    return offset < rhs.offset;
 }
 
 FieldLookupTable::FieldLookupTable(quint32 maxSize, bool use)
@@ -149,8 +149,11 @@ bool FieldLookupTable::prependField(const QByteArray &name, const QByteArray &va
         const auto result = searchIndex.insert(frontKey());
         Q_UNUSED(result);
         Q_ASSERT(result.second);
+        fieldIndex.insert({name, value}, nInserted);
     }
 
+    ++nInserted;
+
     return true;
 }
 
@@ -168,6 +171,14 @@ void FieldLookupTable::evictEntry()
     }
 
     const HeaderField &field = back();
+    if (useIndex) {
+        // Keep the entry if it's a newer copy of the field that we evict:
+        const auto it = fieldIndex.find({field.name, field.value});
+        Q_ASSERT(it != fieldIndex.end());
+        if (*it == nInserted - nDynamic)
+            fieldIndex.erase(it);
+    }
+
     const auto entrySize = entry_size(field);
     Q_ASSERT(entrySize.first);
     Q_ASSERT(dataSize >= entrySize.second);
@@ -208,6 +219,7 @@ quint32 FieldLookupTable::dynamicDataSize() const
 void FieldLookupTable::clearDynamicTable()
 {
     searchIndex.clear();
+    fieldIndex.clear();
     chunks.clear();
     begin = 0;
     end = 0;
@@ -237,13 +249,10 @@ quint32 FieldLookupTable::indexOf(const QByteArray &name, const QByteArray &valu
         return 0;
     }
 
-    const SearchEntry key(&field, nullptr, 0, this);
-    const auto pos = searchIndex.lower_bound(key);
-    if (pos != searchIndex.end()) {
-        const HeaderField &found = *pos->field;
-        if (found.name == name && found.value == value)
-            return keyToIndex(*pos);
-    }
+    // The newest entry (inserted as nInserted - 1) has index staticSize + 1:
+    const auto pos = fieldIndex.constFind({name, value});
+    if (pos != fieldIndex.constEnd())
+        return quint32(table.size() + nInserted - *pos);
 
     return 0;
 }
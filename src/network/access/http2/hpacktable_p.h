@@ -16,6 +16,7 @@
 //
 
 #include <QtCore/qbytearray.h>
+#include <QtCore/qhash.h>
 #include <QtCore/private/qglobal_p.h>
 #include <QtCore/qpair.h>
 
@@ -173,6 +174,12 @@ private:
 
     bool useIndex;
     std::set<SearchEntry> searchIndex;
+    // Exact name|value matches are what the encoder looks for most of the
+    // time; instead of walking the searchIndex, they are found by hash.
+    // Maps a field to the insertion number of its newest copy, from which
+    // the field's current index follows.
+    QHash<std::pair<QByteArray, QByteArray>, quint64> fieldIndex;
+    quint64 nInserted = 0;
 
     SearchEntry frontKey() const;
     SearchEntry backKey() const;
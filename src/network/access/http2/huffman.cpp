@@ -24,32 +24,10 @@ namespace HPack
     code length. All codes were left-aligned - for implementation
     convenience.
 
-    Using binary trees to implement decoding would be prohibitively
-    expensive (both memory and time-wise). Instead we use a table-based
-    approach and any given code itself works as an index into such table(s).
-    We have 256 possible byte values and code lengths in
-    a range [5, 26]. This would require a huge table (and most of entries
-    would be 'wasted', since we only have to encode 256 elements).
-    Instead we use multi-level tables. The first level table
-    is using 9-bit length index; some entries in this table are 'terminal',
-    some reference the next level table(s).
-
-    For example, bytes with values 48 and 49 (ASCII codes for '0' and '1')
-    both have code length 5, Huffman codes are: 00000 and 00001. They
-    both are placed in the 'root' table,
-    the 'root' table has index length == 9:
-    [00000 | 4 remaining bits]
-     ...
-    [00001 | 4 remaining bits]
-
-    All entries with indices between these two will 'point' to value 48
-    with bitLength == 5 so that bit stream (for example) 000001010 will be
-    decoded as: 48 + "put 1010 back into bitstream".
-
-    A good description can be found here:
-    http://commandlinefanatic.com/cgi-bin/showarticle.cgi?article=art007
-    or just google "Efficient Huffman Decoding".
-    Also see comments below about 'filling holes'.
+    Walking a binary tree bit by bit to decode would be prohibitively
+    slow. Instead, the decoder is a finite-state machine built from that
+    tree, consuming 4 bits per step (see HuffmanDecoder). Every step is
+    one lookup in a table of 256 * 16 transitions.
 */
 
 namespace
@@ -316,30 +294,6 @@ const CodeEntry staticHuffmanCodeTable[]
     {256, 0xfffffffcul, 30}   // EOS 11111111|11111111|11111111|111111
 };
 
-void write_huffman_code(BitOStream &outputStream, const CodeEntry &code)
-{
-    // Append octet by octet.
-    auto bitLength = code.bitLength;
-    const auto hc = code.huffmanCode >> (32 - bitLength);
-
-    if (bitLength > 24) {
-        outputStream.writeBits(uchar(hc >> 24), bitLength - 24);
-        bitLength = 24;
-    }
-
-    if (bitLength > 16) {
-        outputStream.writeBits(uchar(hc >> 16), bitLength - 16);
-        bitLength = 16;
-    }
-
-    if (bitLength > 8) {
-        outputStream.writeBits(uchar(hc >> 8), bitLength - 8);
-        bitLength = 8;
-    }
-
-    outputStream.writeBits(uchar(hc), bitLength);
-}
-
 }
 
 // That's from HPACK's specs - we deal with octets.
@@ -348,191 +302,136 @@ static_assert(std::numeric_limits<uchar>::digits == 8, "octets expected");
 quint64 huffman_encoded_bit_length(QByteArrayView inputData)
 {
     quint64 bitLength = 0;
-    for (int i = 0, e = inputData.size(); i < e; ++i)
-        bitLength += staticHuffmanCodeTable[int(inputData[i])].bitLength;
+    for (const char c : inputData)
+        bitLength += staticHuffmanCodeTable[uchar(c)].bitLength;
 
     return bitLength;
 }
 
-void huffman_encode_string(QByteArrayView inputData, BitOStream &outputStream)
+void huffman_encode_string(QByteArrayView inputData, uchar *output)
 {
-    for (int i = 0, e = inputData.size(); i < e; ++i) {
-        const auto value = uchar(inputData[i]);
-        write_huffman_code(outputStream, staticHuffmanCodeTable[value]);
+    // Codes are collected in 'bits' and written out octet by octet. There
+    // are less than 8 bits left in it before we add a code, and codes are
+    // at most 30 bits long, so it never overflows.
+    quint64 bits = 0;
+    quint32 nBits = 0;
+    for (const char c : inputData) {
+        const CodeEntry &code = staticHuffmanCodeTable[uchar(c)];
+        bits = bits << code.bitLength | code.huffmanCode >> (32 - code.bitLength);
+        nBits += code.bitLength;
+        while (nBits >= 8) {
+            nBits -= 8;
+            *output++ = uchar(bits >> nBits);
+        }
     }
 
-    // Pad bits ...
-    if (outputStream.bitLength() % 8)
-        outputStream.writeBits(0xff, 8 - outputStream.bitLength() % 8);
-}
-
-static constexpr
-bool padding_is_valid(quint32 chunk, quint32 nBits)
-{
-    Q_ASSERT(nBits);
-
-    // HPACK, 5.2: "A padding strictly longer than 7 bits MUST be
-    // treated as a decoding error."
-    if (nBits > 7)
-        return false;
-    // HPACK, 5.2:
-    // "A padding not corresponding to the most significant bits
-    // of the code for the EOS symbol MUST be treated as a decoding error."
-    return (chunk >> (32 - nBits)) == quint32((1 << nBits) - 1);
+    // Pad bits with the most significant bits of EOS (all ones) ...
+    if (nBits)
+        *output = uchar(bits << (8 - nBits) | 0xff >> nBits);
 }
 
 HuffmanDecoder::HuffmanDecoder()
-    : minCodeLength()
 {
-    const auto nCodes = sizeof staticHuffmanCodeTable / sizeof staticHuffmanCodeTable[0];
-
-    std::vector<CodeEntry> symbols(staticHuffmanCodeTable, staticHuffmanCodeTable + nCodes);
-    // Now we sort: by bit length first (in the descending order) and by the symbol
-    // value (descending). Descending order: to make sure we do not create prefix tables with
-    // short 'indexLength' first and having longer codes that do not fit into such tables later.
-    std::sort(symbols.begin(), symbols.end(), [](const CodeEntry &code1, const CodeEntry &code2) {
-        if (code1.bitLength == code2.bitLength)
-            return code1.byteValue > code2.byteValue;
-        return code1.bitLength > code2.bitLength;
-    });
-
-    minCodeLength = symbols.back().bitLength; // The shortest one, currently it's 5.
-
-    // TODO: add a verification - Huffman codes
-    // within a given bit length range also
-    // should be in descending order.
-
-    // Initialize 'prefixTables' and 'tableData'.
-    addTable(0, quint32(BitConstants::rootPrefix)); // 'root' table.
-
-    for (const auto &s : symbols) {
-        quint32 tableIndex = 0;
-        while (true) {
-            Q_ASSERT(tableIndex < prefixTables.size());
-            // Note, by value - since prefixTables will be updated in between.
-            const auto table = prefixTables[tableIndex];
-            // We skip prefixed bits (if any) and use indexed bits only:
-            const auto entryIndex = s.huffmanCode << table.prefixLength >> (32 - table.indexLength);
-            // Again, by value.
-            PrefixTableEntry entry = tableEntry(table, entryIndex);
-            // How many bits were coded by previous tables and this table:
-            const auto codedLength = table.prefixLength + table.indexLength;
-            if (codedLength < s.bitLength) {
-                // We have to add a new prefix table ... (if it's not done yet).
-                if (!entry.bitLength) {
-                    entry.nextTable = addTable(codedLength, std::min<quint32>(quint32(BitConstants::childPrefix),
-                                                                              s.bitLength - codedLength));
-                    entry.bitLength = s.bitLength;
-                    entry.byteValue = s.byteValue;
-                    setTableEntry(table, entryIndex, entry);
-                }
-                tableIndex = entry.nextTable;
+    // Build the code tree first. Inner nodes are numbered in the order we
+    // create them, the root being 0; for leaves we store -1 - symbol.
+    struct Node
+    {
+        int children[2] = {};
+        quint32 depth = 0;
+        bool allOnes = true; // The path from the root is all 1 bits
+    };
+    std::vector<Node> nodes(1);
+    nodes.reserve(nStates);
+
+    for (const CodeEntry &code : staticHuffmanCodeTable) {
+        int node = 0;
+        for (quint32 i = 0; i < code.bitLength; ++i) {
+            const int bit = (code.huffmanCode >> (31 - i)) & 1;
+            if (i + 1 == code.bitLength) {
+                Q_ASSERT(!nodes[node].children[bit]);
+                nodes[node].children[bit] = -1 - int(code.byteValue);
             } else {
-                // We found the slot for our code (terminal entry):
-                entry.byteValue = s.byteValue;
-                entry.bitLength = s.bitLength;
-                // Refer to our own table as 'nextTable':
-                entry.nextTable = tableIndex;
-                setTableEntry(table, entryIndex, entry);
-                break;
+                if (!nodes[node].children[bit]) {
+                    Node child;
+                    child.depth = nodes[node].depth + 1;
+                    child.allOnes = nodes[node].allOnes && bit;
+                    nodes[node].children[bit] = int(nodes.size());
+                    nodes.push_back(child);
+                }
+                node = nodes[node].children[bit];
+                Q_ASSERT(node > 0);
             }
         }
     }
 
-    // Now, we have a table(s) and have to fill 'holes' to
-    // 'fix' terminal entries.
-    for (const auto &table : prefixTables) {
-        const quint32 codedLength = table.prefixLength + table.indexLength;
-        for (quint32 j = 0; j < table.size();) {
-            const PrefixTableEntry &entry = tableEntry(table, j);
-            if (entry.bitLength && entry.bitLength < codedLength) {
-                const quint32 range = 1 << (codedLength - entry.bitLength);
-                for (quint32 k = 1; k < range; ++k)
-                    setTableEntry(table, j + k, entry);
-                j += range;
-            } else {
-                ++j;
+    // A full binary tree with 257 leaves:
+    Q_ASSERT(nodes.size() == nStates);
+
+    for (int state = 0; state < nStates; ++state) {
+        // HPACK, 5.2: "A padding strictly longer than 7 bits MUST be treated
+        // as a decoding error. A padding not corresponding to the most
+        // significant bits of the code for the EOS symbol MUST be treated
+        // as a decoding error."
+        acceptingState[state] = nodes[state].allOnes && nodes[state].depth <= 7;
+
+        for (int nibble = 0; nibble < 16; ++nibble) {
+            Transition &transition = transitions[state][nibble];
+            transition = {};
+            int node = state;
+            for (int i = 3; i >= 0; --i) {
+                const int child = nodes[node].children[(nibble >> i) & 1];
+                if (child > 0) {
+                    node = child;
+                    continue;
+                }
+                const int symbol = -1 - child;
+                if (symbol == 256) { // EOS == compression error (HPACK)
+                    transition.flags = Failure;
+                    break;
+                }
+                transition.flags = Symbol;
+                transition.symbol = quint8(symbol);
+                node = 0;
             }
+            transition.nextState = quint8(node);
         }
     }
 }
 
-bool HuffmanDecoder::decodeStream(BitIStream &inputStream, QByteArray &outputBuffer)
+bool HuffmanDecoder::decodeStream(QByteArrayView inputData, QByteArray &outputBuffer) const
 {
-    while (true) {
-        quint32 chunk = 0;
-        const quint32 readBits = inputStream.peekBits(inputStream.streamOffset(), 32, &chunk);
-        if (!readBits)
-            return !inputStream.hasMoreBits();
-
-        if (readBits < minCodeLength) {
-            inputStream.skipBits(readBits);
-            return padding_is_valid(chunk, readBits);
-        }
-
-        quint32 tableIndex = 0;
-        const PrefixTable *table = &prefixTables[tableIndex];
-        quint32 entryIndex = chunk >> (32 - table->indexLength);
-        PrefixTableEntry entry = tableEntry(*table, entryIndex);
-
-        while (true) {
-            if (entry.nextTable == tableIndex)
-                break;
-
-            tableIndex = entry.nextTable;
-            table = &prefixTables[tableIndex];
-            entryIndex = chunk << table->prefixLength >> (32 - table->indexLength);
-            entry = tableEntry(*table, entryIndex);
-        }
-
-        if (entry.bitLength > readBits) {
-            inputStream.skipBits(readBits);
-            return padding_is_valid(chunk, readBits);
-        }
-
-        if (!entry.bitLength || entry.byteValue == 256) {
-            //EOS (256) == compression error (HPACK).
-            inputStream.skipBits(readBits);
+    // At most one symbol per 5 bits:
+    const qsizetype oldSize = outputBuffer.size();
+    outputBuffer.resize(oldSize + inputData.size() * 8 / 5);
+    char *const begin = outputBuffer.data() + oldSize;
+    char *dst = begin;
+
+    quint8 state = 0;
+    const auto step = [&](uchar nibble) {
+        const Transition &transition = transitions[state][nibble];
+        if (transition.flags & Symbol)
+            *dst++ = char(transition.symbol);
+        state = transition.nextState;
+        return !(transition.flags & Failure);
+    };
+
+    for (const char c : inputData) {
+        if (!step(uchar(c) >> 4) || !step(uchar(c) & 0xf)) {
+            outputBuffer.resize(oldSize);
             return false;
         }
-
-        outputBuffer.append(entry.byteValue);
-        inputStream.skipBits(entry.bitLength);
     }
 
-    return false;
-}
-
-quint32 HuffmanDecoder::addTable(quint32 prefix, quint32 index)
-{
-    PrefixTable newTable{prefix, index};
-    newTable.offset = quint32(tableData.size());
-    prefixTables.push_back(newTable);
-    // Add entries for this table:
-    tableData.resize(tableData.size() + newTable.size());
-
-    return quint32(prefixTables.size() - 1);
-}
-
-PrefixTableEntry HuffmanDecoder::tableEntry(const PrefixTable &table, quint32 index)
-{
-    Q_ASSERT(index < table.size());
-    return tableData[table.offset + index];
-}
-
-void HuffmanDecoder::setTableEntry(const PrefixTable &table, quint32 index,
-                                   const PrefixTableEntry &entry)
-{
-    Q_ASSERT(index < table.size());
-    tableData[table.offset + index] = entry;
+    outputBuffer.resize(oldSize + (dst - begin));
+    return acceptingState[state];
 }
 
-bool huffman_decode_string(BitIStream &inputStream, QByteArray *outputBuffer)
+bool huffman_decode_string(QByteArrayView inputData, QByteArray *outputBuffer)
 {
     Q_ASSERT(outputBuffer);
 
-    static HuffmanDecoder decoder;
-    return decoder.decodeStream(inputStream, *outputBuffer);
+    static const HuffmanDecoder decoder;
+    return decoder.decodeStream(inputData, *outputBuffer);
 }
 
 }
@@ -31,99 +31,46 @@ struct CodeEntry
     quint32 bitLength;
 };
 
-class BitOStream;
-
 quint64 huffman_encoded_bit_length(QByteArrayView inputData);
-void huffman_encode_string(QByteArrayView inputData, BitOStream &outputStream);
-
-// PrefixTable:
-// Huffman codes with a small bit length
-// fit into a table (these are 'terminal' symbols),
-// codes with longer codes require additional
-// tables, so several symbols will have the same index
-// in a table - pointing into the next table.
-// Every table has an 'indexLength' - that's
-// how many bits can fit in table's indices +
-// 'prefixLength' - how many bits were addressed
-// by its 'parent' table(s).
-// All PrefixTables are kept in 'prefixTables' array.
-// PrefixTable itself does not have any entries,
-// it just holds table's prefix/index + 'offset' -
-// there table's data starts in an array of all
-// possible entries ('tableData').
-
-struct PrefixTable
-{
-    PrefixTable()
-        : prefixLength(),
-          indexLength(),
-          offset()
-    {
-    }
+// Writes (huffman_encoded_bit_length(inputData) + 7) / 8 octets to 'output':
+void huffman_encode_string(QByteArrayView inputData, uchar *output);
 
-    PrefixTable(quint32 prefix, quint32 index)
-        : prefixLength(prefix),
-          indexLength(index),
-          offset()
-    {
-    }
-
-    quint32 size()const
-    {
-        // Number of entries table contains:
-        return 1 << indexLength;
-    }
-
-    quint32 prefixLength;
-    quint32 indexLength;
-    quint32 offset;
-};
-
-// Table entry is either a terminal entry (thus probably the code found)
-// or points into another table ('nextTable' - index into
-// 'prefixTables' array). If it's a terminal, 'nextTable' index
-// refers to the same table.
-
-struct PrefixTableEntry
-{
-    PrefixTableEntry()
-        : bitLength(),
-          nextTable(),
-          byteValue()
-    {
-    }
-
-    quint32 bitLength;
-    quint32 nextTable;
-    quint32 byteValue;
-};
-
-class BitIStream;
+// HuffmanDecoder is a finite-state machine consuming its input 4 bits
+// at a time. Its states are the inner nodes of the Huffman code tree
+// (with the root being state 0), there are 256 of them for the 257
+// symbols (including EOS). Since the shortest code is 5 bits long, each
+// transition decodes at most one symbol. The transition table takes
+// 256 * 16 * 3 octets, so it stays in the CPU cache while we decode.
 
 class HuffmanDecoder
 {
 public:
-    enum class BitConstants
-    {
-        rootPrefix = 9,
-        childPrefix = 6
-    };
-
     HuffmanDecoder();
 
-    bool decodeStream(BitIStream &inputStream, QByteArray &outputBuffer);
+    bool decodeStream(QByteArrayView inputData, QByteArray &outputBuffer) const;
 
 private:
-    quint32 addTable(quint32 prefixLength, quint32 indexLength);
-    PrefixTableEntry tableEntry(const PrefixTable &table, quint32 index);
-    void setTableEntry(const PrefixTable &table, quint32 index, const PrefixTableEntry &entry);
+    enum TransitionFlag : quint8
+    {
+        Symbol = 0x1,   // The transition decodes a symbol
+        Failure = 0x2   // The transition decodes EOS (a compression error)
+    };
+
+    struct Transition
+    {
+        quint8 nextState;
+        quint8 flags;
+        quint8 symbol;
+    };
 
-    std::vector<PrefixTable> prefixTables;
-    std::vector<PrefixTableEntry> tableData;
-    quint32 minCodeLength;
+    static constexpr int nStates = 256;
+    Transition transitions[nStates][16];
+    // If the input may end in this state: the bits consumed since the last
+    // symbol decoded are a valid padding (HPACK, 5.2).
+    bool acceptingState[nStates];
 };
 
-bool huffman_decode_string(BitIStream &inputStream, QByteArray *outputBuffer);
+bool huffman_decode_string(QByteArrayView inputData, QByteArray *outputBuffer);
 
 } // namespace HPack
 
@@ -0,0 +1,200 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qhttp1configuration.h"
+
+#include "qdebug.h"
+
+QT_BEGIN_NAMESPACE
+
+// The channel count of a QHttpNetworkConnection is a quint16, but opening
+// more than a few hundred connections to a single host is abuse, not tuning.
+static constexpr qsizetype MaxConnectionsPerHost = 255;
+static constexpr qsizetype DefaultConnectionsPerHost = 6;
+
+/*!
+    \class QHttp1Configuration
+    \brief The QHttp1Configuration class controls HTTP/1 parameters and settings.
+    \since 6.5
+
+    \reentrant
+    \inmodule QtNetwork
+    \ingroup network
+    \ingroup shared
+
+    QHttp1Configuration controls HTTP/1 parameters and settings that
+    QNetworkAccessManager will use to send requests and process responses.
+
+    The HTTP/1 parameters that QHttp1Configuration currently supports include:
+
+    \list
+      \li The number of connections QNetworkAccessManager opens in parallel
+         to a single host. Requests beyond that are queued until one of
+         the connections becomes free.
+      \li The maximum number of such connections. If it is larger than the
+         number of connections, the connection pool of a host grows while
+         requests wait in its queue, and shrinks back once the queue stays
+         empty.
+    \endlist
+
+    \note The configuration must be set before the first request
+    was sent to a given host (and thus the pool of connections to it created).
+
+    \sa QNetworkRequest::setHttp1Configuration(), QNetworkRequest::http1Configuration(),
+        QNetworkAccessManager::httpConnectionPoolStatistics(), QHttp2Configuration
+*/
+
+class QHttp1ConfigurationPrivate : public QSharedData
+{
+public:
+    qsizetype numberOfConnectionsPerHost = DefaultConnectionsPerHost;
+    // 0 means 'same as numberOfConnectionsPerHost', that is no adaptive growth.
+    qsizetype maximumNumberOfConnectionsPerHost = 0;
+};
+
+/*!
+    Default constructs a QHttp1Configuration object.
+
+    Such a configuration opens up to six connections per host and
+    does not grow beyond that.
+*/
+QHttp1Configuration::QHttp1Configuration()
+    : d(new QHttp1ConfigurationPrivate)
+{
+}
+
+/*!
+    Copy-constructs this QHttp1Configuration.
+*/
+QHttp1Configuration::QHttp1Configuration(const QHttp1Configuration &) = default;
+
+/*!
+    Move-constructs this QHttp1Configuration from \a other
+*/
+QHttp1Configuration::QHttp1Configuration(QHttp1Configuration &&other) noexcept
+{
+    swap(other);
+}
+
+/*!
+    Copy-assigns \a other to this QHttp1Configuration.
+*/
+QHttp1Configuration &QHttp1Configuration::operator=(const QHttp1Configuration &) = default;
+
+/*!
+    Move-assigns \a other to this QHttp1Configuration.
+*/
+QHttp1Configuration &QHttp1Configuration::operator=(QHttp1Configuration &&) noexcept = default;
+
+/*!
+    Destructor.
+*/
+QHttp1Configuration::~QHttp1Configuration()
+{
+}
+
+/*!
+    Sets the number of connections QNetworkAccessManager opens in parallel
+    to a single host to \a amount. \a amount must be between 1 and 255.
+
+    Returns \c true on success, \c false otherwise.
+
+    \sa numberOfConnectionsPerHost, setMaximumNumberOfConnectionsPerHost
+*/
+bool QHttp1Configuration::setNumberOfConnectionsPerHost(qsizetype amount)
+{
+    if (amount < 1 || amount > MaxConnectionsPerHost) {
+        qWarning("QHttp1Configuration: invalid number of connections per host %lld",
+                 qlonglong(amount));
+        return false;
+    }
+
+    d->numberOfConnectionsPerHost = amount;
+    return true;
+}
+
+/*!
+    Returns the number of connections QNetworkAccessManager opens in
+    parallel to a single host. The default is 6.
+
+    \sa setNumberOfConnectionsPerHost
+*/
+qsizetype QHttp1Configuration::numberOfConnectionsPerHost() const
+{
+    return d->numberOfConnectionsPerHost;
+}
+
+/*!
+    Sets the number of connections the pool of a single host may grow to
+    to \a amount. \a amount must be between 1 and 255.
+
+    Whenever all connections to a host are busy and the oldest queued
+    request has been waiting for a while, QNetworkAccessManager opens one
+    more connection, up to \a amount. Connections above
+    numberOfConnectionsPerHost() are closed again after the queue of the
+    host has stayed empty for a few seconds.
+
+    If \a amount is not larger than numberOfConnectionsPerHost(), the
+    pool does not grow.
+
+    Returns \c true on success, \c false otherwise.
+
+    \sa maximumNumberOfConnectionsPerHost, QNetworkAccessManager::httpConnectionPoolStatistics()
+*/
+bool QHttp1Configuration::setMaximumNumberOfConnectionsPerHost(qsizetype amount)
+{
+    if (amount < 1 || amount > MaxConnectionsPerHost) {
+        qWarning("QHttp1Configuration: invalid maximum number of connections per host %lld",
+                 qlonglong(amount));
+        return false;
+    }
+
+    d->maximumNumberOfConnectionsPerHost = amount;
+    return true;
+}
+
+/*!
+    Returns the number of connections the pool of a single host may grow
+    to. This is never less than numberOfConnectionsPerHost(), which it
+    equals by default.
+
+    \sa setMaximumNumberOfConnectionsPerHost
+*/
+qsizetype QHttp1Configuration::maximumNumberOfConnectionsPerHost() const
+{
+    return qMax(d->maximumNumberOfConnectionsPerHost, d->numberOfConnectionsPerHost);
+}
+
+/*!
+    Swaps this configuration with the \a other configuration.
+*/
+void QHttp1Configuration::swap(QHttp1Configuration &other) noexcept
+{
+    d.swap(other.d);
+}
+
+/*!
+    \fn bool QHttp1Configuration::operator==(const QHttp1Configuration &lhs, const QHttp1Configuration &rhs) noexcept
+    Returns \c true if \a lhs and \a rhs have the same set of HTTP/1
+    parameters.
+*/
+
+/*!
+    \fn bool QHttp1Configuration::operator!=(const QHttp1Configuration &lhs, const QHttp1Configuration &rhs) noexcept
+    Returns \c true if \a lhs and \a rhs do not have the same set of HTTP/1
+    parameters.
+*/
+
+/*!
+    \internal
+*/
+bool QHttp1Configuration::isEqual(const QHttp1Configuration &other) const noexcept
+{
+    if (d == other.d)
+        return true;
+
+    return numberOfConnectionsPerHost() == other.numberOfConnectionsPerHost()
+           && maximumNumberOfConnectionsPerHost() == other.maximumNumberOfConnectionsPerHost();
+}
+
+QT_END_NAMESPACE
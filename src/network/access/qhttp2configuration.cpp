@@ -41,6 +41,8 @@ QT_BEGIN_NAMESPACE
       \li The server push. Allows to enable or disable server push. Sent
          as 'SETTINGS_ENABLE_PUSH' parameter in the initial 'SETTINGS'
          frame.
+      \li The receive window auto-tuning. Lets the window sizes above
+         grow with the measured bandwidth-delay product of the connection.
     \endlist
 
     The QHttp2Configuration class also controls if the header compression
@@ -69,6 +71,7 @@ public:
     bool pushEnabled = false;
     // TODO: for now those two below are noop.
     bool huffmanCompressionEnabled = true;
+    bool windowAutoTuningEnabled = true;
 };
 
 /*!
@@ -78,6 +81,7 @@ public:
     \list
         \li Server push is disabled
         \li Huffman string compression is enabled
+        \li Receive window auto-tuning is enabled
         \li Window size for connection-level flow control is 65535 octets
         \li Window size for stream-level flow control is 65535 octets
         \li Frame size is 16384 octets
@@ -166,6 +170,45 @@ bool QHttp2Configuration::huffmanCompressionEnabled() const
     return d->huffmanCompressionEnabled;
 }
 
+/*!
+    \since 6.5
+
+    If \a enable is \c true, the receive window sizes grow beyond
+    sessionReceiveWindowSize() and streamReceiveWindowSize() when a download
+    is limited by them rather than by the network. Enabled by default.
+
+    QNetworkAccessManager estimates the bandwidth-delay product of the
+    connection by timing 'PING' frames against the amount of data received
+    in the meantime, and sends 'WINDOW_UPDATE' frames to keep the windows at
+    twice that estimate. The configured sizes are the sizes to start with:
+    they are never shrunk. Only streams sent with the most urgent
+    QNetworkRequest::Priority among those currently receiving data get
+    the larger stream window, lower priority streams stay at the
+    configured size while they compete with more urgent ones.
+
+    Disable auto-tuning to bound the memory a single download can take to
+    the configured window sizes.
+
+    \sa receiveWindowAutoTuningEnabled, setStreamReceiveWindowSize
+*/
+void QHttp2Configuration::setReceiveWindowAutoTuningEnabled(bool enable)
+{
+    d->windowAutoTuningEnabled = enable;
+}
+
+/*!
+    \since 6.5
+
+    Returns \c true if the receive window sizes are tuned to the
+    bandwidth-delay product of the connection.
+
+    \sa setReceiveWindowAutoTuningEnabled
+*/
+bool QHttp2Configuration::receiveWindowAutoTuningEnabled() const
+{
+    return d->windowAutoTuningEnabled;
+}
+
 /*!
     Sets the window size for connection-level flow control.
     \a size cannot be 0 and must not exceed 2147483647 octets.
@@ -283,6 +326,7 @@ bool QHttp2Configuration::isEqual(const QHttp2Configuration &other) const noexce
 
     return d->pushEnabled == other.d->pushEnabled
            && d->huffmanCompressionEnabled == other.d->huffmanCompressionEnabled
+           && d->windowAutoTuningEnabled == other.d->windowAutoTuningEnabled
            && d->sessionWindowSize == other.d->sessionWindowSize
            && d->streamWindowSize == other.d->streamWindowSize;
 }
@@ -32,6 +32,9 @@ public:
     void setHuffmanCompressionEnabled(bool enable);
     bool huffmanCompressionEnabled() const;
 
+    void setReceiveWindowAutoTuningEnabled(bool enable);
+    bool receiveWindowAutoTuningEnabled() const;
+
     bool setSessionReceiveWindowSize(unsigned size);
     unsigned sessionReceiveWindowSize() const;
 
@@ -147,6 +147,12 @@ QHttp2ProtocolHandler::QHttp2ProtocolHandler(QHttpNetworkConnectionChannel *chan
     maxSessionReceiveWindowSize = h2Config.sessionReceiveWindowSize();
     pushPromiseEnabled = h2Config.serverPushEnabled();
     streamInitialReceiveWindowSize = h2Config.streamReceiveWindowSize();
+    streamReceiveWindowSize = streamInitialReceiveWindowSize;
+    windowAutoTuning = h2Config.receiveWindowAutoTuningEnabled();
+    maxAutoTunedSessionWindowSize = std::max(maxSessionReceiveWindowSize,
+                                             qtDefaultStreamReceiveWindowSize);
+    maxAutoTunedStreamWindowSize = std::max(streamInitialReceiveWindowSize,
+                                            qtDefaultStreamReceiveWindowSize);
     encoder.setCompressStrings(h2Config.huffmanCompressionEnabled());
 
     if (!channel->ssl && m_connection->connectionType() != QHttpNetworkConnection::ConnectionTypeHTTP2Direct) {
@@ -541,6 +547,41 @@ bool QHttp2ProtocolHandler::sendWINDOW_UPDATE(quint32 streamID, quint32 delta)
     return frameWriter.write(*m_socket);
 }
 
+void QHttp2ProtocolHandler::sendPendingWINDOW_UPDATEs()
+{
+    windowUpdatesScheduled = false;
+
+    if (sessionReceiveWindowSize < maxSessionReceiveWindowSize / 2) {
+        sendWINDOW_UPDATE(connectionStreamID, maxSessionReceiveWindowSize - sessionReceiveWindowSize);
+        sessionReceiveWindowSize = maxSessionReceiveWindowSize;
+    }
+
+    for (Stream &stream : activeStreams) {
+        if (stream.state != Stream::open && stream.state != Stream::halfClosedLocal)
+            continue;
+        const qint32 windowSize = streamReceiveWindowTarget(stream);
+        if (stream.recvWindow < windowSize / 2) {
+            sendWINDOW_UPDATE(stream.streamID, windowSize - stream.recvWindow);
+            stream.recvWindow = windowSize;
+        }
+    }
+}
+
+bool QHttp2ProtocolHandler::sendBdpPING()
+{
+    Q_ASSERT(m_socket);
+
+    frameWriter.start(FrameType::PING, FrameFlag::EMPTY, connectionStreamID);
+    frameWriter.append(++bdpPingID);
+    if (!frameWriter.write(*m_socket))
+        return false;
+
+    bdpPingInFlight = true;
+    bdpSampleSize = 0;
+    bdpPingTimer.start();
+    return true;
+}
+
 bool QHttp2ProtocolHandler::sendRST_STREAM(quint32 streamID, quint32 errorCode)
 {
     Q_ASSERT(m_socket);
@@ -576,6 +617,13 @@ void QHttp2ProtocolHandler::handleDATA()
 
     sessionReceiveWindowSize -= inboundFrame.payloadSize();
 
+    if (windowAutoTuning) {
+        if (bdpPingInFlight)
+            bdpSampleSize += inboundFrame.payloadSize();
+        else
+            sendBdpPING();
+    }
+
     if (activeStreams.contains(streamID)) {
         auto &stream = activeStreams[streamID];
 
@@ -592,21 +640,14 @@ void QHttp2ProtocolHandler::handleDATA()
             if (inboundFrame.flags().testFlag(FrameFlag::END_STREAM)) {
                 finishStream(stream);
                 deleteActiveStream(stream.streamID);
-            } else if (stream.recvWindow < streamInitialReceiveWindowSize / 2) {
-                QMetaObject::invokeMethod(this, "sendWINDOW_UPDATE", Qt::QueuedConnection,
-                                          Q_ARG(quint32, stream.streamID),
-                                          Q_ARG(quint32, streamInitialReceiveWindowSize - stream.recvWindow));
-                stream.recvWindow = streamInitialReceiveWindowSize;
+            } else if (stream.recvWindow < streamReceiveWindowTarget(stream) / 2) {
+                scheduleWINDOW_UPDATEs();
             }
         }
     }
 
-    if (sessionReceiveWindowSize < maxSessionReceiveWindowSize / 2) {
-        QMetaObject::invokeMethod(this, "sendWINDOW_UPDATE", Qt::QueuedConnection,
-                                  Q_ARG(quint32, connectionStreamID),
-                                  Q_ARG(quint32, maxSessionReceiveWindowSize - sessionReceiveWindowSize));
-        sessionReceiveWindowSize = maxSessionReceiveWindowSize;
-    }
+    if (sessionReceiveWindowSize < maxSessionReceiveWindowSize / 2)
+        scheduleWINDOW_UPDATEs();
 }
 
 void QHttp2ProtocolHandler::handleHEADERS()
@@ -795,11 +836,15 @@ void QHttp2ProtocolHandler::handlePING()
     if (inboundFrame.streamID() != connectionStreamID)
         return connectionError(PROTOCOL_ERROR, "PING on invalid stream");
 
-    if (inboundFrame.flags() & FrameFlag::ACK)
-        return connectionError(PROTOCOL_ERROR, "unexpected PING ACK");
-
     Q_ASSERT(inboundFrame.dataSize() == 8);
 
+    if (inboundFrame.flags() & FrameFlag::ACK) {
+        // The only PING we send is the one to estimate the BDP:
+        if (!bdpPingInFlight || qFromBigEndian<quint64>(inboundFrame.dataBegin()) != bdpPingID)
+            return connectionError(PROTOCOL_ERROR, "unexpected PING ACK");
+        return handleBdpPingAck();
+    }
+
     frameWriter.start(FrameType::PING, FrameFlag::ACK, connectionStreamID);
     frameWriter.append(inboundFrame.dataBegin(), inboundFrame.dataBegin() + 8);
     frameWriter.write(*m_socket);
@@ -1070,6 +1115,73 @@ bool QHttp2ProtocolHandler::acceptSetting(Http2::Settings identifier, quint32 ne
     return true;
 }
 
+void QHttp2ProtocolHandler::scheduleWINDOW_UPDATEs()
+{
+    if (windowUpdatesScheduled)
+        return;
+
+    windowUpdatesScheduled = true;
+    QMetaObject::invokeMethod(this, "sendPendingWINDOW_UPDATEs", Qt::QueuedConnection);
+}
+
+qint32 QHttp2ProtocolHandler::streamReceiveWindowTarget(const Stream &stream) const
+{
+    if (streamReceiveWindowSize == streamInitialReceiveWindowSize)
+        return streamReceiveWindowSize;
+
+    // Only the most urgent streams get an auto-tuned window, less urgent
+    // ones would otherwise take their share of the bandwidth:
+    for (const Stream &other : activeStreams) {
+        if (other.priority() < stream.priority()
+            && (other.state == Stream::open || other.state == Stream::halfClosedLocal)) {
+            return streamInitialReceiveWindowSize;
+        }
+    }
+
+    return streamReceiveWindowSize;
+}
+
+void QHttp2ProtocolHandler::handleBdpPingAck()
+{
+    Q_ASSERT(bdpPingInFlight);
+
+    bdpPingInFlight = false;
+    // If we received more than 2/3 of a window within one round trip, it's
+    // likely that the window, not the network, limits the transfer. Let the
+    // window grow to twice the BDP, to leave room for bandwidth to increase:
+    const qint64 bdp = bdpSampleSize;
+    const qint64 windowSize = 2 * bdp;
+    bool grown = false;
+    if (3 * bdp >= 2 * qint64(streamReceiveWindowSize)
+        && streamReceiveWindowSize < maxAutoTunedStreamWindowSize) {
+        streamReceiveWindowSize = qint32(std::min<qint64>(windowSize, maxAutoTunedStreamWindowSize));
+        grown = true;
+    }
+
+    if (3 * bdp >= 2 * qint64(maxSessionReceiveWindowSize)
+        && maxSessionReceiveWindowSize < maxAutoTunedSessionWindowSize) {
+        const qint32 newSize = qint32(std::min<qint64>(windowSize, maxAutoTunedSessionWindowSize));
+        // Let our peer know right away, not when half of the old window is used up:
+        sendWINDOW_UPDATE(connectionStreamID, newSize - maxSessionReceiveWindowSize);
+        sessionReceiveWindowSize += newSize - maxSessionReceiveWindowSize;
+        maxSessionReceiveWindowSize = newSize;
+        grown = true;
+    }
+
+    if (!grown)
+        return;
+
+    qCDebug(QT_HTTP2) << "BDP estimate" << bdp << "octets, RTT" << bdpPingTimer.elapsed()
+                      << "ms, window sizes: session" << maxSessionReceiveWindowSize
+                      << "stream" << streamReceiveWindowSize;
+
+    scheduleWINDOW_UPDATEs();
+    if (streamReceiveWindowSize == maxAutoTunedStreamWindowSize
+        && maxSessionReceiveWindowSize == maxAutoTunedSessionWindowSize) {
+        windowAutoTuning = false;
+    }
+}
+
 void QHttp2ProtocolHandler::updateStream(Stream &stream, const HPack::HttpHeader &headers,
                                          Qt::ConnectionType connectionType)
 {
@@ -33,6 +33,7 @@
 #include <QtCore/qobject.h>
 #include <QtCore/qflags.h>
 #include <QtCore/qhash.h>
+#include <QtCore/qelapsedtimer.h>
 
 #include <vector>
 #include <limits>
@@ -76,6 +77,8 @@ private:
     bool sendHEADERS(Stream &stream);
     bool sendDATA(Stream &stream);
     Q_INVOKABLE bool sendWINDOW_UPDATE(quint32 streamID, quint32 delta);
+    Q_INVOKABLE void sendPendingWINDOW_UPDATEs();
+    bool sendBdpPING();
     bool sendRST_STREAM(quint32 streamID, quint32 errorCoder);
     bool sendGOAWAY(quint32 errorCode);
 
@@ -94,6 +97,10 @@ private:
 
     bool acceptSetting(Http2::Settings identifier, quint32 newValue);
 
+    void scheduleWINDOW_UPDATEs();
+    qint32 streamReceiveWindowTarget(const Stream &stream) const;
+    void handleBdpPingAck();
+
     void updateStream(Stream &stream, const HPack::HttpHeader &headers,
                       Qt::ConnectionType connectionType = Qt::DirectConnection);
     void updateStream(Stream &stream, const Http2::Frame &dataFrame,
@@ -154,8 +161,8 @@ private:
     // sending requests and creating streams while maxConcurrentStreams allows).
 
     // This is our (client-side) maximum possible receive window size, we set
-    // it in a ctor from QHttp2Configuration, it does not change after that.
-    // The default is 64Kb:
+    // it in a ctor from QHttp2Configuration, it only grows later if window
+    // auto-tuning is enabled. The default is 64Kb:
     qint32 maxSessionReceiveWindowSize = Http2::defaultSessionWindowSize;
 
     // Our session current receive window size, updated in a ctor from
@@ -165,6 +172,25 @@ private:
     // Our per-stream receive window size, default is 64 Kb, will be updated
     // from QHttp2Configuration. Again, signed - can become negative.
     qint32 streamInitialReceiveWindowSize = Http2::defaultSessionWindowSize;
+    // The size we top stream windows up to with WINDOW_UPDATE frames. Starts
+    // as streamInitialReceiveWindowSize, grows with window auto-tuning.
+    qint32 streamReceiveWindowSize = Http2::defaultSessionWindowSize;
+
+    // Window auto-tuning: while DATA frames come in, we keep one PING in
+    // flight and count the octets received until it's ACKed, which is an
+    // estimate of the bandwidth-delay product (BDP) of the connection.
+    // Windows grow to twice the estimate, if that's above their size, up
+    // to these limits:
+    bool windowAutoTuning = false;
+    qint32 maxAutoTunedSessionWindowSize = Http2::defaultSessionWindowSize;
+    qint32 maxAutoTunedStreamWindowSize = Http2::defaultSessionWindowSize;
+    bool bdpPingInFlight = false;
+    quint64 bdpPingID = 0;
+    qint64 bdpSampleSize = 0;
+    QElapsedTimer bdpPingTimer;
+    // WINDOW_UPDATE frames are sent in one go, once the data available
+    // on the socket has been read:
+    bool windowUpdatesScheduled = false;
 
     // These are our peer's receive window sizes, they will be updated by the
     // peer's SETTINGS and WINDOW_UPDATE frames, defaults presumed to be 64Kb.
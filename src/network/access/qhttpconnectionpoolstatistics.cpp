@@ -0,0 +1,268 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qhttpconnectionpoolstatistics.h"
+#include "qhttpconnectionpoolstatistics_p.h"
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QHttpConnectionPoolStatistics
+    \brief The QHttpConnectionPoolStatistics class describes the HTTP/1
+    connection pool QNetworkAccessManager keeps for a single host.
+    \since 6.5
+
+    \reentrant
+    \inmodule QtNetwork
+    \ingroup network
+    \ingroup shared
+
+    QNetworkAccessManager sends HTTP/1 requests to a host over a pool of
+    persistent connections; requests for which no connection is free wait
+    in a queue. QHttpConnectionPoolStatistics is a snapshot of such a pool,
+    as returned by QNetworkAccessManager::httpConnectionPoolStatistics().
+    It tells how deep the queue is and how long requests wait in it, how
+    many connections the pool may use, and how often a request could be
+    sent over a connection that was already open.
+
+    Counters accumulate over the lifetime of the pool, which ends when
+    QNetworkAccessManager drops its idle connections to the host.
+
+    \sa QHttp1Configuration
+*/
+
+/*!
+    Constructs an empty QHttpConnectionPoolStatistics object, with
+    all counters zero.
+*/
+QHttpConnectionPoolStatistics::QHttpConnectionPoolStatistics()
+    : d(new QHttpConnectionPoolStatisticsPrivate)
+{
+}
+
+/*!
+    Copy-constructs this QHttpConnectionPoolStatistics.
+*/
+QHttpConnectionPoolStatistics::QHttpConnectionPoolStatistics(const QHttpConnectionPoolStatistics &) = default;
+
+/*!
+    Move-constructs this QHttpConnectionPoolStatistics from \a other
+*/
+QHttpConnectionPoolStatistics::QHttpConnectionPoolStatistics(QHttpConnectionPoolStatistics &&other) noexcept
+{
+    swap(other);
+}
+
+/*!
+    Copy-assigns \a other to this QHttpConnectionPoolStatistics.
+*/
+QHttpConnectionPoolStatistics &QHttpConnectionPoolStatistics::operator=(const QHttpConnectionPoolStatistics &) = default;
+
+/*!
+    Move-assigns \a other to this QHttpConnectionPoolStatistics.
+*/
+QHttpConnectionPoolStatistics &QHttpConnectionPoolStatistics::operator=(QHttpConnectionPoolStatistics &&) noexcept = default;
+
+/*!
+    Destructor.
+*/
+QHttpConnectionPoolStatistics::~QHttpConnectionPoolStatistics()
+{
+}
+
+/*!
+    Returns the name of the host the pool connects to.
+*/
+QString QHttpConnectionPoolStatistics::host() const
+{
+    return d->host;
+}
+
+/*!
+    Returns the port the pool connects to, or -1 for an empty object.
+*/
+int QHttpConnectionPoolStatistics::port() const
+{
+    return d->port;
+}
+
+/*!
+    Returns \c true if the pool's connections are encrypted.
+*/
+bool QHttpConnectionPoolStatistics::isEncrypted() const
+{
+    return d->encrypted;
+}
+
+/*!
+    Returns the number of connections the pool may currently open. This
+    is QHttp1Configuration::numberOfConnectionsPerHost() unless the pool
+    has grown towards QHttp1Configuration::maximumNumberOfConnectionsPerHost().
+*/
+qsizetype QHttpConnectionPoolStatistics::connectionLimit() const
+{
+    return d->connectionLimit;
+}
+
+/*!
+    Returns how many connections the pool has established.
+*/
+qint64 QHttpConnectionPoolStatistics::openedConnectionCount() const
+{
+    return d->openedConnections;
+}
+
+/*!
+    Returns the number of requests waiting for a free connection.
+*/
+qsizetype QHttpConnectionPoolStatistics::queueDepth() const
+{
+    return d->queueDepth;
+}
+
+/*!
+    Returns the largest number of requests that have been waiting for a
+    free connection at the same time.
+*/
+qsizetype QHttpConnectionPoolStatistics::peakQueueDepth() const
+{
+    return d->peakQueueDepth;
+}
+
+/*!
+    Returns how long requests have been waiting for a free connection,
+    on average.
+*/
+std::chrono::microseconds QHttpConnectionPoolStatistics::averageQueueWaitTime() const
+{
+    if (!d->dequeuedRequests)
+        return std::chrono::microseconds::zero();
+    return std::chrono::microseconds(d->totalQueueWaitUs / d->dequeuedRequests);
+}
+
+/*!
+    Returns the longest time a request has been waiting for a free
+    connection.
+*/
+std::chrono::microseconds QHttpConnectionPoolStatistics::maximumQueueWaitTime() const
+{
+    return std::chrono::microseconds(d->maximumQueueWaitUs);
+}
+
+/*!
+    Returns the number of requests sent over the pool's connections.
+
+    \sa reusedConnectionRequestCount()
+*/
+qint64 QHttpConnectionPoolStatistics::sentRequestCount() const
+{
+    return d->sentRequests;
+}
+
+/*!
+    Returns the number of requests that were sent over a connection that
+    had already carried an earlier request, that is without paying for a
+    new TCP (and TLS) handshake.
+
+    \sa sentRequestCount(), reuseRate()
+*/
+qint64 QHttpConnectionPoolStatistics::reusedConnectionRequestCount() const
+{
+    return d->reusedConnectionRequests;
+}
+
+/*!
+    Returns the fraction of requests sent over an already used connection,
+    between 0 and 1.
+
+    \sa reusedConnectionRequestCount()
+*/
+qreal QHttpConnectionPoolStatistics::reuseRate() const
+{
+    if (!d->sentRequests)
+        return 0;
+    return qreal(d->reusedConnectionRequests) / qreal(d->sentRequests);
+}
+
+/*!
+    Swaps these statistics with \a other.
+*/
+void QHttpConnectionPoolStatistics::swap(QHttpConnectionPoolStatistics &other) noexcept
+{
+    d.swap(other.d);
+}
+
+void QHttpConnectionPoolCounters::setQueueDepth(qsizetype depth)
+{
+    queueDepth.storeRelaxed(depth);
+    // Only the connection's thread writes, so there is no race between
+    // the load and the store:
+    if (depth > peakQueueDepth.loadRelaxed())
+        peakQueueDepth.storeRelaxed(depth);
+}
+
+void QHttpConnectionPoolCounters::requestDequeued(qint64 waitedUs)
+{
+    dequeuedRequests.fetchAndAddRelaxed(1);
+    totalQueueWaitUs.fetchAndAddRelaxed(waitedUs);
+    if (waitedUs > maximumQueueWaitUs.loadRelaxed())
+        maximumQueueWaitUs.storeRelaxed(waitedUs);
+}
+
+void QHttpConnectionPoolCounters::requestSent(bool reusedConnection)
+{
+    sentRequests.fetchAndAddRelaxed(1);
+    if (reusedConnection)
+        reusedConnectionRequests.fetchAndAddRelaxed(1);
+}
+
+QHttpConnectionPoolStatistics QHttpConnectionPoolCounters::statistics() const
+{
+    auto *d = new QHttpConnectionPoolStatisticsPrivate;
+    d->host = host;
+    d->port = port;
+    d->encrypted = encrypted;
+    d->connectionLimit = connectionLimit.loadRelaxed();
+    d->openedConnections = openedConnections.loadRelaxed();
+    d->queueDepth = queueDepth.loadRelaxed();
+    d->peakQueueDepth = peakQueueDepth.loadRelaxed();
+    d->dequeuedRequests = dequeuedRequests.loadRelaxed();
+    d->totalQueueWaitUs = totalQueueWaitUs.loadRelaxed();
+    d->maximumQueueWaitUs = maximumQueueWaitUs.loadRelaxed();
+    d->sentRequests = sentRequests.loadRelaxed();
+    d->reusedConnectionRequests = reusedConnectionRequests.loadRelaxed();
+    return QHttpConnectionPoolStatisticsPrivate::create(d);
+}
+
+void QHttpConnectionPoolRegistry::add(std::weak_ptr<QHttpConnectionPoolCounters> counters)
+{
+    QMutexLocker locker(&mutex);
+    // The counters of closed connections stay allocated as long as their
+    // weak pointers do, so don't wait for statistics() to drop them:
+    pools.erase(std::remove_if(pools.begin(), pools.end(),
+                               [](const std::weak_ptr<QHttpConnectionPoolCounters> &pool) {
+                                   return pool.expired();
+                               }),
+                pools.end());
+    pools.push_back(std::move(counters));
+}
+
+QList<QHttpConnectionPoolStatistics> QHttpConnectionPoolRegistry::statistics()
+{
+    QList<QHttpConnectionPoolStatistics> result;
+    QMutexLocker locker(&mutex);
+    pools.erase(std::remove_if(pools.begin(), pools.end(),
+                               [&result](const std::weak_ptr<QHttpConnectionPoolCounters> &pool) {
+                                   const auto counters = pool.lock();
+                                   if (!counters)
+                                       return true;
+                                   result.append(counters->statistics());
+                                   return false;
+                               }),
+                pools.end());
+    return result;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,60 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QHTTPCONNECTIONPOOLSTATISTICS_H
+#define QHTTPCONNECTIONPOOLSTATISTICS_H
+
+#include <QtNetwork/qtnetworkglobal.h>
+
+#include <QtCore/qshareddata.h>
+#include <QtCore/qstring.h>
+
+#include <chrono>
+
+#ifndef Q_CLANG_QDOC
+QT_REQUIRE_CONFIG(http);
+#endif
+
+QT_BEGIN_NAMESPACE
+
+class QHttpConnectionPoolStatisticsPrivate;
+class Q_NETWORK_EXPORT QHttpConnectionPoolStatistics
+{
+public:
+    QHttpConnectionPoolStatistics();
+    QHttpConnectionPoolStatistics(const QHttpConnectionPoolStatistics &other);
+    QHttpConnectionPoolStatistics(QHttpConnectionPoolStatistics &&other) noexcept;
+    QHttpConnectionPoolStatistics &operator = (const QHttpConnectionPoolStatistics &other);
+    QHttpConnectionPoolStatistics &operator = (QHttpConnectionPoolStatistics &&other) noexcept;
+
+    ~QHttpConnectionPoolStatistics();
+
+    QString host() const;
+    int port() const;
+    bool isEncrypted() const;
+
+    qsizetype connectionLimit() const;
+    qint64 openedConnectionCount() const;
+
+    qsizetype queueDepth() const;
+    qsizetype peakQueueDepth() const;
+    std::chrono::microseconds averageQueueWaitTime() const;
+    std::chrono::microseconds maximumQueueWaitTime() const;
+
+    qint64 sentRequestCount() const;
+    qint64 reusedConnectionRequestCount() const;
+    qreal reuseRate() const;
+
+    void swap(QHttpConnectionPoolStatistics &other) noexcept;
+
+private:
+    QSharedDataPointer<QHttpConnectionPoolStatisticsPrivate> d;
+
+    friend class QHttpConnectionPoolStatisticsPrivate;
+};
+
+Q_DECLARE_SHARED(QHttpConnectionPoolStatistics)
+
+QT_END_NAMESPACE
+
+#endif // QHTTPCONNECTIONPOOLSTATISTICS_H
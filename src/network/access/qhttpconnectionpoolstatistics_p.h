@@ -0,0 +1,111 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QHTTPCONNECTIONPOOLSTATISTICS_P_H
+#define QHTTPCONNECTIONPOOLSTATISTICS_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of the Network Access API.  This header file may change from
+// version to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtNetwork/private/qtnetworkglobal_p.h>
+#include "qhttpconnectionpoolstatistics.h"
+
+#include <QtCore/qatomic.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qmutex.h>
+
+#include <memory>
+#include <vector>
+
+QT_REQUIRE_CONFIG(http);
+
+QT_BEGIN_NAMESPACE
+
+class QHttpConnectionPoolStatisticsPrivate : public QSharedData
+{
+public:
+    QString host;
+    int port = -1;
+    bool encrypted = false;
+
+    qsizetype connectionLimit = 0;
+    qint64 openedConnections = 0;
+
+    qsizetype queueDepth = 0;
+    qsizetype peakQueueDepth = 0;
+    qint64 dequeuedRequests = 0;
+    qint64 totalQueueWaitUs = 0;
+    qint64 maximumQueueWaitUs = 0;
+
+    qint64 sentRequests = 0;
+    qint64 reusedConnectionRequests = 0;
+
+    static QHttpConnectionPoolStatistics create(QHttpConnectionPoolStatisticsPrivate *d)
+    {
+        QHttpConnectionPoolStatistics statistics;
+        statistics.d = d;
+        return statistics;
+    }
+};
+
+// The live counters of one QHttpNetworkConnection. They are only written by
+// the thread the connection lives in (QNetworkAccessManager's HTTP thread),
+// but read from whatever thread asks for the statistics, hence the atomics.
+class QHttpConnectionPoolCounters
+{
+public:
+    QHttpConnectionPoolCounters(const QString &host, int port, bool encrypted)
+        : host(host), port(port), encrypted(encrypted)
+    {}
+
+    void setConnectionLimit(qsizetype limit) { connectionLimit.storeRelaxed(limit); }
+    void connectionOpened() { openedConnections.fetchAndAddRelaxed(1); }
+    void setQueueDepth(qsizetype depth);
+    void requestDequeued(qint64 waitedUs);
+    void requestSent(bool reusedConnection);
+
+    QHttpConnectionPoolStatistics statistics() const;
+
+private:
+    const QString host;
+    const int port;
+    const bool encrypted;
+
+    QAtomicInteger<qsizetype> connectionLimit;
+    QAtomicInteger<qint64> openedConnections;
+
+    QAtomicInteger<qsizetype> queueDepth;
+    QAtomicInteger<qsizetype> peakQueueDepth;
+    QAtomicInteger<qint64> dequeuedRequests;
+    QAtomicInteger<qint64> totalQueueWaitUs;
+    QAtomicInteger<qint64> maximumQueueWaitUs;
+
+    QAtomicInteger<qint64> sentRequests;
+    QAtomicInteger<qint64> reusedConnectionRequests;
+};
+
+// All pools a QNetworkAccessManager has created. Shared with the HTTP
+// thread, which registers a pool whenever it creates a new connection;
+// pools of deleted connections drop out on the next query.
+class QHttpConnectionPoolRegistry
+{
+public:
+    void add(std::weak_ptr<QHttpConnectionPoolCounters> counters);
+    QList<QHttpConnectionPoolStatistics> statistics();
+
+private:
+    QMutex mutex;
+    std::vector<std::weak_ptr<QHttpConnectionPoolCounters>> pools;
+};
+
+QT_END_NAMESPACE
+
+#endif // QHTTPCONNECTIONPOOLSTATISTICS_P_H
@@ -3,7 +3,15 @@
 
 #include "qhttpheaderparser_p.h"
 
+#include <QtCore/qalgorithms.h>
+#include <QtCore/private/qtools_p.h>
+
+#ifdef __SSE2__
+#  include <private/qsimd_p.h>
+#endif
+
 #include <algorithm>
+#include <array>
 
 QT_BEGIN_NAMESPACE
 
@@ -21,17 +29,113 @@ void QHttpHeaderParser::clear()
     minorVersion = 0;
     reasonPhrase.clear();
     fields.clear();
+    buffer.clear();
+}
+
+namespace {
+struct WellKnownName
+{
+    QByteArrayView lowerCase;
+    QByteArrayView canonical;
+};
+}
+
+// Names of fields that are common in responses, or that QNAM asks for.
+// Only spellings that match these exactly share their storage in headers().
+static constexpr WellKnownName wellKnownNames[] = {
+    { "accept-ranges", "Accept-Ranges" },
+    { "access-control-allow-origin", "Access-Control-Allow-Origin" },
+    { "age", "Age" },
+    { "alt-svc", "Alt-Svc" },
+    { "cache-control", "Cache-Control" },
+    { "connection", "Connection" },
+    { "content-disposition", "Content-Disposition" },
+    { "content-encoding", "Content-Encoding" },
+    { "content-language", "Content-Language" },
+    { "content-length", "Content-Length" },
+    { "content-location", "Content-Location" },
+    { "content-range", "Content-Range" },
+    { "content-type", "Content-Type" },
+    { "date", "Date" },
+    { "etag", "ETag" },
+    { "expires", "Expires" },
+    { "keep-alive", "Keep-Alive" },
+    { "last-modified", "Last-Modified" },
+    { "location", "Location" },
+    { "proxy-authenticate", "Proxy-Authenticate" },
+    { "proxy-connection", "Proxy-Connection" },
+    { "retry-after", "Retry-After" },
+    { "server", "Server" },
+    { "set-cookie", "Set-Cookie" },
+    { "strict-transport-security", "Strict-Transport-Security" },
+    { "transfer-encoding", "Transfer-Encoding" },
+    { "upgrade", "Upgrade" },
+    { "vary", "Vary" },
+    { "via", "Via" },
+    { "www-authenticate", "WWW-Authenticate" },
+    { "x-content-type-options", "X-Content-Type-Options" },
+    { "x-frame-options", "X-Frame-Options" },
+};
+
+static bool equalsIgnoringCase(QByteArrayView a, QByteArrayView b)
+{
+    return a.size() == b.size() && qstrnicmp(a.data(), b.data(), a.size()) == 0;
+}
+
+// Returns the index of name in wellKnownNames, or -1
+static int wellKnownName(QByteArrayView name)
+{
+    if (name.isEmpty())
+        return -1;
+    const char first = QtMiscUtils::toAsciiLower(name.front());
+    for (int i = 0; i < int(std::size(wellKnownNames)); ++i) {
+        const QByteArrayView candidate = wellKnownNames[i].lowerCase;
+        if (candidate.size() == name.size() && candidate.front() == first
+            && equalsIgnoringCase(name, candidate)) {
+            return i;
+        }
+    }
+    return -1;
 }
 
 static bool fieldNameCheck(QByteArrayView name)
 {
-    static constexpr QByteArrayView otherCharacters("!#$%&'*+-.^_`|~");
-    static const auto fieldNameChar = [](char c) {
-        return ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z') || ('0' <= c && c <= '9')
-                || otherCharacters.contains(c);
-    };
+    // RFC 9110, 5.6.2: token characters
+    static constexpr auto fieldNameChars = [] {
+        std::array<bool, 256> table = {};
+        for (char c : QByteArrayView("!#$%&'*+-.^_`|~"))
+            table[uchar(c)] = true;
+        for (int c = '0'; c <= '9'; ++c)
+            table[c] = true;
+        for (int c = 'a'; c <= 'z'; ++c)
+            table[c] = table[c - 'a' + 'A'] = true;
+        return table;
+    }();
+
+    return !name.empty() && std::all_of(name.begin(), name.end(), [](char c) {
+        return fieldNameChars[uchar(c)];
+    });
+}
 
-    return !name.empty() && std::all_of(name.begin(), name.end(), fieldNameChar);
+// Returns the first ':' or '\n' in [p, end), or end
+static const char *findColonOrNewline(const char *p, const char *end)
+{
+#ifdef __SSE2__
+    const __m128i colon = _mm_set1_epi8(':');
+    const __m128i newline = _mm_set1_epi8('\n');
+    for ( ; end - p >= 16; p += 16) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        const uint mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(data, colon),
+                                                         _mm_cmpeq_epi8(data, newline)));
+        if (mask)
+            return p + qCountTrailingZeroBits(mask);
+    }
+#endif
+    for ( ; p != end; ++p) {
+        if (*p == ':' || *p == '\n')
+            return p;
+    }
+    return end;
 }
 
 bool QHttpHeaderParser::parseHeaders(QByteArrayView header)
@@ -52,18 +156,25 @@ bool QHttpHeaderParser::parseHeaders(QByteArrayView header)
     if (header.size() - (header.endsWith("\r\n") ? 2 : 1) > maxTotalSize)
         return false;
 
-    QList<QPair<QByteArray, QByteArray>> result;
+    // All names and values point into a copy of the headers. Values that
+    // are folded over several lines get joined at its end.
+    QByteArray storage = header.toByteArray();
+    const char *const begin = header.data();
+    QList<Field> result;
+    result.reserve(16);
     while (!header.empty()) {
-        const qsizetype colon = header.indexOf(':');
-        if (colon == -1) // if no colon check if empty headers
+        const char *separator = findColonOrNewline(header.data(), header.data() + header.size());
+        if (separator == header.data() + header.size() || *separator != ':') // if no colon check if empty headers
             return result.empty() && (header == "\n" || header == "\r\n");
         if (result.size() >= maxFieldCount)
             return false;
+        const qsizetype colon = separator - header.data();
         QByteArrayView name = header.first(colon);
         if (!fieldNameCheck(name))
             return false;
+        Field field = { name.data() - begin, name.size(), 0, 0, wellKnownName(name) };
         header = header.sliced(colon + 1);
-        QByteArray value;
+        bool joined = false;
         qsizetype valueSpace = maxFieldSize - name.size() - 1;
         do {
             const qsizetype endLine = header.indexOf('\n');
@@ -74,18 +185,28 @@ bool QHttpHeaderParser::parseHeaders(QByteArrayView header)
                 return false;
             line = line.trimmed();
             if (!line.empty()) {
-                if (value.size())
-                    value += ' ' + line.toByteArray();
-                else
-                    value = line.toByteArray();
+                if (field.valueSize) {
+                    if (!joined) {
+                        const qsizetype offset = storage.size();
+                        storage.append(begin + field.valueOffset, field.valueSize);
+                        field.valueOffset = offset;
+                        joined = true;
+                    }
+                    storage.append(' ').append(line);
+                    field.valueSize += 1 + line.size();
+                } else {
+                    field.valueOffset = line.data() - begin;
+                    field.valueSize = line.size();
+                }
             }
             header = header.sliced(endLine + 1);
         } while (hSpaceStart(header));
-        Q_ASSERT(name.size() + 1 + value.size() <= maxFieldSize);
-        result.append(qMakePair(name.toByteArray(), value));
+        Q_ASSERT(name.size() + 1 + field.valueSize <= maxFieldSize);
+        result.append(field);
     }
 
-    fields = result;
+    buffer = std::move(storage);
+    fields = std::move(result);
     return true;
 }
 
@@ -128,66 +249,111 @@ bool QHttpHeaderParser::parseStatus(QByteArrayView status)
     return ok && uint(majorVersion) <= 9 && uint(minorVersion) <= 9;
 }
 
-const QList<QPair<QByteArray, QByteArray> >& QHttpHeaderParser::headers() const
+QList<QPair<QByteArray, QByteArray> > QHttpHeaderParser::headers() const
+{
+    QList<QPair<QByteArray, QByteArray> > result;
+    result.reserve(fields.size());
+    for (const Field &field : fields) {
+        const QByteArrayView name = fieldName(field);
+        QByteArray nameCopy;
+        if (field.wellKnownName >= 0) {
+            // Share the static spelling, if the name is spelled that way
+            const WellKnownName &wellKnown = wellKnownNames[field.wellKnownName];
+            if (name == wellKnown.canonical)
+                nameCopy = QByteArray::fromRawData(wellKnown.canonical.data(), name.size());
+            else if (name == wellKnown.lowerCase)
+                nameCopy = QByteArray::fromRawData(wellKnown.lowerCase.data(), name.size());
+        }
+        if (nameCopy.isNull())
+            nameCopy = name.toByteArray();
+        result.append(qMakePair(nameCopy, fieldValue(field)));
+    }
+    return result;
+}
+
+bool QHttpHeaderParser::nameMatches(const Field &field, QByteArrayView name,
+                                    int wellKnownName) const
 {
-    return fields;
+    if (wellKnownName >= 0 || field.wellKnownName >= 0)
+        return field.wellKnownName == wellKnownName;
+    return equalsIgnoringCase(fieldName(field), name);
 }
 
 QByteArray QHttpHeaderParser::firstHeaderField(const QByteArray &name,
                                                const QByteArray &defaultValue) const
 {
-    for (auto it = fields.constBegin(); it != fields.constEnd(); ++it) {
-        if (name.compare(it->first, Qt::CaseInsensitive) == 0)
-            return it->second;
+    const int wellKnown = wellKnownName(name);
+    for (const Field &field : fields) {
+        if (nameMatches(field, name, wellKnown))
+            return fieldValue(field);
     }
     return defaultValue;
 }
 
 QByteArray QHttpHeaderParser::combinedHeaderValue(const QByteArray &name, const QByteArray &defaultValue) const
 {
-    const QList<QByteArray> allValues = headerFieldValues(name);
-    if (allValues.isEmpty())
-        return defaultValue;
-    return allValues.join(", ");
+    const int wellKnown = wellKnownName(name);
+    QByteArray result;
+    bool found = false;
+    for (const Field &field : fields) {
+        if (!nameMatches(field, name, wellKnown))
+            continue;
+        if (found)
+            result.append(", ").append(QByteArrayView(buffer).sliced(field.valueOffset, field.valueSize));
+        else
+            result = fieldValue(field);
+        found = true;
+    }
+    return found ? result : defaultValue;
 }
 
 QList<QByteArray> QHttpHeaderParser::headerFieldValues(const QByteArray &name) const
 {
+    const int wellKnown = wellKnownName(name);
     QList<QByteArray> result;
-    for (auto it = fields.constBegin(); it != fields.constEnd(); ++it)
-        if (name.compare(it->first, Qt::CaseInsensitive) == 0)
-            result += it->second;
-
+    for (const Field &field : fields) {
+        if (nameMatches(field, name, wellKnown))
+            result += fieldValue(field);
+    }
     return result;
 }
 
 void QHttpHeaderParser::removeHeaderField(const QByteArray &name)
 {
-    auto firstEqualsName = [&name](const QPair<QByteArray, QByteArray> &header) {
-        return name.compare(header.first, Qt::CaseInsensitive) == 0;
-    };
-    fields.removeIf(firstEqualsName);
+    const int wellKnown = wellKnownName(name);
+    fields.removeIf([&](const Field &field) {
+        return nameMatches(field, name, wellKnown);
+    });
+}
+
+QHttpHeaderParser::Field QHttpHeaderParser::addToBuffer(QByteArrayView name, QByteArrayView value)
+{
+    Field field = { buffer.size(), name.size(), buffer.size() + name.size(), value.size(),
+                    wellKnownName(name) };
+    buffer.append(name).append(value);
+    return field;
 }
 
 void QHttpHeaderParser::setHeaderField(const QByteArray &name, const QByteArray &data)
 {
     removeHeaderField(name);
-    fields.append(qMakePair(name, data));
+    fields.append(addToBuffer(name, data));
 }
 
 void QHttpHeaderParser::prependHeaderField(const QByteArray &name, const QByteArray &data)
 {
-    fields.prepend(qMakePair(name, data));
+    fields.prepend(addToBuffer(name, data));
 }
 
 void QHttpHeaderParser::appendHeaderField(const QByteArray &name, const QByteArray &data)
 {
-    fields.append(qMakePair(name, data));
+    fields.append(addToBuffer(name, data));
 }
 
 void QHttpHeaderParser::clearHeaders()
 {
     fields.clear();
+    buffer.clear();
 }
 
 int QHttpHeaderParser::getStatusCode() const
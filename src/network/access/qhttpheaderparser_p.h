@@ -52,7 +52,7 @@ public:
     bool parseHeaders(QByteArrayView headers);
     bool parseStatus(QByteArrayView status);
 
-    const QList<QPair<QByteArray, QByteArray> >& headers() const;
+    QList<QPair<QByteArray, QByteArray> > headers() const;
     void setStatusCode(int code);
     int getStatusCode() const;
     int getMajorVersion() const;
@@ -83,7 +83,27 @@ public:
     qsizetype maxHeaderFields() const { return maxFieldCount; }
 
 private:
-    QList<QPair<QByteArray, QByteArray> > fields;
+    // A field's name and value, as ranges of buffer. Names of well-known
+    // fields are identified by their index in a table, so that looking
+    // them up doesn't need to compare strings.
+    struct Field
+    {
+        qsizetype nameOffset;
+        qsizetype nameSize;
+        qsizetype valueOffset;
+        qsizetype valueSize;
+        int wellKnownName; // -1 for other names
+    };
+
+    Field addToBuffer(QByteArrayView name, QByteArrayView value);
+    bool nameMatches(const Field &field, QByteArrayView name, int wellKnownName) const;
+    QByteArrayView fieldName(const Field &field) const
+    { return QByteArrayView(buffer).sliced(field.nameOffset, field.nameSize); }
+    QByteArray fieldValue(const Field &field) const
+    { return buffer.mid(field.valueOffset, field.valueSize); }
+
+    QByteArray buffer;
+    QList<Field> fields;
     QString reasonPhrase;
     int statusCode;
     int majorVersion;
@@ -40,6 +40,14 @@ const int QHttpNetworkConnectionPrivate::defaultPipelineLength = 3;
 // This means that there are 2 requests in flight and 2 slots free that will be re-filled.
 const int QHttpNetworkConnectionPrivate::defaultRePipelineLength = 2;
 
+// If the maximum number of connections per host is larger than the configured
+// number, one more channel is opened whenever all channels are busy and the
+// oldest queued request has been waiting for this long (in milliseconds)...
+const int QHttpNetworkConnectionPrivate::channelGrowthQueueDelay = 5;
+// ... and the extra channels are closed again once no request had to wait
+// for this long (in milliseconds).
+const int QHttpNetworkConnectionPrivate::channelShrinkIdleInterval = 5000;
+
 
 QHttpNetworkConnectionPrivate::QHttpNetworkConnectionPrivate(const QString &hostName,
                                                              quint16 port, bool encrypt,
@@ -51,6 +59,8 @@ QHttpNetworkConnectionPrivate::QHttpNetworkConnectionPrivate(const QString &host
                        || type == QHttpNetworkConnection::ConnectionTypeHTTP2Direct
                        ? 1 : defaultHttpChannelCount)
   , channelCount(defaultHttpChannelCount)
+  , channelLimit(defaultHttpChannelCount)
+  , baseChannelLimit(defaultHttpChannelCount)
 #ifndef QT_NO_NETWORKPROXY
   , networkProxy(QNetworkProxy::NoProxy)
 #endif
@@ -69,13 +79,18 @@ QHttpNetworkConnectionPrivate::QHttpNetworkConnectionPrivate(quint16 connectionC
                                                              QHttpNetworkConnection::ConnectionType type)
 : state(RunningState), networkLayerState(Unknown),
   hostName(hostName), port(port), encrypt(encrypt), delayIpv4(true),
-  activeChannelCount(connectionCount), channelCount(connectionCount)
+  activeChannelCount(type == QHttpNetworkConnection::ConnectionTypeHTTP2
+                     || type == QHttpNetworkConnection::ConnectionTypeHTTP2Direct
+                     ? 1 : connectionCount),
+  channelCount(connectionCount), channelLimit(connectionCount), baseChannelLimit(connectionCount)
 #ifndef QT_NO_NETWORKPROXY
   , networkProxy(QNetworkProxy::NoProxy)
 #endif
   , preConnectRequests(0)
   , connectionType(type)
 {
+    // As above, all channels are allocated even for HTTP/2, to fall back to HTTP/1.1.
+    Q_ASSERT(channelCount >= activeChannelCount);
     channels = new QHttpNetworkConnectionChannel[channelCount];
 }
 
@@ -103,6 +118,14 @@ void QHttpNetworkConnectionPrivate::init()
 
     delayedConnectionTimer.setSingleShot(true);
     QObject::connect(&delayedConnectionTimer, SIGNAL(timeout()), q, SLOT(_q_connectDelayedChannel()));
+
+    poolCounters = std::make_shared<QHttpConnectionPoolCounters>(hostName, port, encrypt);
+    poolCounters->setConnectionLimit(channelLimit);
+    channelGrowthTimer.setSingleShot(true);
+    channelGrowthTimer.setInterval(channelGrowthQueueDelay);
+    QObject::connect(&channelGrowthTimer, SIGNAL(timeout()), q, SLOT(_q_startNextRequest()));
+    channelShrinkTimer.setInterval(channelShrinkIdleInterval);
+    QObject::connect(&channelShrinkTimer, SIGNAL(timeout()), q, SLOT(_q_shrinkChannels()));
 }
 
 void QHttpNetworkConnectionPrivate::pauseConnection()
@@ -604,6 +627,7 @@ QHttpNetworkReply* QHttpNetworkConnectionPrivate::queueRequest(const QHttpNetwor
     reply->setRequest(request);
     reply->d_func()->connection = q;
     reply->d_func()->connectionChannel = &channels[0]; // will have the correct one set later
+    reply->d_func()->queuedTimer.start();
     HttpMessagePair pair = qMakePair(request, reply);
 
     if (request.isPreConnect())
@@ -620,6 +644,7 @@ QHttpNetworkReply* QHttpNetworkConnectionPrivate::queueRequest(const QHttpNetwor
             lowPriorityQueue.prepend(pair);
             break;
         }
+        updateQueueStatistics();
     }
     else { // HTTP/2 ('h2' mode)
         if (!pair.second->d_func()->requestIsPrepared)
@@ -664,6 +689,7 @@ void QHttpNetworkConnectionPrivate::fillHttp2Queue()
     }
 
     lowPriorityQueue.clear();
+    updateQueueStatistics();
 }
 
 void QHttpNetworkConnectionPrivate::requeueRequest(const HttpMessagePair &pair)
@@ -671,6 +697,7 @@ void QHttpNetworkConnectionPrivate::requeueRequest(const HttpMessagePair &pair)
     Q_Q(QHttpNetworkConnection);
 
     QHttpNetworkRequest request = pair.first;
+    pair.second->d_func()->queuedTimer.start();
     switch (request.priority()) {
     case QHttpNetworkRequest::HighPriority:
         highPriorityQueue.prepend(pair);
@@ -680,6 +707,7 @@ void QHttpNetworkConnectionPrivate::requeueRequest(const HttpMessagePair &pair)
         lowPriorityQueue.prepend(pair);
         break;
     }
+    updateQueueStatistics();
 
     QMetaObject::invokeMethod(q, "_q_startNextRequest", Qt::QueuedConnection);
 }
@@ -696,6 +724,8 @@ bool QHttpNetworkConnectionPrivate::dequeueRequest(QAbstractSocket *socket)
         if (!messagePair.second->d_func()->requestIsPrepared)
             prepareRequest(messagePair);
         updateChannel(i, messagePair);
+        if (socket)
+            requestDequeued(messagePair, channels[i]);
         return true;
     }
 
@@ -705,6 +735,8 @@ bool QHttpNetworkConnectionPrivate::dequeueRequest(QAbstractSocket *socket)
         if (!messagePair.second->d_func()->requestIsPrepared)
             prepareRequest(messagePair);
         updateChannel(i, messagePair);
+        if (socket)
+            requestDequeued(messagePair, channels[i]);
         return true;
     }
     return false;
@@ -850,6 +882,7 @@ bool QHttpNetworkConnectionPrivate::fillPipeline(QList<HttpMessagePair> &queue,
         if (!messagePair.second->d_func()->requestIsPrepared)
             prepareRequest(messagePair);
         channel.pipelineInto(messagePair);
+        requestDequeued(messagePair, channel);
 
         // return false because we processed something and need to process again
         return false;
@@ -986,6 +1019,7 @@ void QHttpNetworkConnectionPrivate::removeReply(QHttpNetworkReply *reply)
             HttpMessagePair messagePair = highPriorityQueue.at(j);
             if (messagePair.second == reply) {
                 highPriorityQueue.removeAt(j);
+                updateQueueStatistics();
                 QMetaObject::invokeMethod(q, "_q_startNextRequest", Qt::QueuedConnection);
                 return;
             }
@@ -997,6 +1031,7 @@ void QHttpNetworkConnectionPrivate::removeReply(QHttpNetworkReply *reply)
             HttpMessagePair messagePair = lowPriorityQueue.at(j);
             if (messagePair.second == reply) {
                 lowPriorityQueue.removeAt(j);
+                updateQueueStatistics();
                 QMetaObject::invokeMethod(q, "_q_startNextRequest", Qt::QueuedConnection);
                 return;
             }
@@ -1110,9 +1145,10 @@ void QHttpNetworkConnectionPrivate::_q_startNextRequest()
         return;
 
     QQueue<int> channelsToConnect;
+    const int usableChannelCount = qMin(activeChannelCount, channelLimit);
 
     // use previously used channels first
-    for (int i = 0; i < activeChannelCount && neededOpenChannels > 0; ++i) {
+    for (int i = 0; i < usableChannelCount && neededOpenChannels > 0; ++i) {
         if (!channels[i].socket)
             continue;
 
@@ -1131,7 +1167,7 @@ void QHttpNetworkConnectionPrivate::_q_startNextRequest()
     }
 
     // use other channels
-    for (int i = 0; i < activeChannelCount && neededOpenChannels > 0; ++i) {
+    for (int i = 0; i < usableChannelCount && neededOpenChannels > 0; ++i) {
         if (channels[i].socket)
             continue;
 
@@ -1139,6 +1175,28 @@ void QHttpNetworkConnectionPrivate::_q_startNextRequest()
         neededOpenChannels--;
     }
 
+    // Requests are left waiting even with all usable channels busy: if they
+    // have been waiting for long enough, make room for one more channel.
+    if (neededOpenChannels > 0) {
+        lastQueueingDelay.start();
+        if (channelLimit < activeChannelCount) {
+            if (shouldGrowChannels()) {
+                const int i = channelLimit++;
+                poolCounters->setConnectionLimit(channelLimit);
+                if (!channels[i].reply && !channels[i].isSocketBusy()
+                    && (!channels[i].socket
+                        || channels[i].socket->state() == QAbstractSocket::UnconnectedState)) {
+                    channelsToConnect.enqueue(i);
+                }
+                if (!channelShrinkTimer.isActive())
+                    channelShrinkTimer.start();
+            }
+            // Come back even if no channel finishes a request in the meantime:
+            if (!channelGrowthTimer.isActive())
+                channelGrowthTimer.start();
+        }
+    }
+
     while (!channelsToConnect.isEmpty()) {
         const int channel = channelsToConnect.dequeue();
 
@@ -1152,6 +1210,60 @@ void QHttpNetworkConnectionPrivate::_q_startNextRequest()
 }
 
 
+void QHttpNetworkConnectionPrivate::updateQueueStatistics()
+{
+    poolCounters->setQueueDepth(highPriorityQueue.size() + lowPriorityQueue.size());
+}
+
+// Called whenever a request was taken from the queues to be sent on channel.
+void QHttpNetworkConnectionPrivate::requestDequeued(const HttpMessagePair &messagePair,
+                                                    QHttpNetworkConnectionChannel &channel)
+{
+    const QElapsedTimer &queuedTimer = messagePair.second->d_func()->queuedTimer;
+    poolCounters->requestDequeued(queuedTimer.isValid() ? queuedTimer.nsecsElapsed() / 1000 : 0);
+    poolCounters->requestSent(channel.requestsOnConnection++ > 0);
+    updateQueueStatistics();
+}
+
+bool QHttpNetworkConnectionPrivate::shouldGrowChannels() const
+{
+    // The queues are FIFO, with the oldest request at the end.
+    const auto waitedFor = [](const QList<HttpMessagePair> &queue) -> qint64 {
+        if (queue.isEmpty())
+            return 0;
+        const QElapsedTimer &queuedTimer = queue.last().second->d_func()->queuedTimer;
+        return queuedTimer.isValid() ? queuedTimer.elapsed() : 0;
+    };
+    return qMax(waitedFor(highPriorityQueue), waitedFor(lowPriorityQueue)) >= channelGrowthQueueDelay;
+}
+
+// Runs every channelShrinkIdleInterval milliseconds while the connection
+// uses more channels than configured.
+void QHttpNetworkConnectionPrivate::_q_shrinkChannels()
+{
+    // Requests still had to wait recently, the extra channels are needed:
+    if (lastQueueingDelay.isValid() && !lastQueueingDelay.hasExpired(channelShrinkIdleInterval))
+        return;
+
+    channelLimit = baseChannelLimit;
+    poolCounters->setConnectionLimit(channelLimit);
+
+    bool busyChannelLeft = false;
+    for (int i = channelLimit; i < channelCount; ++i) {
+        if (!channels[i].socket || channels[i].socket->state() == QAbstractSocket::UnconnectedState)
+            continue;
+        if (channels[i].reply || channels[i].isSocketBusy()
+            || !channels[i].alreadyPipelinedRequests.isEmpty()) {
+            // Close it once it's done, on the next timeout.
+            busyChannelLeft = true;
+            continue;
+        }
+        channels[i].close();
+    }
+    if (!busyChannelLeft)
+        channelShrinkTimer.stop();
+}
+
 void QHttpNetworkConnectionPrivate::readMoreLater(QHttpNetworkReply *reply)
 {
     for (int i = 0 ; i < activeChannelCount; ++i) {
@@ -1424,6 +1536,23 @@ void QHttpNetworkConnection::setConnectionType(ConnectionType type)
     d->connectionType = type;
 }
 
+QHttp1Configuration QHttpNetworkConnection::http1Parameters() const
+{
+    Q_D(const QHttpNetworkConnection);
+    return d->http1Parameters;
+}
+
+void QHttpNetworkConnection::setHttp1Parameters(const QHttp1Configuration &params)
+{
+    Q_D(QHttpNetworkConnection);
+    d->http1Parameters = params;
+    // The channels were allocated for the maximum number of connections,
+    // the configured number is where the channel limit starts:
+    d->baseChannelLimit = qBound(1, int(params.numberOfConnectionsPerHost()), d->channelCount);
+    d->channelLimit = d->baseChannelLimit;
+    d->poolCounters->setConnectionLimit(d->channelLimit);
+}
+
 QHttp2Configuration QHttpNetworkConnection::http2Parameters() const
 {
     Q_D(const QHttpNetworkConnection);
@@ -20,6 +20,7 @@
 #include <QtNetwork/qnetworkreply.h>
 #include <QtNetwork/qabstractsocket.h>
 
+#include <qhttp1configuration.h>
 #include <qhttp2configuration.h>
 
 #include <private/qobject_p.h>
@@ -27,6 +28,7 @@
 #include <qnetworkproxy.h>
 #include <qbuffer.h>
 #include <qtimer.h>
+#include <qelapsedtimer.h>
 #include <qsharedpointer.h>
 
 #include <private/qhttpnetworkheader_p.h>
@@ -36,6 +38,9 @@
 #include <private/http2protocol_p.h>
 
 #include <private/qhttpnetworkconnectionchannel_p.h>
+#include <private/qhttpconnectionpoolstatistics_p.h>
+
+#include <memory>
 
 QT_REQUIRE_CONFIG(http);
 
@@ -95,6 +100,9 @@ public:
     ConnectionType connectionType();
     void setConnectionType(ConnectionType type);
 
+    QHttp1Configuration http1Parameters() const;
+    void setHttp1Parameters(const QHttp1Configuration &params);
+
     QHttp2Configuration http2Parameters() const;
     void setHttp2Parameters(const QHttp2Configuration &params);
 
@@ -127,6 +135,7 @@ private:
     Q_PRIVATE_SLOT(d_func(), void _q_startNextRequest())
     Q_PRIVATE_SLOT(d_func(), void _q_hostLookupFinished(QHostInfo))
     Q_PRIVATE_SLOT(d_func(), void _q_connectDelayedChannel())
+    Q_PRIVATE_SLOT(d_func(), void _q_shrinkChannels())
 };
 
 
@@ -141,6 +150,8 @@ public:
     static const int defaultHttpChannelCount;
     static const int defaultPipelineLength;
     static const int defaultRePipelineLength;
+    static const int channelGrowthQueueDelay;
+    static const int channelShrinkIdleInterval;
 
     enum ConnectionState {
         RunningState = 0,
@@ -183,6 +194,11 @@ public:
     void fillPipeline(QAbstractSocket *socket);
     bool fillPipeline(QList<HttpMessagePair> &queue, QHttpNetworkConnectionChannel &channel);
 
+    // pool statistics and adaptive channel limit
+    void updateQueueStatistics();
+    void requestDequeued(const HttpMessagePair &messagePair, QHttpNetworkConnectionChannel &channel);
+    bool shouldGrowChannels() const;
+
     // read more HTTP body after the next event loop spin
     void readMoreLater(QHttpNetworkReply *reply);
 
@@ -197,6 +213,7 @@ public:
 
     void _q_hostLookupFinished(const QHostInfo &info);
     void _q_connectDelayedChannel();
+    void _q_shrinkChannels();
 
     void createAuthorization(QAbstractSocket *socket, QHttpNetworkRequest &request);
 
@@ -214,6 +231,14 @@ public:
     int activeChannelCount;
     // The total number of channels we reserved:
     const int channelCount;
+    // The number of channels that may open a new connection: starts at
+    // the configured number of connections per host and, if the maximum
+    // configured is larger, grows up to channelCount while requests wait.
+    int channelLimit;
+    int baseChannelLimit;
+    QTimer channelGrowthTimer;
+    QTimer channelShrinkTimer;
+    QElapsedTimer lastQueueingDelay;
     QTimer delayedConnectionTimer;
     QHttpNetworkConnectionChannel *channels; // parallel connections to the server
     bool shouldEmitChannelError(QAbstractSocket *socket);
@@ -249,8 +274,11 @@ public:
     std::shared_ptr<QSslContext> sslContext;
 #endif
 
+    QHttp1Configuration http1Parameters;
     QHttp2Configuration http2Parameters;
 
+    std::shared_ptr<QHttpConnectionPoolCounters> poolCounters;
+
     QString peerVerifyName;
     // If network status monitoring is enabled, we activate connectionMonitor
     // as soons as one of channels managed to connect to host (and we
@@ -59,6 +59,7 @@ QHttpNetworkConnectionChannel::QHttpNetworkConnectionChannel()
     , lastStatus(0)
     , pendingEncrypt(false)
     , reconnectAttempts(reconnectAttemptsDefault)
+    , requestsOnConnection(0)
     , authenticationCredentialsSent(false)
     , proxyCredentialsSent(false)
     , protocolHandler(nullptr)
@@ -870,6 +871,9 @@ void QHttpNetworkConnectionChannel::_q_connected()
         //The connections networkLayerState had already been decided.
     }
 
+    requestsOnConnection = 0;
+    connection->d_func()->poolCounters->connectionOpened();
+
     // improve performance since we get the request sent by the kernel ASAP
     //socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
     // We have this commented out now. It did not have the effect we wanted. If we want to
@@ -31,11 +31,7 @@ void QHttpNetworkHeaderPrivate::setContentLength(qint64 length)
 
 QByteArray QHttpNetworkHeaderPrivate::headerField(const QByteArray &name, const QByteArray &defaultValue) const
 {
-    QList<QByteArray> allValues = headerFieldValues(name);
-    if (allValues.isEmpty())
-        return defaultValue;
-    else
-        return allValues.join(", ");
+    return parser.combinedHeaderValue(name, defaultValue);
 }
 
 QList<QByteArray> QHttpNetworkHeaderPrivate::headerFieldValues(const QByteArray &name) const
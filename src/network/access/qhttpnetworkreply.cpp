@@ -458,22 +458,29 @@ qint64 QHttpNetworkReplyPrivate::readHeader(QAbstractSocket *socket)
     }
 
     qint64 bytes = 0;
-    char c = 0;
     bool allHeaders = false;
-    qint64 haveRead = 0;
-    do {
-        haveRead = socket->read(&c, 1);
+    char buffer[1024];
+    while (!allHeaders) {
+        // Take whole lines of what has arrived, but nothing past the end
+        // of the headers: the body is read separately.
+        const qint64 haveRead = socket->peek(buffer, sizeof buffer);
         if (haveRead == 0) {
             // read more later
             break;
         } else if (haveRead == -1) {
             // connection broke down
             return -1;
-        } else {
-            fragment.append(c);
-            bytes++;
+        }
 
-            if (c == '\n') {
+        const QByteArrayView chunk(buffer, haveRead);
+        qsizetype taken = 0;
+        while (!allHeaders && taken < chunk.size()) {
+            const qsizetype endLine = chunk.indexOf('\n', taken);
+            const qsizetype end = endLine < 0 ? chunk.size() : endLine + 1;
+            fragment.append(chunk.sliced(taken, end - taken));
+            taken = end;
+
+            if (endLine >= 0) {
                 // check for possible header endings. As per HTTP rfc,
                 // the header endings will be marked by CRLFCRLF. But
                 // we will allow CRLFCRLF, CRLFLF, LFCRLF, LFLF
@@ -487,7 +494,9 @@ qint64 QHttpNetworkReplyPrivate::readHeader(QAbstractSocket *socket)
                     allHeaders = true;
             }
         }
-    } while (!allHeaders && haveRead > 0);
+        socket->skip(taken);
+        bytes += taken;
+    }
 
     // we received all headers now parse them
     if (allHeaders) {
@@ -42,6 +42,8 @@ Q_MOC_INCLUDE(<QtNetwork/QAuthenticator>)
 
 #include <private/qdecompresshelper_p.h>
 
+#include <QtCore/qelapsedtimer.h>
+
 QT_REQUIRE_CONFIG(http);
 
 QT_BEGIN_NAMESPACE
@@ -241,6 +243,10 @@ public:
 
     char* userProvidedDownloadBuffer;
     QUrl redirectUrl;
+
+    // Started when the request is queued on its connection, to tell how
+    // long it has been waiting for a free channel:
+    QElapsedTimer queuedTimer;
 };
 
 
@@ -145,9 +145,10 @@ class QNetworkAccessCachedHttpConnection: public QHttpNetworkConnection,
 {
     // Q_OBJECT
 public:
-    QNetworkAccessCachedHttpConnection(const QString &hostName, quint16 port, bool encrypt,
+    QNetworkAccessCachedHttpConnection(quint16 connectionCount, const QString &hostName,
+                                       quint16 port, bool encrypt,
                                        QHttpNetworkConnection::ConnectionType connectionType)
-        : QHttpNetworkConnection(hostName, port, encrypt, connectionType)
+        : QHttpNetworkConnection(connectionCount, hostName, port, encrypt, nullptr, connectionType)
     {
         setExpires(true);
         setShareable(true);
@@ -297,8 +298,14 @@ void QHttpThreadDelegate::startRequest()
     if (!httpConnection) {
         // no entry in cache; create an object
         // the http object is actually a QHttpNetworkConnection
-        httpConnection = new QNetworkAccessCachedHttpConnection(urlCopy.host(), urlCopy.port(), ssl,
+        // Reserve channels for as many connections as the pool may grow to:
+        const qsizetype connectionCount = http1Parameters.maximumNumberOfConnectionsPerHost();
+        httpConnection = new QNetworkAccessCachedHttpConnection(connectionCount, urlCopy.host(),
+                                                                urlCopy.port(), ssl,
                                                                 connectionType);
+        httpConnection->setHttp1Parameters(http1Parameters);
+        if (connectionPools)
+            connectionPools->add(httpConnection->d_func()->poolCounters);
         if (connectionType == QHttpNetworkConnection::ConnectionTypeHTTP2
             || connectionType == QHttpNetworkConnection::ConnectionTypeHTTP2Direct) {
             httpConnection->setHttp2Parameters(http2Parameters);
@@ -1396,6 +1396,27 @@ void QNetworkAccessManager::setTransferTimeout(int timeout)
     d_func()->transferTimeout = timeout;
 }
 
+#if QT_CONFIG(http)
+/*!
+    \since 6.5
+
+    Returns a snapshot of the HTTP/1 connection pools this
+    QNetworkAccessManager currently keeps, one per host (and port,
+    proxy and encryption) it has sent requests to.
+
+    This function is thread-safe; the pools themselves live in
+    QNetworkAccessManager's internal HTTP thread. Pools of connections
+    that were dropped from the connection cache, for example by
+    clearConnectionCache(), are no longer reported.
+
+    \sa QHttpConnectionPoolStatistics, QHttp1Configuration
+*/
+QList<QHttpConnectionPoolStatistics> QNetworkAccessManager::httpConnectionPoolStatistics() const
+{
+    return d_func()->httpConnectionPools->statistics();
+}
+#endif
+
 void QNetworkAccessManagerPrivate::_q_replyFinished(QNetworkReply *reply)
 {
     Q_Q(QNetworkAccessManager);
@@ -29,6 +29,7 @@ class QNetworkProxyFactory;
 class QSslError;
 class QHstsPolicy;
 class QHttpMultiPart;
+class QHttpConnectionPoolStatistics;
 
 class QNetworkReplyImplPrivate;
 class QNetworkAccessManagerPrivate;
@@ -112,6 +113,10 @@ public:
     int transferTimeout() const;
     void setTransferTimeout(int timeout = QNetworkRequest::DefaultTransferTimeoutConstant);
 
+#if QT_CONFIG(http)
+    QList<QHttpConnectionPoolStatistics> httpConnectionPoolStatistics() const;
+#endif
+
 Q_SIGNALS:
 #ifndef QT_NO_NETWORKPROXY
     void proxyAuthenticationRequired(const QNetworkProxy &proxy, QAuthenticator *authenticator);
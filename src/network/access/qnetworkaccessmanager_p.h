@@ -29,6 +29,9 @@
 #if QT_CONFIG(settings)
 #include "qhstsstore_p.h"
 #endif // QT_CONFIG(settings)
+#if QT_CONFIG(http)
+#include "qhttpconnectionpoolstatistics_p.h"
+#endif // QT_CONFIG(http)
 
 QT_BEGIN_NAMESPACE
 
@@ -116,6 +119,12 @@ public:
     // The cache with authorization data:
     std::shared_ptr<QNetworkAccessAuthenticationManager> authenticationManager;
 
+#if QT_CONFIG(http)
+    // The HTTP/1 connection pools our HTTP thread has created:
+    std::shared_ptr<QHttpConnectionPoolRegistry> httpConnectionPools
+        = std::make_shared<QHttpConnectionPoolRegistry>();
+#endif
+
     // this cache can be used by individual backends to cache e.g. their TCP connections to a server
     // and use the connections for multiple requests.
     QNetworkAccessCache objectCache;
@@ -13,17 +13,23 @@
 #include <qdatastream.h>
 #include <qdatetime.h>
 #include <qdiriterator.h>
+#include <qrandom.h>
+#include <qsavefile.h>
 #include <qurl.h>
 #include <qcryptographichash.h>
 #include <qdebug.h>
-#include <QMultiMap>
 
+#include <algorithm>
 #include <memory>
+#include <optional>
+#include <utility>
 
 #define CACHE_POSTFIX ".d"_L1
 #define PREPARED_SLASH "prepared/"_L1
 #define CACHE_VERSION 8
 #define DATA_DIR "data"_L1
+#define INDEX_FILE "index"_L1
+#define NUM_SUBDIRECTORIES 256
 
 #define MAX_COMPRESSION_SIZE (1024 * 1024 * 3)
 
@@ -43,12 +49,18 @@ using namespace Qt::StringLiterals;
     are compressed using qCompress.  Data is written to disk only in insert()
     and updateMetaData().
 
-    Currently you cannot share the same cache files with more than
-    one disk cache.
-
     QNetworkDiskCache by default limits the amount of space that the cache will
     use on the system to 50MB.
 
+    QNetworkDiskCache keeps an index of its files, which it stores in the
+    cache directory as well. This lets it find out whether a URL is cached,
+    and which files to remove when the cache is full, without looking at
+    every file in the cache directory. Several QNetworkDiskCache objects,
+    for instance one for each thread, can share a cache directory; each
+    of them finds the files the others store, though it may take a second
+    until it does, and keeps the directory within its own
+    maximumCacheSize().
+
     Note you have to set the cache directory before it will work.
 
     A network disk cache can be enabled by:
@@ -118,6 +130,7 @@ void QNetworkDiskCache::setCacheDirectory(const QString &cacheDir)
         d->cacheDirectory += u'/';
 
     d->dataDirectory = d->cacheDirectory + DATA_DIR + QString::number(CACHE_VERSION) + u'/';
+    d->resetIndex();
     d->prepareLayout();
 }
 
@@ -221,10 +234,10 @@ void QNetworkDiskCachePrivate::prepareLayout()
     QDir helper;
     helper.mkpath(cacheDirectory + PREPARED_SLASH);
 
-    //Create directory and subdirectories 0-F
+    //Create directory and subdirectories 00-FF
     helper.mkpath(dataDirectory);
-    for (uint i = 0; i < 16 ; i++) {
-        QString str = QString::number(i, 16);
+    for (uint i = 0; i < NUM_SUBDIRECTORIES; i++) {
+        QString str = QString::number(i, 16).rightJustified(2, u'0');
         QString subdir = dataDirectory + str;
         helper.mkdir(subdir);
     }
@@ -260,11 +273,19 @@ void QNetworkDiskCachePrivate::storeItem(QCacheItem *cacheItem)
         && cacheItem->file->isOpen()
         && cacheItem->file->error() == QFile::NoError) {
         cacheItem->file->setAutoRemove(false);
+        const qint64 size = cacheItem->file->size();
+        // Index the file before it's there: if we don't get to rename
+        // it, expire() drops the entry eventually, while a file that is
+        // not in the index would never be removed.
+        const QString key = indexKey(fileName);
+        indexFile(key, size);
         // ### use atomic rename rather then remove & rename
-        if (cacheItem->file->rename(fileName))
-            currentCacheSize += cacheItem->file->size();
-        else
+        if (cacheItem->file->rename(fileName)) {
+            currentCacheSize += size;
+        } else {
+            unindexFile(key);
             cacheItem->file->setAutoRemove(true);
+        }
     }
     if (cacheItem->metaData.url() == lastItem.metaData.url())
         lastItem.reset();
@@ -305,16 +326,17 @@ bool QNetworkDiskCachePrivate::removeFile(const QString &file)
 #endif
     if (file.isEmpty())
         return false;
-    QFileInfo info(file);
-    QString fileName = info.fileName();
-    if (!fileName.endsWith(CACHE_POSTFIX))
+    if (!file.endsWith(CACHE_POSTFIX))
         return false;
-    qint64 size = info.size();
-    if (QFile::remove(file)) {
+    const QString key = indexKey(file);
+    const bool indexed = isIndexed(file);
+    const qint64 size = indexed ? index.value(key).size : 0;
+    const bool removed = QFile::remove(file);
+    if (indexed && (removed || !QFileInfo::exists(file))) {
+        unindexFile(key);
         currentCacheSize -= size;
-        return true;
     }
-    return false;
+    return removed;
 }
 
 /*!
@@ -328,7 +350,10 @@ QNetworkCacheMetaData QNetworkDiskCache::metaData(const QUrl &url)
     Q_D(QNetworkDiskCache);
     if (d->lastItem.metaData.url() == url)
         return d->lastItem.metaData;
-    return fileMetaData(d->cacheFileName(url));
+    const QString fileName = d->cacheFileName(url);
+    if (!d->isIndexed(fileName))
+        return QNetworkCacheMetaData();
+    return fileMetaData(fileName);
 }
 
 /*!
@@ -365,11 +390,14 @@ QIODevice *QNetworkDiskCache::data(const QUrl &url)
     std::unique_ptr<QBuffer> buffer;
     if (!url.isValid())
         return nullptr;
+    const QString fileName = d->cacheFileName(url);
     if (d->lastItem.metaData.url() == url && d->lastItem.data.isOpen()) {
         buffer.reset(new QBuffer);
         buffer->setData(d->lastItem.data.data());
     } else {
-        QScopedPointer<QFile> file(new QFile(d->cacheFileName(url)));
+        if (!d->isIndexed(fileName))
+            return nullptr;
+        QScopedPointer<QFile> file(new QFile(fileName));
         if (!file->open(QFile::ReadOnly | QIODevice::Unbuffered))
             return nullptr;
 
@@ -387,6 +415,7 @@ QIODevice *QNetworkDiskCache::data(const QUrl &url)
             buffer->setData(file->readAll());
         }
     }
+    d->touchFile(fileName);
     buffer->open(QBuffer::ReadOnly);
     return buffer.release();
 }
@@ -456,9 +485,13 @@ void QNetworkDiskCache::setMaximumCacheSize(qint64 size)
     Returns the current size of the cache.
 
     When the current size of the cache is greater than the maximumCacheSize()
-    older cache files are removed until the total size is less then 90% of
-    maximumCacheSize() starting with the oldest ones first using the file
-    creation date to determine how old a cache file is.
+    cache files are removed until the total size is less than
+    maximumCacheSize(), starting with the ones that have been used least
+    recently. A file counts as used when it's inserted and whenever its
+    data() is read.
+
+    QNetworkDiskCache finds these files in its index, so a full cache
+    makes room for each new item without scanning the cache directory.
 
     Subclasses can reimplement this function to change the order that cache
     files are removed taking into account information in the application
@@ -472,6 +505,9 @@ void QNetworkDiskCache::setMaximumCacheSize(qint64 size)
 qint64 QNetworkDiskCache::expire()
 {
     Q_D(QNetworkDiskCache);
+    // Count what other caches sharing the directory have stored:
+    if (d->indexLoaded)
+        d->syncIndex();
     if (d->currentCacheSize >= 0 && d->currentCacheSize < maximumCacheSize())
         return d->currentCacheSize;
 
@@ -483,56 +519,24 @@ qint64 QNetworkDiskCache::expire()
     // close file handle to prevent "in use" error when QFile::remove() is called
     d->lastItem.reset();
 
-    QDir::Filters filters = QDir::AllDirs | QDir:: Files | QDir::NoDotAndDotDot;
-    QDirIterator it(cacheDirectory(), filters, QDirIterator::Subdirectories);
-
-    QMultiMap<QDateTime, QString> cacheItems;
-    qint64 totalSize = 0;
-    while (it.hasNext()) {
-        QFileInfo info = it.nextFileInfo();
-        QString path = info.filePath();
-        QString fileName = info.fileName();
-        if (fileName.endsWith(CACHE_POSTFIX)) {
-            const QDateTime birthTime = info.fileTime(QFile::FileBirthTime);
-            cacheItems.insert(birthTime.isValid() ? birthTime
-                              : info.fileTime(QFile::FileMetadataChangeTime), path);
-            totalSize += info.size();
-        }
-    }
+    d->loadIndex();
 
     [[maybe_unused]] int removedFiles = 0; // used under QNETWORKDISKCACHE_DEBUG
-    qint64 goal = (maximumCacheSize() * 9) / 10;
-    QMultiMap<QDateTime, QString>::const_iterator i = cacheItems.constBegin();
-    while (i != cacheItems.constEnd()) {
-        if (totalSize < goal)
-            break;
-        QString name = i.value();
-        QFile file(name);
-
-        if (name.contains(PREPARED_SLASH)) {
-            for (QCacheItem *item : qAsConst(d->inserting)) {
-                if (item && item->file && item->file->fileName() == name) {
-                    delete item->file;
-                    item->file = nullptr;
-                    break;
-                }
-            }
-        }
-
-        qint64 size = file.size();
-        file.remove();
-        totalSize -= size;
+    const qint64 goal = maximumCacheSize();
+    while (d->indexedSize >= goal && !d->lruOrder.isEmpty()) {
+        const QString key = d->lruOrder.first();
+        QFile::remove(d->cacheDirectory + key);
+        d->unindexFile(key);
         ++removedFiles;
-        ++i;
     }
 #if defined(QNETWORKDISKCACHE_DEBUG)
     if (removedFiles > 0) {
         qDebug() << "QNetworkDiskCache::expire()"
                 << "Removed:" << removedFiles
-                << "Kept:" << cacheItems.count() - removedFiles;
+                << "Kept:" << d->index.size();
     }
 #endif
-    return totalSize;
+    return d->indexedSize;
 }
 
 /*!
@@ -544,6 +548,12 @@ void QNetworkDiskCache::clear()
     qDebug("QNetworkDiskCache::clear()");
 #endif
     Q_D(QNetworkDiskCache);
+    // Rebuild the index from what's actually on disk, so that
+    // we don't miss any files the index lost track of:
+    if (!d->cacheDirectory.isEmpty()) {
+        d->resetIndex();
+        QFile::remove(d->indexFileName());
+    }
     qint64 size = d->maximumCacheSize;
     d->maximumCacheSize = 0;
     d->currentCacheSize = expire();
@@ -562,9 +572,10 @@ QString QNetworkDiskCachePrivate::uniqueFileName(const QUrl &url)
     const QByteArray hash = QCryptographicHash::hash(cleanUrl.toEncoded(), QCryptographicHash::Sha1);
     // convert sha1 to base36 form and return first 8 bytes for use as string
     const QByteArray id = QByteArray::number(*(qlonglong*)hash.data(), 36).left(8);
-    // generates <one-char subdir>/<8-char filename.d>
-    uint code = (uint)id.at(id.length()-1) % 16;
-    QString pathFragment = QString::number(code, 16) + u'/' + QLatin1StringView(id) + CACHE_POSTFIX;
+    // generates <two-char subdir>/<8-char filename.d>
+    uint code = uchar(hash.at(hash.size() - 1)) % NUM_SUBDIRECTORIES;
+    QString pathFragment = QString::number(code, 16).rightJustified(2, u'0') + u'/'
+                           + QLatin1StringView(id) + CACHE_POSTFIX;
 
     return pathFragment;
 }
@@ -622,9 +633,20 @@ bool QCacheItem::canCompress() const
 enum
 {
     CacheMagic = 0xe8,
+    IndexMagic = 0xe9,
     CurrentCacheVersion = CACHE_VERSION
 };
 
+enum IndexRecord : quint8
+{
+    IndexUpdate = 1,
+    IndexRemove = 2
+};
+
+// Larger than any record we write: the type, a file name relative to the
+// cache directory and the entry
+static constexpr qint64 MaxIndexRecordSize = 1 + 4 + 1024 + 16;
+
 void QCacheItem::writeHeader(QFile *device) const
 {
     QDataStream out(device);
@@ -690,6 +712,438 @@ bool QCacheItem::read(QFile *device, bool readData)
     return metaData.isValid();
 }
 
+/*
+    The index maps each cache file (by its name relative to the cache
+    directory) to its size and the time it was last used, and keeps the
+    files in least recently used order, so that expire() can remove them
+    one by one as new ones come in.
+
+    It is stored as a journal: a header followed by records, each either
+    updating a file's entry or removing it, appended as the cache changes.
+    Once there are many more records than files, the journal is rewritten
+    with one record per file. If there is no usable journal, the index is
+    rebuilt by scanning the cache directory.
+
+    Several caches can share a directory, for instance one per thread.
+    Each record goes to the journal in a single write, so records don't
+    interleave, and each cache reads what the others appended before it
+    expires files and before it rewrites the journal; misses are answered
+    from the index, which is brought up to date at most once a second for
+    them. The header carries a generation that changes with every rewrite,
+    so that the others notice and read the new journal instead. A cache
+    checks the generation after appending a record, and the rewriter
+    reads what was appended to the journal it replaced after committing
+    the new one, so no record gets lost in the replaced file.
+*/
+
+QString QNetworkDiskCachePrivate::indexFileName() const
+{
+    return dataDirectory + INDEX_FILE;
+}
+
+QString QNetworkDiskCachePrivate::indexKey(const QString &file) const
+{
+    if (!file.startsWith(cacheDirectory))
+        return QString();
+    return file.sliced(cacheDirectory.size());
+}
+
+void QNetworkDiskCachePrivate::loadIndex()
+{
+    if (indexLoaded || cacheDirectory.isEmpty())
+        return;
+    indexLoaded = true;
+
+    removeStalePreparedFiles();
+
+    QFile file(indexFileName());
+    qint64 validLength = 0;
+    journalRecords = 0;
+    if (file.open(QFile::ReadOnly) && readIndexHeader(&file, &generation)
+            && readIndex(&file, &validLength)) {
+        const bool truncated = file.size() > validLength;
+        file.close();
+        journalReadPos = validLength;
+        openJournal();
+        // Records appended after one we didn't get to write completely
+        // would be lost, so rewrite the journal without it:
+        if (truncated)
+            writeIndex();
+        else
+            compactJournalIfNeeded();
+    } else {
+        file.close();
+        index.clear();
+        lruOrder.clear();
+        indexedSize = 0;
+        generation = 0;
+        scanCacheDirectory();
+        writeIndex();
+    }
+    currentCacheSize = indexedSize;
+}
+
+bool QNetworkDiskCachePrivate::readIndexHeader(QFile *file, quint64 *fileGeneration)
+{
+    QDataStream in(file);
+    in.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic;
+    qint32 version;
+    in >> magic >> version >> *fileGeneration;
+    return in.status() == QDataStream::Ok && magic == IndexMagic
+           && version == CurrentCacheVersion && *fileGeneration != 0;
+}
+
+/*
+    Reads the records from the current position of \a file to its end,
+    and sets \a validLength to the end of the last one it could read.
+
+    Returns false if a record is corrupt, as the ones after it are lost
+    and the cache directory has to be scanned. A last record that is cut
+    short, because its cache crashed while writing it or is still writing
+    it, is not an error. If \a changedKeys is set, the keys of the records
+    read are appended to it.
+*/
+bool QNetworkDiskCachePrivate::readIndex(QFile *file, qint64 *validLength,
+                                         QList<QString> *changedKeys)
+{
+    QDataStream in(file);
+    in.setVersion(QDataStream::Qt_6_0);
+
+    *validLength = file->pos();
+    while (!in.atEnd()) {
+        quint8 type;
+        QByteArray name;
+        IndexEntry entry = {};
+        in >> type >> name;
+        if (type == IndexUpdate)
+            in >> entry.size >> entry.lastAccess;
+        if (in.status() == QDataStream::ReadPastEnd)
+            return file->size() - *validLength < MaxIndexRecordSize;
+        if (in.status() != QDataStream::Ok || name.isEmpty() || entry.size < 0)
+            return false;
+
+        const QString key = QString::fromUtf8(name);
+        if (type == IndexUpdate)
+            addToIndex(key, entry);
+        else if (type == IndexRemove)
+            removeFromIndex(key);
+        else
+            return false;
+        if (changedKeys)
+            changedKeys->append(key);
+        ++journalRecords;
+        *validLength = file->pos();
+    }
+    return true;
+}
+
+/*
+    Reads the records that other caches sharing the directory appended
+    to the journal since we last read it.
+
+    If one of them rewrote the journal, it did so with what it knew at the
+    time: records we appended since went to the file it replaced. So we
+    read the new journal from the start and put back the files we knew
+    about that are still there.
+*/
+void QNetworkDiskCachePrivate::syncIndex()
+{
+    if (!indexLoaded) {
+        loadIndex();
+        return;
+    }
+
+    QFile file(indexFileName());
+    quint64 fileGeneration = 0;
+    if (!file.open(QFile::ReadOnly) || !readIndexHeader(&file, &fileGeneration)) {
+        // Removed by clear(), or damaged
+        resetIndex();
+        loadIndex();
+        return;
+    }
+
+    QHash<QString, IndexEntry> known;
+    if (fileGeneration != generation) {
+        known = std::exchange(index, {});
+        lruOrder.clear();
+        indexedSize = 0;
+        journalRecords = 0;
+        generation = fileGeneration;
+        openJournal();
+    } else if (file.size() <= journalReadPos || !file.seek(journalReadPos)) {
+        return;
+    }
+
+    qint64 validLength = 0;
+    if (!readIndex(&file, &validLength)) {
+        resetIndex();
+        loadIndex();
+        return;
+    }
+    journalReadPos = validLength;
+    appendedRecords = 0;
+
+    for (auto it = known.cbegin(), end = known.cend(); it != end; ++it) {
+        if (!index.contains(it.key()) && QFileInfo::exists(cacheDirectory + it.key())) {
+            addToIndex(it.key(), it.value());
+            appendToJournal(it.key(), &it.value());
+        }
+    }
+    currentCacheSize = indexedSize;
+}
+
+void QNetworkDiskCachePrivate::scanCacheDirectory()
+{
+    const QString preparedDirectory = cacheDirectory + PREPARED_SLASH;
+    QDirIterator it(cacheDirectory, QDir::Files | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        const QFileInfo info = it.nextFileInfo();
+        const QString path = info.filePath();
+        if (!path.endsWith(CACHE_POSTFIX) || path.startsWith(preparedDirectory))
+            continue;
+        const QDateTime birthTime = info.fileTime(QFile::FileBirthTime);
+        const QDateTime time = birthTime.isValid() ? birthTime
+                               : info.fileTime(QFile::FileMetadataChangeTime);
+        addToIndex(indexKey(path), { info.size(), time.toMSecsSinceEpoch() });
+    }
+}
+
+/*
+    Removes what's left in the prepared directory from insertions that
+    never finished, typically because the application was terminated.
+    Files written to recently may belong to another cache sharing the
+    directory, so they are left alone.
+*/
+void QNetworkDiskCachePrivate::removeStalePreparedFiles()
+{
+    const QDateTime staleBefore = QDateTime::currentDateTimeUtc().addDays(-1);
+    QDirIterator it(cacheDirectory + PREPARED_SLASH, QDir::Files | QDir::NoDotAndDotDot);
+    while (it.hasNext()) {
+        const QFileInfo info = it.nextFileInfo();
+        if (!info.fileName().endsWith(CACHE_POSTFIX) || info.lastModified() >= staleBefore)
+            continue;
+        const QString path = info.filePath();
+        const bool inUse = std::any_of(inserting.cbegin(), inserting.cend(), [&path](QCacheItem *item) {
+            return item && item->file && item->file->fileName() == path;
+        });
+        if (!inUse)
+            QFile::remove(path);
+    }
+}
+
+void QNetworkDiskCachePrivate::writeIndex()
+{
+    // Don't drop what other caches sharing the directory have added:
+    if (generation != 0)
+        syncIndex();
+
+    // Others may append to the journal we replace until they notice; keep
+    // it open to pick up what they append before that, see appendToJournal()
+    QFile previous(indexFileName());
+    quint64 previousGeneration = 0;
+    const bool drainPrevious = generation != 0 && previous.open(QFile::ReadOnly)
+            && readIndexHeader(&previous, &previousGeneration) && previousGeneration == generation;
+    const qint64 previousReadPos = journalReadPos;
+
+    QSaveFile file(indexFileName());
+    if (file.open(QFile::WriteOnly)) {
+        const quint64 newGeneration = QRandomGenerator::global()->generate64() | 1;
+        QDataStream out(&file);
+        out.setVersion(QDataStream::Qt_6_0);
+        out << quint32(IndexMagic) << qint32(CurrentCacheVersion) << newGeneration;
+        for (const QString &key : std::as_const(lruOrder)) {
+            const IndexEntry entry = index.value(key);
+            out << quint8(IndexUpdate) << key.toUtf8() << entry.size << entry.lastAccess;
+        }
+        const qint64 length = file.pos();
+        if (file.commit()) {
+            generation = newGeneration;
+            journalReadPos = length;
+            journalRecords = index.size();
+            appendedRecords = 0;
+        } else {
+            openJournal();
+            return;
+        }
+    }
+    openJournal();
+
+    QList<QString> changedKeys;
+    qint64 validLength = 0;
+    if (drainPrevious && previous.size() > previousReadPos && previous.seek(previousReadPos)
+            && readIndex(&previous, &validLength, &changedKeys)) {
+        for (const QString &key : std::as_const(changedKeys)) {
+            const auto it = index.constFind(key);
+            appendToJournal(key, it != index.cend() ? &*it : nullptr);
+        }
+    }
+}
+
+void QNetworkDiskCachePrivate::openJournal()
+{
+    journal.close();
+    journal.setFileName(indexFileName());
+    // Unbuffered, so that each record is written in one go; see appendToJournal()
+    journal.open(QFile::WriteOnly | QFile::Append | QFile::Unbuffered | QFile::ExistingOnly);
+}
+
+void QNetworkDiskCachePrivate::resetIndex()
+{
+    journal.close();
+    index.clear();
+    lruOrder.clear();
+    indexedSize = 0;
+    generation = 0;
+    journalReadPos = 0;
+    journalRecords = 0;
+    appendedRecords = 0;
+    indexLoaded = false;
+    currentCacheSize = -1;
+}
+
+bool QNetworkDiskCachePrivate::isIndexed(const QString &file)
+{
+    loadIndex();
+    const QString key = indexKey(file);
+    if (key.isEmpty())
+        return false;
+    if (index.contains(key))
+        return true;
+
+    // Another cache sharing the directory may have stored the file since
+    // we last read the journal. Look, but not on every miss: at worst, the
+    // file is fetched and stored again.
+    if (!missSyncTimer.hasExpired())
+        return false;
+    syncIndex();
+    missSyncTimer.setRemainingTime(MissSyncInterval);
+    return index.contains(key);
+}
+
+void QNetworkDiskCachePrivate::indexFile(const QString &key, qint64 size)
+{
+    loadIndex();
+    if (key.isEmpty())
+        return;
+    const IndexEntry entry = { size, nextAccessStamp() };
+    addToIndex(key, entry);
+    appendToJournal(key, &entry);
+    compactJournalIfNeeded();
+}
+
+void QNetworkDiskCachePrivate::touchFile(const QString &file)
+{
+    loadIndex();
+    const auto it = index.find(indexKey(file));
+    if (it == index.end())
+        return;
+    lruOrder.remove(it->lastAccess);
+    it->lastAccess = nextAccessStamp();
+    lruOrder.insert(it->lastAccess, it.key());
+    appendToJournal(it.key(), &*it);
+    compactJournalIfNeeded();
+}
+
+void QNetworkDiskCachePrivate::unindexFile(const QString &key)
+{
+    loadIndex();
+    if (!removeFromIndex(key))
+        return;
+    appendToJournal(key, nullptr);
+    compactJournalIfNeeded();
+}
+
+void QNetworkDiskCachePrivate::addToIndex(const QString &key, IndexEntry entry)
+{
+    const auto it = index.find(key);
+    if (it != index.end()) {
+        lruOrder.remove(it->lastAccess);
+        indexedSize -= it->size;
+    }
+    while (lruOrder.contains(entry.lastAccess))
+        ++entry.lastAccess;
+    lastAccessStamp = qMax(lastAccessStamp, entry.lastAccess);
+    index.insert(key, entry);
+    lruOrder.insert(entry.lastAccess, key);
+    indexedSize += entry.size;
+}
+
+bool QNetworkDiskCachePrivate::removeFromIndex(const QString &key)
+{
+    const auto it = index.find(key);
+    if (it == index.end())
+        return false;
+    lruOrder.remove(it->lastAccess);
+    indexedSize -= it->size;
+    index.erase(it);
+    return true;
+}
+
+void QNetworkDiskCachePrivate::appendToJournal(const QString &key, const IndexEntry *entry)
+{
+    // The journal is opened in append mode and unbuffered: a record
+    // written in one go ends up in one piece at the end of the file, even
+    // if other caches sharing the directory append at the same time.
+    if (!journal.isOpen())
+        return;
+    // entry may point into the index, which syncIndex() rebuilds
+    const std::optional<IndexEntry> value = entry ? std::optional(*entry) : std::nullopt;
+    QByteArray record;
+    QDataStream out(&record, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_6_0);
+    if (value)
+        out << quint8(IndexUpdate) << key.toUtf8() << value->size << value->lastAccess;
+    else
+        out << quint8(IndexRemove) << key.toUtf8();
+
+    // If another cache replaced the journal after the rewriter read the old
+    // one for the last time, the record went nowhere: read the new journal
+    // and try again. Either the check sees the new journal, or the record
+    // got there before the rewriter read the old one for the last time.
+    for (int attempt = 0; attempt < 3 && journal.isOpen(); ++attempt) {
+        if (journal.write(record) != record.size())
+            return;
+        ++appendedRecords;
+        if (!journalReplaced())
+            return;
+        syncIndex();
+        if (value)
+            addToIndex(key, *value);
+        else
+            removeFromIndex(key);
+    }
+}
+
+/*
+    Returns true if the journal we append to is no longer the one in the
+    cache directory, because another cache sharing it rewrote it.
+*/
+bool QNetworkDiskCachePrivate::journalReplaced()
+{
+    QFile file(indexFileName());
+    quint64 fileGeneration = 0;
+    return !file.open(QFile::ReadOnly) || !readIndexHeader(&file, &fileGeneration)
+           || fileGeneration != generation;
+}
+
+void QNetworkDiskCachePrivate::compactJournalIfNeeded()
+{
+    if (journalRecords + appendedRecords > 2 * index.size() + 1024)
+        writeIndex();
+}
+
+/*
+    Access times are in milliseconds since the epoch, but unique and
+    increasing even if the clock goes backwards.
+*/
+qint64 QNetworkDiskCachePrivate::nextAccessStamp()
+{
+    lastAccessStamp = qMax(QDateTime::currentMSecsSinceEpoch(), lastAccessStamp + 1);
+    return lastAccessStamp;
+}
+
 QT_END_NAMESPACE
 
 #include "moc_qnetworkdiskcache.cpp"
@@ -19,7 +19,10 @@
 #include "private/qabstractnetworkcache_p.h"
 
 #include <qbuffer.h>
+#include <qdeadlinetimer.h>
+#include <qfile.h>
 #include <qhash.h>
+#include <qmap.h>
 #include <qtemporaryfile.h>
 
 QT_REQUIRE_CONFIG(networkdiskcache);
@@ -75,12 +78,60 @@ public:
     void prepareLayout();
     static quint32 crc32(const char *data, uint len);
 
+    // The index of the cache files, see loadIndex()
+    struct IndexEntry
+    {
+        qint64 size;
+        qint64 lastAccess;
+    };
+
+    QString indexFileName() const;
+    QString indexKey(const QString &file) const;
+    void loadIndex();
+    bool readIndexHeader(QFile *file, quint64 *fileGeneration);
+    bool readIndex(QFile *file, qint64 *validLength, QList<QString> *changedKeys = nullptr);
+    void syncIndex();
+    void scanCacheDirectory();
+    void removeStalePreparedFiles();
+    void writeIndex();
+    void openJournal();
+    void resetIndex();
+    bool isIndexed(const QString &file);
+    void indexFile(const QString &key, qint64 size);
+    void touchFile(const QString &file);
+    void unindexFile(const QString &key);
+    void addToIndex(const QString &key, IndexEntry entry);
+    bool removeFromIndex(const QString &key);
+    void appendToJournal(const QString &key, const IndexEntry *entry);
+    bool journalReplaced();
+    void compactJournalIfNeeded();
+    qint64 nextAccessStamp();
+
     mutable QCacheItem lastItem;
     QString cacheDirectory;
     QString dataDirectory;
     qint64 maximumCacheSize;
     qint64 currentCacheSize;
 
+    // Keyed by the file name relative to cacheDirectory:
+    QHash<QString, IndexEntry> index;
+    // Last access -> key, least recently used first. Access times are unique.
+    QMap<qint64, QString> lruOrder;
+    qint64 indexedSize = 0;
+    qint64 lastAccessStamp = 0;
+    bool indexLoaded = false;
+    QFile journal;
+    // Changes whenever the journal is rewritten, see syncIndex():
+    quint64 generation = 0;
+    // How far we've read the journal, and the records up to there:
+    qint64 journalReadPos = 0;
+    qint64 journalRecords = 0;
+    // Records we appended since, which we'll read again:
+    qint64 appendedRecords = 0;
+    // When to read the journal again for a miss, see isIndexed():
+    static constexpr std::chrono::seconds MissSyncInterval{1};
+    QDeadlineTimer missSyncTimer;
+
     QHash<QIODevice*, QCacheItem*> inserting;
     Q_DECLARE_PUBLIC(QNetworkDiskCache)
 };
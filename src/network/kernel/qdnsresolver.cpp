@@ -0,0 +1,758 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qdnsresolver_p.h"
+
+#include <qcoreapplication.h>
+#include <qdatetime.h>
+#include <qdeadlinetimer.h>
+#include <qendian.h>
+#include <qfile.h>
+#include <qfileinfo.h>
+#include <qmutex.h>
+#include <qnetworkdatagram.h>
+#include <qrandom.h>
+#include <qtcpsocket.h>
+#include <qthreadstorage.h>
+#include <qudpsocket.h>
+#include <qurl.h>
+
+#include <algorithm>
+#include <climits>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+namespace {
+
+enum : quint16 {
+    TypeA = 1,
+    TypeCNAME = 5,
+    TypeSOA = 6,
+    TypeAAAA = 28,
+    ClassIN = 1
+};
+
+enum : quint8 {
+    NoErrorCode = 0,
+    NameErrorCode = 3
+};
+
+constexpr int MaximumCnameChain = 16;
+constexpr int ConfigurationCheckInterval = 5000; // milliseconds
+
+void appendUInt16(QByteArray &data, quint16 value)
+{
+    data.append(char(value >> 8)).append(char(value));
+}
+
+// Returns an empty array if name can't be sent in a query
+QByteArray encodeName(QByteArrayView name)
+{
+    QByteArray encoded;
+    if (name.isEmpty() || name.size() > 253)
+        return encoded;
+    encoded.reserve(name.size() + 2);
+    qsizetype start = 0;
+    while (start <= name.size()) {
+        qsizetype end = name.indexOf('.', start);
+        if (end < 0)
+            end = name.size();
+        const qsizetype length = end - start;
+        if (length < 1 || length > 63)
+            return QByteArray();
+        encoded.append(char(length)).append(name.sliced(start, length));
+        start = end + 1;
+    }
+    encoded.append('\0');
+    return encoded;
+}
+
+QByteArray makeQuery(quint16 id, QByteArrayView encodedName, quint16 type)
+{
+    QByteArray query;
+    query.reserve(12 + encodedName.size() + 4);
+    appendUInt16(query, id);
+    appendUInt16(query, 0x0100); // standard query, recursion desired
+    appendUInt16(query, 1); // one question
+    appendUInt16(query, 0);
+    appendUInt16(query, 0);
+    appendUInt16(query, 0);
+    query.append(encodedName);
+    appendUInt16(query, type);
+    appendUInt16(query, ClassIN);
+    return query;
+}
+
+class PacketReader
+{
+public:
+    explicit PacketReader(QByteArrayView data, qsizetype position = 0)
+        : data(data), pos(position)
+    {}
+
+    bool isValid() const { return valid; }
+    qsizetype position() const { return pos; }
+
+    quint8 readUInt8()
+    {
+        if (!ensure(1))
+            return 0;
+        return quint8(data[pos++]);
+    }
+
+    quint16 readUInt16()
+    {
+        const quint8 high = readUInt8();
+        return quint16(high << 8 | readUInt8());
+    }
+
+    quint32 readUInt32()
+    {
+        const quint16 high = readUInt16();
+        return quint32(high) << 16 | readUInt16();
+    }
+
+    void skip(qsizetype length)
+    {
+        if (ensure(length))
+            pos += length;
+    }
+
+    // Reads a (possibly compressed) name, in lower case and without the trailing dot
+    QByteArray readName()
+    {
+        QByteArray name;
+        qsizetype p = pos;
+        bool jumped = false;
+        int jumps = 0;
+        while (valid) {
+            if (p >= data.size())
+                break;
+            const quint8 length = quint8(data[p]);
+            if ((length & 0xc0) == 0xc0) {
+                if (p + 1 >= data.size() || ++jumps > 64)
+                    break;
+                if (!jumped)
+                    pos = p + 2;
+                jumped = true;
+                p = qsizetype(length & 0x3f) << 8 | quint8(data[p + 1]);
+                continue;
+            }
+            if (length & 0xc0)
+                break;
+            ++p;
+            if (!length) {
+                if (!jumped)
+                    pos = p;
+                return name.toLower();
+            }
+            if (p + length > data.size() || name.size() + length + 1 > 255)
+                break;
+            if (!name.isEmpty())
+                name += '.';
+            name.append(data.sliced(p, length));
+            p += length;
+        }
+        valid = false;
+        return QByteArray();
+    }
+
+private:
+    bool ensure(qsizetype length)
+    {
+        if (pos + length > data.size())
+            valid = false;
+        return valid;
+    }
+
+    QByteArrayView data;
+    qsizetype pos = 0;
+    bool valid = true;
+};
+
+int ttlFromWire(quint32 ttl)
+{
+    // RFC 2181, 8: a TTL with the most significant bit set means zero
+    return ttl > quint32(INT_MAX) ? 0 : int(ttl);
+}
+
+struct Response
+{
+    quint16 id = 0;
+    bool truncated = false;
+    quint8 responseCode = 0;
+    QList<QHostAddress> addresses;
+    int ttl = -1;         // of the addresses, and the CNAMEs that led to them
+    int negativeTtl = -1; // from the SOA record in the authority section (RFC 2308)
+};
+
+// Returns false if data is not a response to the question for name and type
+bool parseResponse(QByteArrayView data, const QByteArray &name, quint16 type, Response *response)
+{
+    PacketReader reader(data);
+    response->id = reader.readUInt16();
+    const quint16 flags = reader.readUInt16();
+    const quint16 questions = reader.readUInt16();
+    const quint16 answers = reader.readUInt16();
+    const quint16 authorities = reader.readUInt16();
+    reader.readUInt16(); // additional records
+    if (!reader.isValid() || !(flags & 0x8000) || questions != 1)
+        return false;
+    response->truncated = flags & 0x0200;
+    response->responseCode = flags & 0x000f;
+
+    if (reader.readName() != name || reader.readUInt16() != type || reader.readUInt16() != ClassIN
+        || !reader.isValid()) {
+        return false;
+    }
+    if (response->truncated)
+        return true; // we ask again over TCP and don't care about the rest
+
+    QHash<QByteArray, std::pair<QByteArray, int>> aliases;
+    QList<std::pair<QByteArray, QHostAddress>> addressRecords;
+    QHash<QByteArray, int> addressTtls;
+    for (int i = 0; i < answers + authorities; ++i) {
+        const QByteArray owner = reader.readName();
+        const quint16 recordType = reader.readUInt16();
+        const quint16 recordClass = reader.readUInt16();
+        const int ttl = ttlFromWire(reader.readUInt32());
+        const quint16 length = reader.readUInt16();
+        const qsizetype start = reader.position();
+        reader.skip(length);
+        if (!reader.isValid())
+            return false;
+        if (recordClass != ClassIN)
+            continue;
+
+        if (i < answers) {
+            if (recordType == TypeCNAME) {
+                PacketReader target(data, start);
+                aliases.insert(owner, { target.readName(), ttl });
+            } else if (recordType == type && recordType == TypeA && length == 4) {
+                addressRecords.append({ owner, QHostAddress(qFromBigEndian<quint32>(data.data() + start)) });
+            } else if (recordType == type && recordType == TypeAAAA && length == 16) {
+                addressRecords.append({ owner, QHostAddress(reinterpret_cast<const quint8 *>(data.data() + start)) });
+            } else {
+                continue;
+            }
+            if (recordType == type) {
+                const auto it = addressTtls.find(owner);
+                addressTtls.insert(owner, it == addressTtls.end() ? ttl : qMin(*it, ttl));
+            }
+        } else if (recordType == TypeSOA) {
+            PacketReader soa(data, start);
+            soa.readName(); // primary name server
+            soa.readName(); // responsible mailbox
+            soa.skip(16); // serial, refresh, retry and expire
+            const int minimum = ttlFromWire(soa.readUInt32());
+            if (soa.isValid())
+                response->negativeTtl = qMin(ttl, minimum);
+        }
+    }
+
+    // Follow the CNAME chain from the name we asked for
+    QByteArray target = name;
+    int ttl = INT_MAX;
+    for (int i = 0; i < MaximumCnameChain; ++i) {
+        const auto alias = aliases.constFind(target);
+        if (alias == aliases.cend())
+            break;
+        target = alias->first;
+        ttl = qMin(ttl, alias->second);
+    }
+    for (const auto &record : std::as_const(addressRecords)) {
+        if (record.first == target)
+            response->addresses.append(record.second);
+    }
+    if (!response->addresses.isEmpty())
+        response->ttl = qMin(ttl, addressTtls.value(target));
+    return true;
+}
+
+// RFC 8305, 4: interleave the address families, starting with IPv6
+QList<QHostAddress> interleaveAddresses(const QList<QHostAddress> &ipv6, const QList<QHostAddress> &ipv4)
+{
+    QList<QHostAddress> addresses;
+    addresses.reserve(ipv6.size() + ipv4.size());
+    for (qsizetype i = 0; i < qMax(ipv6.size(), ipv4.size()); ++i) {
+        if (i < ipv6.size())
+            addresses.append(ipv6.at(i));
+        if (i < ipv4.size())
+            addresses.append(ipv4.at(i));
+    }
+    return addresses;
+}
+
+struct ConfigurationHolder
+{
+    QMutex mutex;
+    std::shared_ptr<const QDnsResolverConfiguration> configuration;
+    bool overridden = false;
+    QDeadlineTimer nextCheck;
+    QDateTime resolvConfModified;
+    QDateTime hostsModified;
+};
+
+Q_GLOBAL_STATIC(ConfigurationHolder, configurationHolder)
+
+#ifdef Q_OS_UNIX
+constexpr auto ResolvConfPath = "/etc/resolv.conf"_L1;
+constexpr auto HostsPath = "/etc/hosts"_L1;
+#endif
+
+} // unnamed namespace
+
+/*
+    Parses resolv.conf(5) contents the way the GNU C library does: up to
+    three name servers, the last "search" or "domain" line, and the
+    "ndots", "timeout" and "attempts" options.
+*/
+void QDnsResolverConfiguration::parseResolvConf(QByteArrayView contents)
+{
+    for (QByteArray line : contents.toByteArray().split('\n')) {
+        const qsizetype comment = line.indexOf('#');
+        if (comment >= 0)
+            line.truncate(comment);
+        const qsizetype otherComment = line.indexOf(';');
+        if (otherComment >= 0)
+            line.truncate(otherComment);
+        const QList<QByteArray> fields = line.simplified().split(' ');
+        if (fields.size() < 2)
+            continue;
+
+        const QByteArray &keyword = fields.first();
+        if (keyword == "nameserver") {
+            QHostAddress address;
+            if (nameServers.size() < 3 && address.setAddress(QString::fromLatin1(fields.at(1))))
+                nameServers.append({ address, 53 });
+        } else if (keyword == "search" || keyword == "domain") {
+            searchDomains.clear();
+            for (qsizetype i = 1; i < fields.size(); ++i)
+                searchDomains.append(fields.at(i).toLower());
+        } else if (keyword == "options") {
+            for (qsizetype i = 1; i < fields.size(); ++i) {
+                const QByteArray &option = fields.at(i);
+                const qsizetype colon = option.indexOf(':');
+                if (colon < 0)
+                    continue;
+                bool ok = false;
+                const int value = option.mid(colon + 1).toInt(&ok);
+                if (!ok || value < 0)
+                    continue;
+                const QByteArrayView name = QByteArrayView(option).first(colon);
+                if (name == "ndots")
+                    ndots = qMin(value, 15);
+                else if (name == "timeout")
+                    timeout = qBound(1, value, 30) * 1000;
+                else if (name == "attempts")
+                    attempts = qBound(1, value, 5);
+            }
+        }
+    }
+}
+
+void QDnsResolverConfiguration::parseHosts(QByteArrayView contents)
+{
+    for (QByteArray line : contents.toByteArray().split('\n')) {
+        const qsizetype comment = line.indexOf('#');
+        if (comment >= 0)
+            line.truncate(comment);
+        const QList<QByteArray> fields = line.simplified().split(' ');
+        QHostAddress address;
+        if (fields.size() < 2 || !address.setAddress(QString::fromLatin1(fields.first())))
+            continue;
+        for (qsizetype i = 1; i < fields.size(); ++i)
+            hosts[fields.at(i).toLower()].append(address);
+    }
+}
+
+QDnsResolverConfiguration QDnsResolverConfiguration::fromSystem()
+{
+    QDnsResolverConfiguration configuration;
+#ifdef Q_OS_UNIX
+    QFile resolvConf(ResolvConfPath);
+    if (!resolvConf.open(QFile::ReadOnly))
+        return configuration; // leave it to the system's resolver
+    configuration.parseResolvConf(resolvConf.readAll());
+    if (configuration.nameServers.isEmpty())
+        configuration.nameServers.append({ QHostAddress(QHostAddress::LocalHost), 53 });
+
+    QFile hosts(HostsPath);
+    if (hosts.open(QFile::ReadOnly))
+        configuration.parseHosts(hosts.readAll());
+#endif
+    return configuration;
+}
+
+QDnsResolver::QDnsResolver(QObject *parent)
+    : QObject(parent)
+{
+}
+
+QDnsResolver::~QDnsResolver()
+{
+    for (const auto &lookup : lookups) {
+        for (Query &query : lookup.second->queries)
+            stopQuery(&query);
+    }
+}
+
+QDnsResolver *QDnsResolver::forCurrentThread()
+{
+    static QThreadStorage<QDnsResolver *> resolvers;
+    if (!resolvers.hasLocalData())
+        resolvers.setLocalData(new QDnsResolver);
+    return resolvers.localData();
+}
+
+/*
+    Returns the configuration, as read from the system's files unless
+    replaced with setConfiguration(). The files are read again when they
+    change, checking every few seconds.
+*/
+std::shared_ptr<const QDnsResolverConfiguration> QDnsResolver::configuration()
+{
+    ConfigurationHolder *holder = configurationHolder();
+    QMutexLocker locker(&holder->mutex);
+    if (holder->overridden || !holder->nextCheck.hasExpired())
+        return holder->configuration;
+
+    holder->nextCheck.setRemainingTime(ConfigurationCheckInterval);
+#ifdef Q_OS_UNIX
+    const QDateTime resolvConfModified = QFileInfo(ResolvConfPath).lastModified();
+    const QDateTime hostsModified = QFileInfo(HostsPath).lastModified();
+    if (holder->configuration && resolvConfModified == holder->resolvConfModified
+        && hostsModified == holder->hostsModified) {
+        return holder->configuration;
+    }
+    holder->resolvConfModified = resolvConfModified;
+    holder->hostsModified = hostsModified;
+#endif
+    holder->configuration = std::make_shared<QDnsResolverConfiguration>(
+            QDnsResolverConfiguration::fromSystem());
+    return holder->configuration;
+}
+
+void QDnsResolver::setConfiguration(std::shared_ptr<const QDnsResolverConfiguration> configuration)
+{
+    ConfigurationHolder *holder = configurationHolder();
+    QMutexLocker locker(&holder->mutex);
+    holder->overridden = bool(configuration);
+    holder->configuration = std::move(configuration);
+    holder->nextCheck = QDeadlineTimer(); // check the system's files on next use
+}
+
+void QDnsResolver::lookup(const QString &hostName, Callback callback)
+{
+    const auto pending = lookups.find(hostName);
+    if (pending != lookups.end()) {
+        pending->second->callbacks.push_back(std::move(callback));
+        return;
+    }
+
+    QHostInfo info;
+    info.setHostName(hostName);
+
+    // IDN support
+    QByteArray name = QUrl::toAce(hostName).toLower();
+    const bool absolute = name.endsWith('.');
+    if (absolute)
+        name.chop(1);
+    if (name.isEmpty()) {
+        info.setError(QHostInfo::HostNotFound);
+        info.setErrorString(QCoreApplication::translate("QHostInfoAgent", "Invalid hostname"));
+        callback(info, -1);
+        return;
+    }
+
+    auto lookup = std::make_unique<Lookup>();
+    lookup->configuration = configuration();
+    const QDnsResolverConfiguration &configuration = *lookup->configuration;
+
+    const auto host = configuration.hosts.constFind(name);
+    if (host != configuration.hosts.cend()) {
+        info.setAddresses(*host);
+        callback(info, -1);
+        return;
+    }
+
+    // Names with at least ndots dots are tried as they are first, others last
+    QList<QByteArray> candidates;
+    if (!absolute) {
+        for (const QByteArray &domain : configuration.searchDomains)
+            candidates.append(name + '.' + domain);
+    }
+    if (absolute || name.count('.') >= configuration.ndots)
+        candidates.prepend(name);
+    else
+        candidates.append(name);
+    for (const QByteArray &candidate : std::as_const(candidates)) {
+        if (!encodeName(candidate).isEmpty())
+            lookup->candidates.append(candidate);
+    }
+    if (lookup->candidates.isEmpty()) {
+        info.setError(QHostInfo::HostNotFound);
+        info.setErrorString(QCoreApplication::translate("QHostInfoAgent", "Invalid hostname"));
+        callback(info, -1);
+        return;
+    }
+
+    lookup->hostName = hostName;
+    lookup->callbacks.push_back(std::move(callback));
+    lookup->queries[0].type = TypeAAAA;
+    lookup->queries[1].type = TypeA;
+    Lookup *started = lookup.get();
+    lookups.emplace(hostName, std::move(lookup));
+    startCandidate(started);
+}
+
+void QDnsResolver::startCandidate(Lookup *lookup)
+{
+    for (Query &query : lookup->queries) {
+        query.lookup = lookup;
+        query.tries = 0;
+        query.state = Query::Pending;
+        query.addresses.clear();
+        query.ttl = -1;
+    }
+    for (Query &query : lookup->queries) {
+        if (query.state == Query::Pending)
+            send(&query);
+    }
+}
+
+/*
+    Every query is sent from a socket of its own, bound to a random port,
+    so that a forged answer has to guess the port as well as the query's
+    ID to be accepted (RFC 5452).
+*/
+QUdpSocket *QDnsResolver::bindUdpSocket(const QHostAddress &server)
+{
+    bool isIPv4 = false;
+    server.toIPv4Address(&isIPv4);
+    const QHostAddress any(isIPv4 ? QHostAddress::AnyIPv4 : QHostAddress::AnyIPv6);
+
+    auto socket = new QUdpSocket(this);
+    for (int i = 0; i < 8; ++i) {
+        const auto port = quint16(QRandomGenerator::system()->bounded(1024, 65536));
+        if (socket->bind(any, port, QUdpSocket::DontShareAddress))
+            return socket;
+    }
+    // Leave it to the system, which picks a random port as well on most
+    if (socket->bind(any, 0, QUdpSocket::DontShareAddress))
+        return socket;
+    delete socket;
+    return nullptr;
+}
+
+// Sends the query to the next name server, unless it's been sent often enough
+void QDnsResolver::send(Query *query)
+{
+    const QDnsResolverConfiguration &configuration = *query->lookup->configuration;
+    const int maximumTries = configuration.attempts * int(configuration.nameServers.size());
+    const QByteArray &name = query->lookup->candidates.at(query->lookup->candidate);
+    while (query->tries < maximumTries) {
+        query->server = configuration.nameServers.at(query->tries % configuration.nameServers.size());
+        ++query->tries;
+        query->udpSocket = bindUdpSocket(query->server.address);
+        if (!query->udpSocket)
+            continue;
+        connect(query->udpSocket, &QUdpSocket::readyRead, this, [this, query] {
+            readDatagrams(query);
+        });
+        query->id = quint16(QRandomGenerator::system()->generate());
+        const QByteArray packet = makeQuery(query->id, encodeName(name), query->type);
+        if (query->udpSocket->writeDatagram(packet, query->server.address, query->server.port) == packet.size()) {
+            query->timerId = startTimer(configuration.timeout);
+            queriesByTimer.insert(query->timerId, query);
+            return;
+        }
+        stopQuery(query);
+    }
+    finishQuery(query, Query::Failed);
+}
+
+// For responses that didn't fit into a datagram (RFC 7766)
+void QDnsResolver::sendOverTcp(Query *query)
+{
+    const QByteArray &name = query->lookup->candidates.at(query->lookup->candidate);
+    QByteArray packet = makeQuery(query->id, encodeName(name), query->type);
+    QByteArray length;
+    appendUInt16(length, quint16(packet.size()));
+    packet.prepend(length);
+
+    query->tcpSocket = new QTcpSocket(this);
+    query->tcpBuffer.clear();
+    connect(query->tcpSocket, &QTcpSocket::connected, this, [query, packet] {
+        query->tcpSocket->write(packet);
+    });
+    connect(query->tcpSocket, &QTcpSocket::readyRead, this, [this, query] {
+        query->tcpBuffer += query->tcpSocket->readAll();
+        if (query->tcpBuffer.size() < 2)
+            return;
+        const qsizetype length = qFromBigEndian<quint16>(query->tcpBuffer.constData());
+        if (query->tcpBuffer.size() < 2 + length)
+            return;
+        const QByteArray response = query->tcpBuffer.mid(2, length);
+        handleResponse(query, response);
+    });
+    connect(query->tcpSocket, &QTcpSocket::errorOccurred, this, [this, query] {
+        stopQuery(query);
+        finishQuery(query, Query::Failed);
+    });
+    query->tcpSocket->connectToHost(query->server.address, query->server.port);
+    query->timerId = startTimer(query->lookup->configuration->timeout);
+    queriesByTimer.insert(query->timerId, query);
+}
+
+void QDnsResolver::readDatagrams(Query *query)
+{
+    QUdpSocket *socket = query->udpSocket;
+    while (socket->hasPendingDatagrams()) {
+        const QNetworkDatagram datagram = socket->receiveDatagram();
+        // Only take answers from where we sent the question
+        if (datagram.senderPort() != query->server.port
+            || !datagram.senderAddress().isEqual(query->server.address,
+                                                 QHostAddress::ConvertV4MappedToIPv4)) {
+            continue;
+        }
+        // Taking an answer lets go of the socket, and may finish the whole
+        // lookup, which deletes the query
+        if (handleResponse(query, datagram.data()))
+            return;
+    }
+}
+
+// Returns false if the response isn't for the query, which then keeps
+// waiting; otherwise, the query may have been deleted when this returns.
+bool QDnsResolver::handleResponse(Query *query, QByteArrayView data)
+{
+    const QByteArray &name = query->lookup->candidates.at(query->lookup->candidate);
+    Response response;
+    if (!parseResponse(data, name, query->type, &response) || response.id != query->id)
+        return false;
+
+    const bool overTcp = query->tcpSocket;
+    stopQuery(query);
+
+    if (response.truncated && !overTcp) {
+        sendOverTcp(query);
+        return true;
+    }
+
+    switch (response.responseCode) {
+    case NoErrorCode:
+        query->addresses = response.addresses;
+        query->ttl = response.addresses.isEmpty() ? response.negativeTtl : response.ttl;
+        finishQuery(query, Query::Answered);
+        break;
+    case NameErrorCode:
+        query->ttl = response.negativeTtl;
+        finishQuery(query, Query::NameError);
+        break;
+    default:
+        // Server failure, refused, ... maybe another name server knows better
+        send(query);
+        break;
+    }
+    return true;
+}
+
+// Forgets about the query's outstanding request, if there is one
+void QDnsResolver::stopQuery(Query *query)
+{
+    if (query->timerId) {
+        killTimer(query->timerId);
+        queriesByTimer.remove(query->timerId);
+        query->timerId = 0;
+    }
+    if (query->udpSocket) {
+        query->udpSocket->disconnect(this);
+        query->udpSocket->abort();
+        query->udpSocket->deleteLater();
+        query->udpSocket = nullptr;
+    }
+    if (query->tcpSocket) {
+        query->tcpSocket->disconnect(this);
+        query->tcpSocket->abort();
+        query->tcpSocket->deleteLater();
+        query->tcpSocket = nullptr;
+    }
+}
+
+void QDnsResolver::timerEvent(QTimerEvent *event)
+{
+    Query *query = queriesByTimer.value(event->timerId());
+    if (!query)
+        return QObject::timerEvent(event);
+    const bool overTcp = query->tcpSocket;
+    stopQuery(query);
+    if (overTcp)
+        finishQuery(query, Query::Failed);
+    else
+        send(query);
+}
+
+void QDnsResolver::finishQuery(Query *query, Query::State state)
+{
+    query->state = state;
+    Lookup *lookup = query->lookup;
+    for (const Query &other : lookup->queries) {
+        if (other.state == Query::Pending)
+            return;
+    }
+    finishCandidate(lookup);
+}
+
+void QDnsResolver::finishCandidate(Lookup *lookup)
+{
+    const Query &ipv6 = lookup->queries[0];
+    const Query &ipv4 = lookup->queries[1];
+
+    QHostInfo info;
+    info.setHostName(lookup->hostName);
+
+    if (!ipv6.addresses.isEmpty() || !ipv4.addresses.isEmpty()) {
+        info.setAddresses(interleaveAddresses(ipv6.addresses, ipv4.addresses));
+        int ttl = INT_MAX;
+        for (const Query &query : lookup->queries) {
+            if (!query.addresses.isEmpty())
+                ttl = qMin(ttl, query.ttl);
+        }
+        return finishLookup(lookup, info, qMin(ttl, MaximumTtl));
+    }
+
+    if (ipv6.state == Query::Failed || ipv4.state == Query::Failed) {
+        info.setError(QHostInfo::UnknownError);
+        info.setErrorString(QCoreApplication::translate("QHostInfoAgent",
+                                                        "Temporary failure in name resolution"));
+        return finishLookup(lookup, info, -1);
+    }
+
+    // The name doesn't exist, or has no addresses; try the next one
+    if (++lookup->candidate < lookup->candidates.size())
+        return startCandidate(lookup);
+
+    info.setError(QHostInfo::HostNotFound);
+    info.setErrorString(QCoreApplication::translate("QHostInfoAgent", "Host not found"));
+    // Without an SOA record, we don't know how long it's safe to cache
+    // that there's nothing (RFC 2308, 5)
+    const int ttl = ipv6.ttl < 0 || ipv4.ttl < 0 ? -1 : qMin(ipv6.ttl, ipv4.ttl);
+    finishLookup(lookup, info, qMin(ttl, MaximumNegativeTtl));
+}
+
+void QDnsResolver::finishLookup(Lookup *lookup, const QHostInfo &info, int ttl)
+{
+    const auto it = lookups.find(lookup->hostName);
+    Q_ASSERT(it != lookups.end());
+    const std::unique_ptr<Lookup> finished = std::move(it->second);
+    lookups.erase(it);
+    for (const Callback &callback : finished->callbacks)
+        callback(info, ttl);
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qdnsresolver_p.cpp"
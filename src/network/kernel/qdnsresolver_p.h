@@ -0,0 +1,143 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QDNSRESOLVER_P_H
+#define QDNSRESOLVER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of the QHostInfo class.  This header file may change from
+// version to version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtNetwork/private/qtnetworkglobal_p.h>
+#include "QtNetwork/qhostaddress.h"
+#include "QtNetwork/qhostinfo.h"
+#include "QtCore/qbytearray.h"
+#include "QtCore/qhash.h"
+#include "QtCore/qlist.h"
+#include "QtCore/qobject.h"
+#include "QtCore/qstringlist.h"
+
+#include <functional>
+#include <map>
+#include <memory>
+
+QT_REQUIRE_CONFIG(udpsocket);
+
+QT_BEGIN_NAMESPACE
+
+class QUdpSocket;
+class QTcpSocket;
+
+// What resolv.conf(5) and hosts(5) say, as far as QDnsResolver cares.
+struct Q_AUTOTEST_EXPORT QDnsResolverConfiguration
+{
+    struct NameServer
+    {
+        QHostAddress address;
+        quint16 port = 53;
+    };
+
+    QList<NameServer> nameServers;
+    QList<QByteArray> searchDomains;
+    int ndots = 1;
+    int timeout = 5000; // milliseconds, per attempt
+    int attempts = 2;
+    // lower-case host name -> addresses
+    QHash<QByteArray, QList<QHostAddress>> hosts;
+
+    void parseResolvConf(QByteArrayView contents);
+    void parseHosts(QByteArrayView contents);
+    static QDnsResolverConfiguration fromSystem();
+};
+
+// Resolves host names by talking to the name servers directly, over UDP
+// and, for truncated responses, TCP, in the event loop of the thread the
+// resolver lives in. Both A and AAAA records are queried at the same time.
+class Q_AUTOTEST_EXPORT QDnsResolver : public QObject
+{
+    Q_OBJECT
+public:
+    // Called with the result and the number of seconds it may be cached
+    // for, which is -1 if it should not be cached at all.
+    using Callback = std::function<void(const QHostInfo &info, int ttl)>;
+
+    explicit QDnsResolver(QObject *parent = nullptr);
+    ~QDnsResolver();
+
+    void lookup(const QString &hostName, Callback callback);
+
+    // Needs an event loop running in the current thread
+    static QDnsResolver *forCurrentThread();
+
+    static std::shared_ptr<const QDnsResolverConfiguration> configuration();
+    // Replaces the system's configuration, until called with nullptr
+    static void setConfiguration(std::shared_ptr<const QDnsResolverConfiguration> configuration);
+
+    // Caps for the time to live of positive and negative answers, in seconds
+    static constexpr int MaximumTtl = 3600;
+    static constexpr int MaximumNegativeTtl = 300;
+
+protected:
+    void timerEvent(QTimerEvent *event) override;
+
+private:
+    struct Lookup;
+    struct Query
+    {
+        enum State {
+            Pending,
+            Answered,   // addresses, or no data for the type (addresses empty)
+            NameError,  // NXDOMAIN
+            Failed      // no usable response from any name server
+        };
+
+        Lookup *lookup = nullptr;
+        quint16 type = 0;
+        quint16 id = 0;
+        int tries = 0;
+        int timerId = 0;
+        QDnsResolverConfiguration::NameServer server;
+        QUdpSocket *udpSocket = nullptr;
+        QTcpSocket *tcpSocket = nullptr;
+        QByteArray tcpBuffer;
+
+        State state = Pending;
+        QList<QHostAddress> addresses;
+        int ttl = -1;
+    };
+
+    struct Lookup
+    {
+        QString hostName;
+        std::shared_ptr<const QDnsResolverConfiguration> configuration;
+        QList<QByteArray> candidates;
+        qsizetype candidate = 0;
+        Query queries[2];
+        std::vector<Callback> callbacks;
+    };
+
+    void startCandidate(Lookup *lookup);
+    void send(Query *query);
+    void sendOverTcp(Query *query);
+    QUdpSocket *bindUdpSocket(const QHostAddress &server);
+    void readDatagrams(Query *query);
+    bool handleResponse(Query *query, QByteArrayView response);
+    void finishQuery(Query *query, Query::State state);
+    void finishCandidate(Lookup *lookup);
+    void finishLookup(Lookup *lookup, const QHostInfo &info, int ttl);
+    void stopQuery(Query *query);
+
+    std::map<QString, std::unique_ptr<Lookup>> lookups;
+    QHash<int, Query *> queriesByTimer;
+};
+
+QT_END_NAMESPACE
+
+#endif // QDNSRESOLVER_P_H
@@ -5,6 +5,9 @@
 
 #include "qhostinfo.h"
 #include "qhostinfo_p.h"
+#if QT_CONFIG(udpsocket)
+#include "qdnsresolver_p.h"
+#endif
 #include <qplatformdefs.h>
 
 #include "QtCore/qapplicationstatic.h"
@@ -40,6 +43,8 @@ using namespace Qt::StringLiterals;
 
 QT_IMPL_METATYPE_EXTERN(QHostInfo)
 
+static std::atomic<QHostInfo::Resolver> theResolver{QHostInfo::Resolver::System};
+
 namespace {
 struct ToBeLookedUpEquals {
     typedef bool result_type;
@@ -327,6 +332,62 @@ void QHostInfo::abortHostLookup(int id)
     theHostInfoLookupManager()->abortLookup(id);
 }
 
+/*!
+    \enum QHostInfo::Resolver
+    \since 6.5
+
+    This enum describes how lookupHost() resolves host names.
+
+    \value System  The host name is passed to the operating system's
+                   resolver, such as \c getaddrinfo(), on a thread from
+                   a thread pool. This is the default.
+    \value Dns     QHostInfo sends the queries for the host's IPv4 and
+                   IPv6 addresses to the name servers itself, without
+                   blocking a thread. This happens in the event loop of
+                   the receiver's or context object's thread, which must
+                   be running for the lookup to finish; lookups without
+                   a receiver or context object, or whose receiver lives
+                   in a thread without an event dispatcher, use the
+                   system's resolver.
+                   Results are cached for as long as the name servers
+                   say they are valid, and names that don't exist are
+                   cached too. The name servers, search domains and
+                   options are read from \c{/etc/resolv.conf}, and
+                   \c{/etc/hosts} is consulted first. Where there is no
+                   such configuration, or for IP addresses, the system's
+                   resolver is used.
+
+    Blocking lookups with fromName() always use the system's resolver.
+
+    \sa setResolver()
+*/
+
+/*!
+    \since 6.5
+
+    Sets the way lookupHost() resolves host names for the whole
+    application to \a resolver. Lookups that have already been started
+    are not affected.
+
+    \sa resolver()
+*/
+void QHostInfo::setResolver(Resolver resolver)
+{
+    theResolver.store(resolver, std::memory_order_relaxed);
+}
+
+/*!
+    \since 6.5
+
+    Returns the way lookupHost() resolves host names.
+
+    \sa setResolver()
+*/
+QHostInfo::Resolver QHostInfo::resolver()
+{
+    return theResolver.load(std::memory_order_relaxed);
+}
+
 /*!
     Looks up the IP address(es) for the given host \a name. The
     function blocks during the lookup which means that execution of
@@ -807,6 +868,42 @@ int QHostInfo::lookupHostImpl(const QString &name,
             }
         }
 
+#if QT_CONFIG(udpsocket)
+        // The resolver works in the event loop of the receiver's thread, which
+        // has to run for the results to be delivered anyway; the thread that
+        // called us may never return to its own
+        QThread *thread = receiver ? receiver->thread() : nullptr;
+        if (resolver() == Resolver::Dns && thread && QAbstractEventDispatcher::instance(thread)
+            && !QHostAddress().setAddress(name)
+            && !QDnsResolver::configuration()->nameServers.isEmpty()) {
+            auto result = std::make_shared<QHostInfoResult>(receiver, slotObj);
+            if (receiver && member)
+                QObject::connect(result.get(), SIGNAL(resultsReady(QHostInfo)),
+                                 receiver, member, Qt::QueuedConnection);
+            auto lookup = [name, id, result] {
+                QDnsResolver *dnsResolver = QDnsResolver::forCurrentThread();
+                dnsResolver->lookup(name, [name, id, result](const QHostInfo &info, int ttl) {
+                    QHostInfoLookupManager *manager = theHostInfoLookupManager();
+                    if (!manager)
+                        return;
+                    if (ttl > 0 && manager->cache.isEnabled())
+                        manager->cache.put(name, info, ttl);
+                    if (manager->takeAbortedLookup(id))
+                        return;
+                    QHostInfo hostInfo = info;
+                    hostInfo.setLookupId(id);
+                    result->postResultsReady(hostInfo);
+                });
+            };
+            if (thread == QThread::currentThread())
+                lookup();
+            else
+                QMetaObject::invokeMethod(const_cast<QObject *>(receiver), lookup,
+                                          Qt::QueuedConnection);
+            return id;
+        }
+#endif
+
         // cache is not enabled or it was not in the cache, do normal lookup
         QHostInfoRunnable *runnable = new QHostInfoRunnable(name, id, receiver, slotObj);
         if (receiver && member)
@@ -1033,6 +1130,17 @@ bool QHostInfoLookupManager::wasAborted(int id)
     return abortedLookups.contains(id);
 }
 
+// called when a lookup done by QDnsResolver finishes
+bool QHostInfoLookupManager::takeAbortedLookup(int id)
+{
+    QMutexLocker locker(&this->mutex);
+
+    if (wasDeleted)
+        return true;
+
+    return abortedLookups.removeOne(id);
+}
+
 // called from QHostInfoRunnable
 void QHostInfoLookupManager::lookupFinished(QHostInfoRunnable *r)
 {
@@ -1112,7 +1220,7 @@ QHostInfo QHostInfoCache::get(const QString &name, bool *valid)
 
     *valid = false;
     if (QHostInfoCacheElement *element = cache.object(name)) {
-        if (element->age.elapsed() < max_age*1000)
+        if (element->age.elapsed() < element->maxAge * 1000)
             *valid = true;
         return element->info;
 
@@ -1130,10 +1238,16 @@ void QHostInfoCache::put(const QString &name, const QHostInfo &info)
     if (info.error() != QHostInfo::NoError)
         return;
 
+    put(name, info, max_age);
+}
+
+void QHostInfoCache::put(const QString &name, const QHostInfo &info, int maxAge)
+{
     QHostInfoCacheElement* element = new QHostInfoCacheElement();
     element->info = info;
     element->age = QElapsedTimer();
     element->age.start();
+    element->maxAge = maxAge;
 
     QMutexLocker locker(&this->mutex);
     cache.insert(name, element); // cache will take ownership
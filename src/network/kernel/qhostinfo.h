@@ -24,6 +24,11 @@ public:
         UnknownError
     };
 
+    enum class Resolver {
+        System,
+        Dns
+    };
+
     explicit QHostInfo(int lookupId = -1);
     QHostInfo(const QHostInfo &d);
     QHostInfo(QHostInfo &&other) noexcept : d_ptr(qExchange(other.d_ptr, nullptr)) {}
@@ -51,6 +56,9 @@ public:
     static int lookupHost(const QString &name, QObject *receiver, const char *member);
     static void abortHostLookup(int lookupId);
 
+    static void setResolver(Resolver resolver);
+    static Resolver resolver();
+
     static QHostInfo fromName(const QString &name);
     static QString localHostName();
     static QString localDomainName();
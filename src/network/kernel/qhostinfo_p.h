@@ -122,6 +122,8 @@ public:
 
     QHostInfo get(const QString &name, bool *valid);
     void put(const QString &name, const QHostInfo &info);
+    // Caches info, even an error, for maxAge seconds instead of max_age
+    void put(const QString &name, const QHostInfo &info, int maxAge);
     void clear();
 
     bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
@@ -133,6 +135,7 @@ private:
     struct QHostInfoCacheElement {
         QHostInfo info;
         QElapsedTimer age;
+        int maxAge; // seconds
     };
     QCache<QString,QHostInfoCacheElement> cache;
     QMutex mutex;
@@ -169,6 +172,9 @@ public:
     void lookupFinished(QHostInfoRunnable *r);
     bool wasAborted(int id);
 
+    // called for lookups that don't go through a QHostInfoRunnable
+    bool takeAbortedLookup(int id);
+
     QHostInfoCache cache;
 
     friend class QHostInfoRunnable;
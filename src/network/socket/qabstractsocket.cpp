@@ -741,7 +741,7 @@ void QAbstractSocketPrivate::connectionNotification()
 bool QAbstractSocketPrivate::writeToSocket()
 {
     Q_Q(QAbstractSocket);
-    if (!socketEngine || !socketEngine->isValid() || (writeBuffer.isEmpty()
+    if (!socketEngine || !socketEngine->isValid() || (writeBuffer.isEmpty() && pendingFiles.isEmpty()
         && socketEngine->bytesToWrite() == 0)) {
 #if defined (QABSTRACTSOCKET_DEBUG)
     qDebug("QAbstractSocketPrivate::writeToSocket() nothing to do: valid ? %s, writeBuffer.isEmpty() ? %s",
@@ -759,11 +759,40 @@ bool QAbstractSocketPrivate::writeToSocket()
         return false;
     }
 
-    qint64 nextSize = writeBuffer.nextDataBlockSize();
-    const char *ptr = writeBuffer.readPointer();
+    qint64 written;
+    if (!pendingFiles.isEmpty() && pendingFiles.constFirst().precedingBytes == 0) {
+        // Everything written before the file has gone out, continue with the file.
+        PendingFile &pending = pendingFiles.first();
+        if (!pending.file) {
+            setErrorAndEmit(QAbstractSocket::UnknownSocketError,
+                            QAbstractSocket::tr("File was destroyed while it was being sent"));
+            q->abort();
+            return false;
+        }
+        written = socketEngine->sendFile(pending.file, pending.offset, pending.remaining);
+        if (written > 0) {
+            pending.offset += written;
+            pending.remaining -= written;
+            pendingFileBytes -= written;
+            if (pending.remaining == 0)
+                pendingFiles.removeFirst();
+        }
+    } else {
+        qint64 nextSize = writeBuffer.nextDataBlockSize();
+        if (!pendingFiles.isEmpty())
+            nextSize = qMin(nextSize, pendingFiles.constFirst().precedingBytes);
+        const char *ptr = writeBuffer.readPointer();
+
+        // Attempt to write it all in one chunk.
+        written = nextSize ? socketEngine->write(ptr, nextSize) : Q_INT64_C(0);
+        if (written > 0) {
+            // Remove what we wrote so far.
+            writeBuffer.free(written);
+            if (!pendingFiles.isEmpty())
+                pendingFiles.first().precedingBytes -= written;
+        }
+    }
 
-    // Attempt to write it all in one chunk.
-    qint64 written = nextSize ? socketEngine->write(ptr, nextSize) : Q_INT64_C(0);
     if (written < 0) {
 #if defined (QABSTRACTSOCKET_DEBUG)
         qDebug() << "QAbstractSocketPrivate::writeToSocket() write error, aborting."
@@ -780,15 +809,11 @@ bool QAbstractSocketPrivate::writeToSocket()
            written);
 #endif
 
-    if (written > 0) {
-        // Remove what we wrote so far.
-        writeBuffer.free(written);
-
-        // Emit notifications.
+    // Emit notifications.
+    if (written > 0)
         emitBytesWritten(written);
-    }
 
-    if (writeBuffer.isEmpty() && socketEngine && !socketEngine->bytesToWrite())
+    if (writeBuffer.isEmpty() && pendingFiles.isEmpty() && socketEngine && !socketEngine->bytesToWrite())
         socketEngine->setWriteNotificationEnabled(false);
     if (state == QAbstractSocket::ClosingState)
         q->disconnectFromHost();
@@ -796,6 +821,175 @@ bool QAbstractSocketPrivate::writeToSocket()
     return written > 0;
 }
 
+/*! \internal
+
+    Queues \a length bytes of \a file, starting at \a offset, to be sent
+    after the data currently in the write buffer. The socket engine sends
+    them straight from the file when the socket can take more data.
+
+    Returns the number of bytes queued, or -1 if an error occurred.
+*/
+qint64 QAbstractSocketPrivate::sendFile(QFileDevice *file, qint64 offset, qint64 length)
+{
+    if (state == QAbstractSocket::UnconnectedState) {
+        setError(QAbstractSocket::UnknownSocketError, QAbstractSocket::tr("Socket is not connected"));
+        return -1;
+    }
+
+    // Datagram and multi-stream sockets have no single byte stream to
+    // splice the file into.
+    if (socketType != QAbstractSocket::TcpSocket)
+        return sendFileInBlocks(file, offset, length, [this] { return writeBuffer.size(); });
+
+    qint64 precedingBytes = writeBuffer.size();
+    for (const PendingFile &pending : std::as_const(pendingFiles))
+        precedingBytes -= pending.precedingBytes;
+    pendingFiles.append({ file, offset, length, precedingBytes });
+    pendingFileBytes += length;
+
+    if (socketEngine)
+        socketEngine->setWriteNotificationEnabled(true);
+    return length;
+}
+
+/*! \internal
+
+    Queues \a length bytes of \a file, starting at \a offset, to be
+    written to the socket with writeData() a block at a time, whenever
+    \a bufferedBytes says the socket is running out of data to send. This
+    is the fallback for sockets that need to process the data, such as
+    encrypted ones, so that sending a large file doesn't read all of it
+    into memory.
+
+    Returns the number of bytes queued.
+*/
+qint64 QAbstractSocketPrivate::sendFileInBlocks(QFileDevice *file, qint64 offset, qint64 length,
+                                                std::function<qint64()> bufferedBytes)
+{
+    if (!sendFileFallback) {
+        sendFileFallback = std::make_unique<QSendFileFallback>(
+                std::move(bufferedBytes),
+                [this](const char *data, qint64 size) {
+                    Q_Q(QAbstractSocket);
+                    return q->writeData(data, size);
+                },
+                [this](const QString &message) {
+                    Q_Q(QAbstractSocket);
+                    setErrorAndEmit(QAbstractSocket::UnknownSocketError, message);
+                    q->abort();
+                });
+    }
+    return sendFileFallback->enqueueFile(file, offset, length);
+}
+
+void QAbstractSocketPrivate::clearPendingFiles()
+{
+    pendingFiles.clear();
+    pendingFileBytes = 0;
+    if (sendFileFallback)
+        sendFileFallback->clear();
+}
+
+QSendFileFallback::QSendFileFallback(std::function<qint64()> bufferedBytes,
+                                     std::function<qint64(const char *, qint64)> write,
+                                     std::function<void(const QString &)> failed)
+    : bufferedBytes(std::move(bufferedBytes)), write(std::move(write)), failed(std::move(failed))
+{
+}
+
+/*! \internal
+
+    Queues \a length bytes of \a file, starting at \a offset, and writes
+    as much of the queue as the device's buffers take right away. Returns
+    the number of bytes queued.
+*/
+qint64 QSendFileFallback::enqueueFile(QFileDevice *file, qint64 offset, qint64 length)
+{
+    items.append({ file, offset, length, QByteArray() });
+    queuedBytes += length;
+    feed();
+    return length;
+}
+
+/*! \internal
+
+    Queues \a size bytes of \a data behind the files in the queue, and
+    returns \c true, unless the queue is empty: then the data can be
+    written to the device directly, and this function returns \c false.
+*/
+bool QSendFileFallback::enqueueData(const char *data, qint64 size)
+{
+    if (feeding || items.isEmpty())
+        return false;
+    if (items.constLast().data.isEmpty())
+        items.append({ nullptr, 0, 0, QByteArray() });
+    items.last().data.append(data, size);
+    items.last().remaining += size;
+    queuedBytes += size;
+    return true;
+}
+
+/*! \internal
+
+    Writes the queue to the device, one block at a time, until the device
+    has QABSTRACTSOCKET_BUFFERSIZE bytes to send. Call it whenever the
+    device has sent some data.
+*/
+void QSendFileFallback::feed()
+{
+    if (feeding)
+        return;
+    QScopedValueRollback<bool> guard(feeding, true);
+
+    while (!items.isEmpty() && bufferedBytes() < QABSTRACTSOCKET_BUFFERSIZE) {
+        Item &item = items.first();
+        QByteArray block;
+        if (!item.data.isEmpty()) {
+            block = std::exchange(item.data, QByteArray());
+            item.remaining = 0;
+        } else {
+            QFileDevice *file = item.file;
+            if (!file) {
+                const auto callback = failed;
+                clear();
+                callback(QAbstractSocket::tr("File was destroyed while it was being sent"));
+                return;
+            }
+            block.resize(qMin(item.remaining, qint64(QABSTRACTSOCKET_BUFFERSIZE)));
+            const qint64 pos = file->pos();
+            qint64 readBytes = -1;
+            if (file->seek(item.offset))
+                readBytes = file->read(block.data(), block.size());
+            file->seek(pos);
+            if (readBytes <= 0) {
+                const auto callback = failed;
+                clear();
+                callback(readBytes < 0 ? file->errorString()
+                                       : QAbstractSocket::tr("Unexpected end of file"));
+                return;
+            }
+            block.truncate(readBytes);
+            item.offset += readBytes;
+            item.remaining -= readBytes;
+        }
+        if (item.remaining == 0)
+            items.removeFirst();
+
+        queuedBytes -= block.size();
+        if (write(block.constData(), block.size()) != block.size()) {
+            // The device has reported the error
+            clear();
+            return;
+        }
+    }
+}
+
+void QSendFileFallback::clear()
+{
+    items.clear();
+    queuedBytes = 0;
+}
+
 /*! \internal
 
     Writes pending data in the write buffers to the socket. The function
@@ -806,7 +1000,7 @@ bool QAbstractSocketPrivate::flush()
 {
     bool dataWasWritten = false;
 
-    while (!allWriteBuffersEmpty() && writeToSocket())
+    while ((!allWriteBuffersEmpty() || !pendingFiles.isEmpty()) && writeToSocket())
         dataWasWritten = true;
 
     return dataWasWritten;
@@ -1230,6 +1424,9 @@ void QAbstractSocketPrivate::emitBytesWritten(qint64 bytes, int channel)
     }
     // channelBytesWritten() can be emitted recursively - even for the same channel.
     emit q->channelBytesWritten(channel, bytes);
+
+    if (sendFileFallback)
+        sendFileFallback->feed();
 }
 
 /*! \internal
@@ -1633,6 +1830,7 @@ void QAbstractSocket::connectToHost(const QString &hostName, quint16 port,
     d->port = port;
     d->setReadChannelCount(0);
     d->setWriteChannelCount(0);
+    d->clearPendingFiles();
     d->abortCalled = false;
     d->pendingClose = false;
     if (d->state != BoundState) {
@@ -1731,7 +1929,10 @@ void QAbstractSocket::connectToHost(const QHostAddress &address, quint16 port,
 */
 qint64 QAbstractSocket::bytesToWrite() const
 {
-    const qint64 pendingBytes = QIODevice::bytesToWrite();
+    Q_D(const QAbstractSocket);
+    qint64 pendingBytes = QIODevice::bytesToWrite() + d->pendingFileBytes;
+    if (d->sendFileFallback)
+        pendingBytes += d->sendFileFallback->bytesToWrite();
 #if defined(QABSTRACTSOCKET_DEBUG)
     qDebug("QAbstractSocket::bytesToWrite() == %lld", pendingBytes);
 #endif
@@ -1860,6 +2061,7 @@ bool QAbstractSocket::setSocketDescriptor(qintptr socketDescriptor, SocketState
     d->resetSocketLayer();
     d->setReadChannelCount(0);
     d->setWriteChannelCount(0);
+    d->clearPendingFiles();
     d->socketEngine = QAbstractSocketEngine::createSocketEngine(socketDescriptor, this);
     if (!d->socketEngine) {
         d->setError(UnsupportedSocketOperationError, tr("Operation on socket is not supported"));
@@ -2159,7 +2361,7 @@ bool QAbstractSocket::waitForReadyRead(int msecs)
 
         bool readyToRead = false;
         bool readyToWrite = false;
-        if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite, true, !d->writeBuffer.isEmpty(),
+        if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite, true, !d->writeBuffer.isEmpty() || !d->pendingFiles.isEmpty(),
                                                qt_subtract_from_timeout(msecs, stopWatch.elapsed()))) {
 #if defined (QABSTRACTSOCKET_DEBUG)
             qDebug("QAbstractSocket::waitForReadyRead(%i) failed (%i, %s)",
@@ -2211,7 +2413,7 @@ bool QAbstractSocket::waitForBytesWritten(int msecs)
         return false;
     }
 
-    if (d->writeBuffer.isEmpty())
+    if (d->writeBuffer.isEmpty() && d->pendingFiles.isEmpty())
         return false;
 
     QElapsedTimer stopWatch;
@@ -2228,7 +2430,7 @@ bool QAbstractSocket::waitForBytesWritten(int msecs)
         bool readyToWrite = false;
         if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite,
                                   !d->readBufferMaxSize || d->buffer.size() < d->readBufferMaxSize,
-                                  !d->writeBuffer.isEmpty(),
+                                  !d->writeBuffer.isEmpty() || !d->pendingFiles.isEmpty(),
                                   qt_subtract_from_timeout(msecs, stopWatch.elapsed()))) {
 #if defined (QABSTRACTSOCKET_DEBUG)
             qDebug("QAbstractSocket::waitForBytesWritten(%i) failed (%i, %s)",
@@ -2308,7 +2510,7 @@ bool QAbstractSocket::waitForDisconnected(int msecs)
         bool readyToRead = false;
         bool readyToWrite = false;
         if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite, state() == ConnectedState,
-                                               !d->writeBuffer.isEmpty(),
+                                               !d->writeBuffer.isEmpty() || !d->pendingFiles.isEmpty(),
                                                qt_subtract_from_timeout(msecs, stopWatch.elapsed()))) {
 #if defined (QABSTRACTSOCKET_DEBUG)
             qDebug("QAbstractSocket::waitForReadyRead(%i) failed (%i, %s)",
@@ -2345,6 +2547,7 @@ void QAbstractSocket::abort()
     qDebug("QAbstractSocket::abort()");
 #endif
     d->setWriteChannelCount(0);
+    d->clearPendingFiles();
     d->abortCalled = true;
     close();
 }
@@ -2375,6 +2578,66 @@ bool QAbstractSocket::flush()
     return d_func()->flush();
 }
 
+/*!
+    \since 6.5
+
+    Queues \a length bytes of \a file, starting at \a offset, to be sent
+    over the socket. If \a length is -1 (the default) or extends past the
+    end of the file, everything from \a offset to the end of the file is
+    sent. Returns the number of bytes queued, or -1 if an error occurred.
+
+    The data is sent in order with what is passed to write(): everything
+    written before this call goes out first, and everything written after
+    it goes out after the file. bytesWritten() is emitted as the file is
+    sent, and bytesToWrite() includes the part that has not been sent yet.
+
+    For unencrypted TCP connections on Linux, the operating system copies
+    the data from \a file to the socket directly, without passing it
+    through the socket's write buffer. Otherwise, the data is read from
+    \a file in blocks and written as if by write(), each block once the
+    socket has sent most of the previous ones, so that only a few of them
+    are held in memory at a time. Encrypted QSslSocket connections send
+    the file this way; closing one with close() rather than
+    disconnectFromHost() discards the part of the file that has not been
+    encrypted yet.
+
+    \a file must be open for reading, and must remain open and not be
+    destroyed until all of it has been sent; that is, until bytesToWrite()
+    no longer accounts for it. Its current position is not changed.
+    Modifying the file while it is being sent results in undefined data
+    being sent.
+
+    \sa write(), bytesWritten(), bytesToWrite()
+*/
+qint64 QAbstractSocket::sendFile(QFileDevice *file, qint64 offset, qint64 length)
+{
+    Q_D(QAbstractSocket);
+    if (!file || !file->isReadable()) {
+        qWarning("QAbstractSocket::sendFile: file is not open for reading");
+        return -1;
+    }
+    if (!isWritable()) {
+        qWarning("QAbstractSocket::sendFile: device not open for writing");
+        return -1;
+    }
+
+    const qint64 fileSize = file->size();
+    if (offset < 0 || offset > fileSize) {
+        qWarning("QAbstractSocket::sendFile: offset %lld is outside of the file", offset);
+        return -1;
+    }
+    if (length < 0 || length > fileSize - offset)
+        length = fileSize - offset;
+    if (length == 0)
+        return 0;
+
+    // data written through the file's own buffer must be in the file first
+    if (file->isWritable())
+        file->flush();
+
+    return d->sendFile(file, offset, length);
+}
+
 /*! \reimp
 */
 qint64 QAbstractSocket::readData(char *data, qint64 maxSize)
@@ -2426,8 +2689,12 @@ qint64 QAbstractSocket::writeData(const char *data, qint64 size)
         return -1;
     }
 
+    // What is written after a file that is sent in blocks goes out after it
+    if (d->sendFileFallback && d->sendFileFallback->enqueueData(data, size))
+        return size;
+
     if (!d->isBuffered && d->socketType == TcpSocket
-        && d->socketEngine && d->writeBuffer.isEmpty()) {
+        && d->socketEngine && d->writeBuffer.isEmpty() && d->pendingFiles.isEmpty()) {
         // This code is for the new Unbuffered QTcpSocket use case
         qint64 written = size ? d->socketEngine->write(data, size) : Q_INT64_C(0);
         if (written < 0) {
@@ -2468,7 +2735,7 @@ qint64 QAbstractSocket::writeData(const char *data, qint64 size)
     d->write(data, size);
     qint64 written = size;
 
-    if (d->socketEngine && !d->writeBuffer.isEmpty())
+    if (d->socketEngine && (!d->writeBuffer.isEmpty() || !d->pendingFiles.isEmpty()))
         d->socketEngine->setWriteNotificationEnabled(true);
 
 #if defined (QABSTRACTSOCKET_DEBUG)
@@ -2655,6 +2922,7 @@ void QAbstractSocket::disconnectFromHost()
 
         // Wait for pending data to be written.
         if (d->socketEngine && d->socketEngine->isValid() && (!d->allWriteBuffersEmpty()
+            || !d->pendingFiles.isEmpty() || (d->sendFileFallback && !d->sendFileFallback->isEmpty())
             || d->socketEngine->bytesToWrite() > 0)) {
             d->socketEngine->setWriteNotificationEnabled(true);
 
@@ -2685,6 +2953,7 @@ void QAbstractSocket::disconnectFromHost()
     d->peerAddress.clear();
     d->peerName.clear();
     d->setWriteChannelCount(0);
+    d->clearPendingFiles();
 
 #if defined(QABSTRACTSOCKET_DEBUG)
         qDebug("QAbstractSocket::disconnectFromHost() disconnected!");
@@ -26,6 +26,7 @@ class QNetworkProxy;
 #endif
 class QAbstractSocketPrivate;
 class QAuthenticator;
+class QFileDevice;
 
 class Q_NETWORK_EXPORT QAbstractSocket : public QIODevice
 {
@@ -174,6 +175,8 @@ public:
     bool isSequential() const override;
     bool flush();
 
+    qint64 sendFile(QFileDevice *file, qint64 offset = 0, qint64 length = -1);
+
     // for synchronous access
     virtual bool waitForConnected(int msecs = 30000);
     bool waitForReadyRead(int msecs = 30000) override;
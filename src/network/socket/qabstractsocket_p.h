@@ -18,16 +18,61 @@
 #include <QtNetwork/private/qtnetworkglobal_p.h>
 #include "QtNetwork/qabstractsocket.h"
 #include "QtCore/qbytearray.h"
+#include "QtCore/qfiledevice.h"
 #include "QtCore/qlist.h"
+#include "QtCore/qpointer.h"
 #include "QtCore/qtimer.h"
 #include "private/qiodevice_p.h"
 #include "private/qabstractsocketengine_p.h"
 #include "qnetworkproxy.h"
 
+#include <functional>
+#include <memory>
+
 QT_BEGIN_NAMESPACE
 
 class QHostInfo;
 
+// Sends files queued with sendFile() on devices that can't take them from
+// the file directly, such as encrypted sockets: a block at a time, as the
+// device's write buffers drain. What is written to the device after a file
+// is queued here as well, so that it goes out after the file.
+class QSendFileFallback
+{
+public:
+    // bufferedBytes() is how much the device still has to send; write()
+    // passes data to the device, bypassing the queue; failed() is called
+    // when a file can't be read.
+    QSendFileFallback(std::function<qint64()> bufferedBytes,
+                      std::function<qint64(const char *, qint64)> write,
+                      std::function<void(const QString &)> failed);
+
+    qint64 enqueueFile(QFileDevice *file, qint64 offset, qint64 length);
+    bool enqueueData(const char *data, qint64 size);
+    void feed();
+    void clear();
+
+    bool isEmpty() const { return items.isEmpty(); }
+    qint64 bytesToWrite() const { return queuedBytes; }
+
+private:
+    // Either the rest of a file's range, or data written after it
+    struct Item
+    {
+        QPointer<QFileDevice> file;
+        qint64 offset;
+        qint64 remaining;
+        QByteArray data;
+    };
+
+    std::function<qint64()> bufferedBytes;
+    std::function<qint64(const char *, qint64)> write;
+    std::function<void(const QString &)> failed;
+    QList<Item> items;
+    qint64 queuedBytes = 0;
+    bool feeding = false;
+};
+
 class QAbstractSocketPrivate : public QIODevicePrivate, public QAbstractSocketEngineReceiver
 {
     Q_DECLARE_PUBLIC(QAbstractSocket)
@@ -101,12 +146,30 @@ public:
     void fetchConnectionParameters();
     bool readFromSocket();
     virtual bool writeToSocket();
+    virtual qint64 sendFile(QFileDevice *file, qint64 offset, qint64 length);
+    qint64 sendFileInBlocks(QFileDevice *file, qint64 offset, qint64 length,
+                            std::function<qint64()> bufferedBytes);
     void emitReadyRead(int channel = 0);
     void emitBytesWritten(qint64 bytes, int channel = 0);
 
     void setError(QAbstractSocket::SocketError errorCode, const QString &errorString);
     void setErrorAndEmit(QAbstractSocket::SocketError errorCode, const QString &errorString);
 
+    // Ranges of files queued with sendFile(). Each one goes out after the
+    // precedingBytes of the write buffer that were written before it.
+    struct PendingFile
+    {
+        QPointer<QFileDevice> file;
+        qint64 offset;
+        qint64 remaining;
+        qint64 precedingBytes;
+    };
+    QList<PendingFile> pendingFiles;
+    qint64 pendingFileBytes = 0;
+    // For files the socket engine can't send, see sendFileInBlocks()
+    std::unique_ptr<QSendFileFallback> sendFileFallback;
+    void clearPendingFiles();
+
     qint64 readBufferMaxSize = 0;
     bool isBuffered = false;
     bool hasPendingData = false;
@@ -5,6 +5,7 @@
 
 #include "qnativesocketengine_p.h"
 
+#include "qfiledevice.h"
 #include "qmutex.h"
 #include "qnetworkproxy.h"
 
@@ -223,6 +224,90 @@ void QAbstractSocketEngine::setPeerPort(quint16 port)
     d_func()->peerPort = port;
 }
 
+/*!
+    Writes up to \a len bytes of \a file, starting at \a offset, to the
+    socket. Returns the number of bytes written, 0 if the socket cannot
+    take more data right now, or -1 if an error occurred. Reaching the end
+    of \a file before \a len bytes could be read is an error.
+
+    This implementation reads a block from \a file and passes it to
+    write(). The file's current position is preserved. Engines that can
+    have the operating system copy the data directly reimplement it.
+*/
+qint64 QAbstractSocketEngine::sendFile(QFileDevice *file, qint64 offset, qint64 len)
+{
+    char buffer[16 * 1024];
+    const qint64 pos = file->pos();
+    qint64 readBytes = -1;
+    if (file->seek(offset))
+        readBytes = file->read(buffer, qMin(len, qint64(sizeof buffer)));
+    file->seek(pos);
+
+    if (readBytes <= 0) {
+        setError(QAbstractSocket::UnknownSocketError,
+                 readBytes < 0 ? file->errorString() : tr("Unexpected end of file"));
+        return -1;
+    }
+    return write(buffer, readBytes);
+}
+
+#ifndef QT_NO_UDPSOCKET
+/*!
+    Reads up to \a count pending datagrams into \a datagrams, each of
+    them truncated to \a maxlen bytes unless \a maxlen is negative, and
+    fills in their headers according to \a options. Returns the number of
+    datagrams read, which is 0 if none was pending, or -1 if an error
+    occurred before any datagram could be read.
+
+    This implementation reads one datagram at a time. Engines that can
+    receive several datagrams with a single system call reimplement it.
+*/
+qsizetype QAbstractSocketEngine::readDatagrams(QNetworkDatagramPrivate *const *datagrams, qsizetype count,
+                                               qint64 maxlen, PacketHeaderOptions options)
+{
+    qsizetype i = 0;
+    for ( ; i < count && hasPendingDatagrams(); ++i) {
+        QNetworkDatagramPrivate *datagram = datagrams[i];
+        const qint64 size = maxlen < 0 ? pendingDatagramSize() : maxlen;
+        if (size < 0)
+            break;
+        datagram->data.resize(size);
+        const qint64 readBytes = readDatagram(datagram->data.data(), size, &datagram->header, options);
+        if (readBytes == -2)
+            break;
+        if (readBytes < 0)
+            return i ? i : -1;
+        datagram->data.truncate(readBytes);
+    }
+    return i;
+}
+
+/*!
+    Writes the \a count datagrams in \a datagrams to the socket, and
+    returns how many of them were sent, or -1 if an error occurred before
+    any datagram could be sent. Fewer than \a count datagrams are sent if
+    the socket's send buffer fills up or an error occurs.
+
+    This implementation sends one datagram at a time. Engines that can
+    send several datagrams with a single system call reimplement it.
+*/
+qsizetype QAbstractSocketEngine::writeDatagrams(const QNetworkDatagramPrivate *const *datagrams,
+                                                qsizetype count)
+{
+    qsizetype i = 0;
+    for ( ; i < count; ++i) {
+        const QNetworkDatagramPrivate *datagram = datagrams[i];
+        const qint64 sent = writeDatagram(datagram->data.constData(), datagram->data.size(),
+                                          datagram->header);
+        if (sent == -2)
+            break;
+        if (sent < 0)
+            return i ? i : -1;
+    }
+    return i;
+}
+#endif // QT_NO_UDPSOCKET
+
 int QAbstractSocketEngine::inboundStreamCount() const
 {
     return d_func()->inboundStreamCount;
@@ -26,6 +26,7 @@ QT_BEGIN_NAMESPACE
 
 class QAuthenticator;
 class QAbstractSocketEnginePrivate;
+class QFileDevice;
 #ifndef QT_NO_NETWORKINTERFACE
 class QNetworkInterface;
 #endif
@@ -71,7 +72,8 @@ public:
         ReceivePacketInformation,
         ReceiveHopLimit,
         MaxStreamsSocketOption,
-        PathMtuInformation
+        PathMtuInformation,
+        ReusePortOption
     };
 
     enum PacketHeaderOption {
@@ -105,6 +107,7 @@ public:
 
     virtual qint64 read(char *data, qint64 maxlen) = 0;
     virtual qint64 write(const char *data, qint64 len) = 0;
+    virtual qint64 sendFile(QFileDevice *file, qint64 offset, qint64 len);
 
 #ifndef QT_NO_UDPSOCKET
 #ifndef QT_NO_NETWORKINTERFACE
@@ -118,6 +121,10 @@ public:
 
     virtual bool hasPendingDatagrams() const = 0;
     virtual qint64 pendingDatagramSize() const = 0;
+
+    virtual qsizetype readDatagrams(QNetworkDatagramPrivate *const *datagrams, qsizetype count,
+                                    qint64 maxlen, PacketHeaderOptions options);
+    virtual qsizetype writeDatagrams(const QNetworkDatagramPrivate *const *datagrams, qsizetype count);
 #endif // QT_NO_UDPSOCKET
 
     virtual qint64 readDatagram(char *data, qint64 maxlen, QIpPacketHeader *header = nullptr,
@@ -203,6 +203,27 @@ QT_BEGIN_NAMESPACE
     \sa write(), waitForBytesWritten()
 */
 
+/*!
+    \fn qint64 QLocalSocket::sendFile(QFileDevice *file, qint64 offset, qint64 length)
+    \since 6.5
+
+    Queues \a length bytes of \a file, starting at \a offset, to be sent
+    over the socket. If \a length is -1 (the default) or extends past the
+    end of the file, everything from \a offset to the end of the file is
+    sent. Returns the number of bytes queued, or -1 if an error occurred.
+
+    The data is sent in order with what is passed to write(), and
+    bytesWritten() is emitted as it is sent. On Linux, the operating system
+    copies the data from \a file to the socket directly. On other platforms
+    the data is read from \a file and written as if by write().
+
+    \a file must be open for reading, and must remain open and not be
+    destroyed until all of it has been sent. Its current position is not
+    changed.
+
+    \sa QAbstractSocket::sendFile(), write()
+*/
+
 /*!
     \fn void QLocalSocket::disconnectFromServer()
 
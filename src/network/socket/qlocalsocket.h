@@ -17,6 +17,7 @@ QT_REQUIRE_CONFIG(localserver);
 QT_BEGIN_NAMESPACE
 
 class QLocalSocketPrivate;
+class QFileDevice;
 
 class Q_NETWORK_EXPORT QLocalSocket : public QIODevice
 {
@@ -76,6 +77,7 @@ public:
     virtual void close() override;
     LocalSocketError error() const;
     bool flush();
+    qint64 sendFile(QFileDevice *file, qint64 offset = 0, qint64 length = -1);
     bool isValid() const;
     qint64 readBufferSize() const;
     void setReadBufferSize(qint64 size);
@@ -29,7 +29,9 @@ QT_REQUIRE_CONFIG(localserver);
 #elif defined(Q_OS_WIN)
 #   include "private/qwindowspipereader_p.h"
 #   include "private/qwindowspipewriter_p.h"
+#   include "private/qabstractsocket_p.h"
 #   include <qwineventnotifier.h>
+#   include <memory>
 #else
 #   include "private/qabstractsocketengine_p.h"
 #   include <qtcpsocket.h>
@@ -105,6 +107,8 @@ public:
     HANDLE handle;
     QWindowsPipeWriter *pipeWriter;
     QWindowsPipeReader *pipeReader;
+    // Files queued with sendFile(), which pipes can't take directly
+    std::unique_ptr<QSendFileFallback> sendFileFallback;
     QLocalSocket::LocalSocketError error;
 #else
     QLocalUnixSocket unixSocket;
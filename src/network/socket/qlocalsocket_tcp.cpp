@@ -332,6 +332,12 @@ bool QLocalSocket::flush()
     return d->tcpSocket->flush();
 }
 
+qint64 QLocalSocket::sendFile(QFileDevice *file, qint64 offset, qint64 length)
+{
+    Q_D(QLocalSocket);
+    return d->tcpSocket->sendFile(file, offset, length);
+}
+
 void QLocalSocket::disconnectFromServer()
 {
     Q_D(QLocalSocket);
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 
 #include "qlocalsocket_p.h"
+#include <qfiledevice.h>
 #include <qscopedvaluerollback.h>
 #include <qdeadlinetimer.h>
 
@@ -272,6 +273,10 @@ qint64 QLocalSocket::writeData(const char *data, qint64 len)
     if (len == 0)
         return 0;
 
+    // What is written after a file that is sent in blocks goes out after it
+    if (d->sendFileFallback && d->sendFileFallback->enqueueData(data, len))
+        return len;
+
     if (!d->pipeWriter) {
         d->pipeWriter = new QWindowsPipeWriter(d->handle, this);
         QObjectPrivate::connect(d->pipeWriter, &QWindowsPipeWriter::bytesWritten,
@@ -295,6 +300,8 @@ void QLocalSocket::abort()
         delete d->pipeWriter;
         d->pipeWriter = 0;
     }
+    if (d->sendFileFallback)
+        d->sendFileFallback->clear();
     close();
 }
 
@@ -325,6 +332,8 @@ void QLocalSocketPrivate::_q_pipeClosed()
     pipeReader->stop();
     delete pipeWriter;
     pipeWriter = nullptr;
+    if (sendFileFallback)
+        sendFileFallback->clear();
     if (handle != INVALID_HANDLE_VALUE) {
         DisconnectNamedPipe(handle);
         CloseHandle(handle);
@@ -348,7 +357,10 @@ qint64 QLocalSocket::bytesAvailable() const
 qint64 QLocalSocket::bytesToWrite() const
 {
     Q_D(const QLocalSocket);
-    return d->pipeWriterBytesToWrite();
+    qint64 pendingBytes = d->pipeWriterBytesToWrite();
+    if (d->sendFileFallback)
+        pendingBytes += d->sendFileFallback->bytesToWrite();
+    return pendingBytes;
 }
 
 bool QLocalSocket::canReadLine() const
@@ -375,6 +387,53 @@ bool QLocalSocket::flush()
     return d->pipeWriter && d->pipeWriter->checkForWrite();
 }
 
+qint64 QLocalSocket::sendFile(QFileDevice *file, qint64 offset, qint64 length)
+{
+    if (!file || !file->isReadable()) {
+        qWarning("QLocalSocket::sendFile: file is not open for reading");
+        return -1;
+    }
+    if (!isWritable()) {
+        qWarning("QLocalSocket::sendFile: device not open for writing");
+        return -1;
+    }
+    Q_D(QLocalSocket);
+    if (!isValid()) {
+        d->error = OperationError;
+        d->errorString = tr("Socket is not connected");
+        return -1;
+    }
+
+    const qint64 fileSize = file->size();
+    if (offset < 0 || offset > fileSize) {
+        qWarning("QLocalSocket::sendFile: offset %lld is outside of the file", offset);
+        return -1;
+    }
+    if (length < 0 || length > fileSize - offset)
+        length = fileSize - offset;
+    if (length == 0)
+        return 0;
+
+    // data written through the file's own buffer must be in the file first
+    if (file->isWritable())
+        file->flush();
+
+    // Pipes cannot take data straight from a file; write it in blocks as
+    // the pipe writer drains.
+    if (!d->sendFileFallback) {
+        d->sendFileFallback = std::make_unique<QSendFileFallback>(
+                [d] { return d->pipeWriterBytesToWrite(); },
+                [this](const char *data, qint64 size) { return writeData(data, size); },
+                [this, d](const QString &message) {
+                    d->error = UnknownSocketError;
+                    d->errorString = message;
+                    emit errorOccurred(d->error);
+                    abort();
+                });
+    }
+    return d->sendFileFallback->enqueueFile(file, offset, length);
+}
+
 void QLocalSocket::disconnectFromServer()
 {
     Q_D(QLocalSocket);
@@ -420,6 +479,8 @@ void QLocalSocketPrivate::_q_bytesWritten(qint64 bytes)
         QScopedValueRollback<bool> guard(emittedBytesWritten, true);
         emit q->bytesWritten(bytes);
     }
+    if (sendFileFallback)
+        sendFileFallback->feed();
     if (state == QLocalSocket::ClosingState)
         q->disconnectFromServer();
 }
@@ -83,6 +83,7 @@
 #include <qabstracteventdispatcher.h>
 #include <qsocketnotifier.h>
 #include <qnetworkinterface.h>
+#include <qfiledevice.h>
 
 #include <private/qthread_p.h>
 #include <private/qobject_p.h>
@@ -834,6 +835,54 @@ qint64 QNativeSocketEngine::readDatagram(char *data, qint64 maxSize, QIpPacketHe
     return d->nativeReceiveDatagram(data, maxSize, header, options);
 }
 
+#ifndef QT_NO_UDPSOCKET
+/*!
+    Reads up to \a count pending datagrams into \a datagrams. On Linux,
+    the datagrams are received in batches with recvmmsg(); elsewhere this
+    falls back to reading them one by one.
+
+    \sa QAbstractSocketEngine::readDatagrams()
+*/
+qsizetype QNativeSocketEngine::readDatagrams(QNetworkDatagramPrivate *const *datagrams, qsizetype count,
+                                             qint64 maxSize, PacketHeaderOptions options)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::readDatagrams(), -1);
+    Q_CHECK_STATES(QNativeSocketEngine::readDatagrams(), QAbstractSocket::BoundState,
+                   QAbstractSocket::ConnectedState, -1);
+
+#ifdef Q_OS_LINUX
+    return d->nativeReceiveDatagrams(datagrams, count, maxSize, options);
+#else
+    Q_UNUSED(d);
+    return QAbstractSocketEngine::readDatagrams(datagrams, count, maxSize, options);
+#endif
+}
+
+/*!
+    Writes the \a count datagrams in \a datagrams. On Linux, the
+    datagrams are sent in batches with sendmmsg(); elsewhere this falls
+    back to sending them one by one.
+
+    \sa QAbstractSocketEngine::writeDatagrams()
+*/
+qsizetype QNativeSocketEngine::writeDatagrams(const QNetworkDatagramPrivate *const *datagrams,
+                                              qsizetype count)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::writeDatagrams(), -1);
+    Q_CHECK_STATES(QNativeSocketEngine::writeDatagrams(), QAbstractSocket::BoundState,
+                   QAbstractSocket::ConnectedState, -1);
+
+#ifdef Q_OS_LINUX
+    return d->nativeSendDatagrams(datagrams, count);
+#else
+    Q_UNUSED(d);
+    return QAbstractSocketEngine::writeDatagrams(datagrams, count);
+#endif
+}
+#endif // QT_NO_UDPSOCKET
+
 /*!
     Writes a datagram of size \a size bytes to the socket from
     \a data to the destination contained in \a header, and returns the
@@ -883,6 +932,34 @@ qint64 QNativeSocketEngine::write(const char *data, qint64 size)
 }
 
 
+/*!
+    Writes up to \a size bytes of \a file, starting at \a offset, to the
+    socket. On Linux, the kernel copies the data from the file to the
+    socket with sendfile(), without passing it through user space.
+
+    \sa QAbstractSocketEngine::sendFile()
+*/
+qint64 QNativeSocketEngine::sendFile(QFileDevice *file, qint64 offset, qint64 size)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::sendFile(), -1);
+    Q_CHECK_STATE(QNativeSocketEngine::sendFile(), QAbstractSocket::ConnectedState, -1);
+
+#ifdef Q_OS_LINUX
+    const int fd = file->handle();
+    if (fd != -1 && !d->sendFileUnsupported) {
+        const qint64 sent = d->nativeSendFile(fd, offset, size);
+        if (sent != -2)
+            return sent;
+        // this kind of file or socket cannot be used with sendfile()
+        d->sendFileUnsupported = true;
+    }
+#else
+    Q_UNUSED(d);
+#endif
+    return QAbstractSocketEngine::sendFile(file, offset, size);
+}
+
 qint64 QNativeSocketEngine::bytesToWrite() const
 {
     return 0;
@@ -110,6 +110,7 @@ public:
 
     qint64 read(char *data, qint64 maxlen) override;
     qint64 write(const char *data, qint64 len) override;
+    qint64 sendFile(QFileDevice *file, qint64 offset, qint64 len) override;
 
 #ifndef QT_NO_UDPSOCKET
 #ifndef QT_NO_NETWORKINTERFACE
@@ -123,6 +124,10 @@ public:
 
     bool hasPendingDatagrams() const override;
     qint64 pendingDatagramSize() const override;
+
+    qsizetype readDatagrams(QNetworkDatagramPrivate *const *datagrams, qsizetype count,
+                            qint64 maxlen, PacketHeaderOptions options) override;
+    qsizetype writeDatagrams(const QNetworkDatagramPrivate *const *datagrams, qsizetype count) override;
 #endif // QT_NO_UDPSOCKET
 
     qint64 readDatagram(char *data, qint64 maxlen, QIpPacketHeader * = nullptr,
@@ -241,8 +246,18 @@ public:
     qint64 nativeReceiveDatagram(char *data, qint64 maxLength, QIpPacketHeader *header,
                                  QAbstractSocketEngine::PacketHeaderOptions options);
     qint64 nativeSendDatagram(const char *data, qint64 length, const QIpPacketHeader &header);
+#if defined(Q_OS_LINUX) && !defined(QT_NO_UDPSOCKET)
+    qsizetype nativeReceiveDatagrams(QNetworkDatagramPrivate *const *datagrams, qsizetype count,
+                                     qint64 maxLength, QAbstractSocketEngine::PacketHeaderOptions options);
+    qsizetype nativeSendDatagrams(const QNetworkDatagramPrivate *const *datagrams, qsizetype count);
+    QByteArray datagramOverflowBuffer;
+#endif
     qint64 nativeRead(char *data, qint64 maxLength);
     qint64 nativeWrite(const char *data, qint64 length);
+#ifdef Q_OS_LINUX
+    qint64 nativeSendFile(int fileDescriptor, qint64 offset, qint64 length);
+    bool sendFileUnsupported = false;
+#endif
     int nativeSelect(int timeout, bool selectForRead) const;
     int nativeSelect(int timeout, bool checkRead, bool checkWrite,
                      bool *selectForRead, bool *selectForWrite) const;
@@ -220,6 +220,8 @@ static void convertToLevelAndOption(QNativeSocketEngine::SocketOption opt,
 
     case QAbstractSocketEngine::PathMtuInformation:
         break;          // not supported on Windows
+    case QAbstractSocketEngine::ReusePortOption:
+        break;          // SO_REUSEADDR does not balance connections on Windows
     }
 }
 
@@ -81,8 +81,10 @@
 #include "qlist.h"
 #include "qpointer.h"
 #include "qabstractsocketengine_p.h"
+#include "qnativesocketengine_p.h"
 #include "qtcpsocket.h"
 #include "qnetworkproxy.h"
+#include "qthread.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -166,6 +168,216 @@ void QTcpServerPrivate::configureCreatedSocket()
 #endif
 }
 
+#if QT_CONFIG(thread)
+/*! \internal
+
+    An additional listening socket bound to the same address and port as the
+    server's own socket. It lives in a thread of its own and passes the
+    connections it accepts to QTcpServer::incomingConnection() from there.
+*/
+class QTcpServerListener : public QObject, public QAbstractSocketEngineReceiver
+{
+public:
+    explicit QTcpServerListener(QTcpServerPrivate *server) : server(server) {}
+
+    // from QAbstractSocketEngineReceiver
+    void readNotification() override;
+    void closeNotification() override { readNotification(); }
+    void writeNotification() override {}
+    void exceptionNotification() override {}
+    void connectionNotification() override {}
+#ifndef QT_NO_NETWORKPROXY
+    void proxyAuthenticationRequired(const QNetworkProxy &, QAuthenticator *) override {}
+#endif
+
+    QTcpServerPrivate *server;
+    QNativeSocketEngine *socketEngine = nullptr;
+    QAtomicInteger<qint64> accepted = 0;
+};
+
+/*! \internal
+*/
+void QTcpServerListener::readNotification()
+{
+    for (;;) {
+        int descriptor = socketEngine->accept();
+        if (descriptor == -1) {
+            if (socketEngine->error() != QAbstractSocket::TemporaryError) {
+                socketEngine->setReadNotificationEnabled(false);
+                server->listenerError(socketEngine->error(), socketEngine->errorString());
+            }
+            break;
+        }
+#if defined (QTCPSERVER_DEBUG)
+        qDebug("QTcpServerListener::readNotification() accepted socket %i", descriptor);
+#endif
+        accepted.fetchAndAddRelaxed(1);
+        server->listenerAccepted(descriptor);
+    }
+}
+
+/*! \internal
+
+    Creates the additional listeners requested with setListenerCount(), bound
+    to \a address and the port of the server's own socket. Returns \c false
+    and sets the server error if any of them cannot be set up.
+*/
+bool QTcpServerPrivate::startListeners(const QHostAddress &address,
+                                       QAbstractSocket::NetworkLayerProtocol protocol)
+{
+    for (int i = 1; i < listenerCount; ++i) {
+        QTcpServerListener *listener = new QTcpServerListener(this);
+        QNativeSocketEngine *engine = new QNativeSocketEngine(listener);
+        listener->socketEngine = engine;
+
+        bool ok = engine->initialize(socketType, protocol);
+        if (ok) {
+            engine->setOption(QAbstractSocketEngine::AddressReusable, 1);
+            ok = engine->setOption(QAbstractSocketEngine::ReusePortOption, 1)
+                    && engine->bind(address, port)
+                    && engine->listen(listenBacklog);
+        }
+        if (!ok) {
+            serverSocketError = engine->error();
+            serverSocketErrorString = engine->errorString();
+            delete listener;
+            stopListeners();
+            return false;
+        }
+        engine->setReceiver(listener);
+
+        QThread *thread = new QThread;
+        thread->setObjectName(QStringLiteral("QTcpServer listener"));
+        listener->moveToThread(thread);
+        // Both run in the listener's thread, so the socket notifier is
+        // created and destroyed there.
+        QObject::connect(thread, &QThread::started, listener, [listener] {
+            listener->socketEngine->setReadNotificationEnabled(true);
+        });
+        QObject::connect(thread, &QThread::finished, listener, [listener] {
+            delete listener->socketEngine;
+            listener->socketEngine = nullptr;
+        });
+        listenerThreads.append({ thread, listener });
+        thread->start();
+    }
+    return true;
+}
+
+/*! \internal
+
+    Stops the additional listeners and records how many connections each
+    of them accepted.
+*/
+void QTcpServerPrivate::stopListeners()
+{
+    for (const ListenerThread &l : std::as_const(listenerThreads))
+        l.thread->quit();
+    for (qsizetype i = 0; i < listenerThreads.size(); ++i) {
+        const ListenerThread &l = listenerThreads.at(i);
+        l.thread->wait();
+        if (i + 1 < acceptedCounts.size())
+            acceptedCounts[i + 1] = l.listener->accepted.loadRelaxed();
+        delete l.listener;
+        delete l.thread;
+    }
+    listenerThreads.clear();
+
+    QMutexLocker locker(&listenerMutex);
+    closeDescriptors(std::exchange(listenerDescriptors, {}));
+}
+
+/*! \internal
+*/
+void QTcpServerPrivate::setListenersAccepting(bool accepting)
+{
+    for (const ListenerThread &l : std::as_const(listenerThreads)) {
+        QTcpServerListener *listener = l.listener;
+        QMetaObject::invokeMethod(listener, [listener, accepting] {
+            if (listener->socketEngine)
+                listener->socketEngine->setReadNotificationEnabled(accepting);
+        });
+    }
+}
+
+/*! \internal
+
+    Called in a listener's thread for every connection it accepts. The
+    descriptor is queued for the server's thread, since incomingConnection()
+    may be reimplemented by a subclass that is not safe to call from
+    another thread, or that is already being destroyed.
+*/
+void QTcpServerPrivate::listenerAccepted(qintptr descriptor)
+{
+    Q_Q(QTcpServer);
+    QMutexLocker locker(&listenerMutex);
+    listenerDescriptors.append(descriptor);
+    if (listenerDescriptors.size() == 1) {
+        QMetaObject::invokeMethod(q, [this] { processListenerDescriptors(); },
+                                  Qt::QueuedConnection);
+    }
+}
+
+/*! \internal
+
+    Called in the server's thread to hand the connections accepted by the
+    additional listeners to incomingConnection().
+*/
+void QTcpServerPrivate::processListenerDescriptors()
+{
+    Q_Q(QTcpServer);
+    QList<qintptr> descriptors;
+    {
+        QMutexLocker locker(&listenerMutex);
+        descriptors.swap(listenerDescriptors);
+    }
+    for (qsizetype i = 0; i < descriptors.size(); ++i) {
+        QPointer<QTcpServer> that = q;
+        q->incomingConnection(descriptors.at(i));
+
+        if (that)
+            emit q->newConnection();
+
+        if (!that || !q->isListening()) {
+            closeDescriptors(descriptors.sliced(i + 1));
+            return;
+        }
+    }
+}
+
+/*! \internal
+
+    Closes connections that were accepted but never handed on.
+*/
+void QTcpServerPrivate::closeDescriptors(const QList<qintptr> &descriptors)
+{
+    for (qintptr descriptor : descriptors) {
+        QNativeSocketEngine engine;
+        if (engine.initialize(descriptor, QAbstractSocket::ConnectedState))
+            engine.close();
+    }
+}
+
+/*! \internal
+
+    Called in a listener's thread when accepting fails; stops all listeners
+    like readNotification() does for the server's own socket.
+*/
+void QTcpServerPrivate::listenerError(QAbstractSocket::SocketError error,
+                                      const QString &errorString)
+{
+    Q_Q(QTcpServer);
+    QMetaObject::invokeMethod(q, [this, q, error, errorString] {
+        if (!q->isListening())
+            return;
+        q->pauseAccepting();
+        serverSocketError = error;
+        serverSocketErrorString = errorString;
+        emit q->acceptError(error);
+    }, Qt::QueuedConnection);
+}
+#endif // QT_CONFIG(thread)
+
 /*! \internal
 */
 void QTcpServerPrivate::readNotification()
@@ -194,6 +406,8 @@ void QTcpServerPrivate::readNotification()
 #if defined (QTCPSERVER_DEBUG)
         qDebug("QTcpServerPrivate::_q_processIncomingConnection() accepted socket %i", descriptor);
 #endif
+        if (!acceptedCounts.isEmpty())
+            ++acceptedCounts.first();
         QPointer<QTcpServer> that = q;
         q->incomingConnection(descriptor);
 
@@ -303,6 +517,14 @@ bool QTcpServer::listen(const QHostAddress &address, quint16 port)
 
     d->configureCreatedSocket();
 
+    // Additional listeners need the kernel to spread connections among
+    // sockets sharing the port; without that, use a single one.
+    int listeners = 1;
+    if (d->listenerCount > 1
+        && d->socketEngine->setOption(QAbstractSocketEngine::ReusePortOption, 1)) {
+        listeners = d->listenerCount;
+    }
+
     if (!d->socketEngine->bind(addr, port)) {
         d->serverSocketError = d->socketEngine->error();
         d->serverSocketErrorString = d->socketEngine->errorString();
@@ -315,12 +537,21 @@ bool QTcpServer::listen(const QHostAddress &address, quint16 port)
         return false;
     }
 
+    d->address = d->socketEngine->localAddress();
+    d->port = d->socketEngine->localPort();
+    d->acceptedCounts = QList<qint64>(listeners, 0);
+
+#if QT_CONFIG(thread)
+    if (listeners > 1 && !d->startListeners(addr, proto)) {
+        d->socketEngine->close();
+        return false;
+    }
+#endif
+
     d->socketEngine->setReceiver(d);
     d->socketEngine->setReadNotificationEnabled(true);
 
     d->state = QAbstractSocket::ListeningState;
-    d->address = d->socketEngine->localAddress();
-    d->port = d->socketEngine->localPort();
 
 #if defined (QTCPSERVER_DEBUG)
     qDebug("QTcpServer::listen(%i, \"%s\") == true (listening on port %i)", port,
@@ -352,6 +583,10 @@ void QTcpServer::close()
 {
     Q_D(QTcpServer);
 
+#if QT_CONFIG(thread)
+    d->stopListeners();
+#endif
+
     qDeleteAll(d->pendingConnections);
     d->pendingConnections.clear();
 
@@ -426,6 +661,7 @@ bool QTcpServer::setSocketDescriptor(qintptr socketDescriptor)
     d->state = d->socketEngine->state();
     d->address = d->socketEngine->localAddress();
     d->port = d->socketEngine->localPort();
+    d->acceptedCounts = QList<qint64>(1, 0);
 
 #if defined (QTCPSERVER_DEBUG)
     qDebug("QTcpServer::setSocketDescriptor(%i) succeeded.", socketDescriptor);
@@ -567,7 +803,8 @@ QTcpSocket *QTcpServer::nextPendingConnection()
     to the other thread and create the QTcpSocket object there and
     use its setSocketDescriptor() method.
 
-    \sa newConnection(), nextPendingConnection(), addPendingConnection()
+    \sa newConnection(), nextPendingConnection(), addPendingConnection(),
+        setListenerCount()
 */
 void QTcpServer::incomingConnection(qintptr socketDescriptor)
 {
@@ -658,6 +895,73 @@ int QTcpServer::listenBacklogSize() const
     return d_func()->listenBacklog;
 }
 
+/*!
+    Sets the number of listening sockets the server uses to \a count.
+    By default, the server uses one.
+
+    With more than one listener, listen() binds \a count sockets to the
+    same address and port using the \c SO_REUSEPORT socket option, and the
+    operating system distributes incoming connections among them. The
+    first listener accepts connections in the server's thread, as usual;
+    each of the others accepts connections in a thread of its own, so that
+    accepting is spread over several threads. incomingConnection() is
+    always called in the server's thread, though, and that thread's event
+    loop must run for the connections accepted by the other listeners to
+    be delivered. setMaxPendingConnections() only limits the connections
+    accepted by the first listener, and waitForNewConnection() only waits
+    for it.
+
+    This option is only supported on Linux, where the kernel balances
+    connections among sockets sharing a port, and when no proxy is used.
+    Elsewhere the server falls back to a single listener. Note that other
+    sockets of the same user can join the port while the server is
+    listening.
+
+    \note This property must be set prior to calling listen().
+
+    \since 6.5
+
+    \sa listenerCount(), acceptedConnectionCounts()
+*/
+void QTcpServer::setListenerCount(int count)
+{
+    d_func()->listenerCount = qMax(count, 1);
+}
+
+/*!
+    Returns the number of listening sockets requested with
+    setListenerCount(). The default is 1.
+
+    \since 6.5
+
+    \sa setListenerCount()
+*/
+int QTcpServer::listenerCount() const
+{
+    return d_func()->listenerCount;
+}
+
+/*!
+    Returns the number of connections accepted by each of the server's
+    listeners since listen() was last called. The first entry is the
+    listener running in the server's thread; the list has one entry per
+    listener actually in use, which may be fewer than listenerCount().
+
+    \since 6.5
+
+    \sa setListenerCount()
+*/
+QList<qint64> QTcpServer::acceptedConnectionCounts() const
+{
+    Q_D(const QTcpServer);
+    QList<qint64> counts = d->acceptedCounts;
+#if QT_CONFIG(thread)
+    for (qsizetype i = 0; i < d->listenerThreads.size(); ++i)
+        counts[i + 1] = d->listenerThreads.at(i).listener->accepted.loadRelaxed();
+#endif
+    return counts;
+}
+
 /*!
     Returns an error code for the last error that occurred.
 
@@ -688,7 +992,11 @@ QString QTcpServer::errorString() const
 */
 void QTcpServer::pauseAccepting()
 {
-    d_func()->socketEngine->setReadNotificationEnabled(false);
+    Q_D(QTcpServer);
+    d->socketEngine->setReadNotificationEnabled(false);
+#if QT_CONFIG(thread)
+    d->setListenersAccepting(false);
+#endif
 }
 
 /*!
@@ -700,7 +1008,11 @@ void QTcpServer::pauseAccepting()
 */
 void QTcpServer::resumeAccepting()
 {
-    d_func()->socketEngine->setReadNotificationEnabled(true);
+    Q_D(QTcpServer);
+    d->socketEngine->setReadNotificationEnabled(true);
+#if QT_CONFIG(thread)
+    d->setListenersAccepting(true);
+#endif
 }
 
 #ifndef QT_NO_NETWORKPROXY
@@ -36,6 +36,10 @@ public:
     void setListenBacklogSize(int size);
     int listenBacklogSize() const;
 
+    void setListenerCount(int count);
+    int listenerCount() const;
+    QList<qint64> acceptedConnectionCounts() const;
+
     quint16 serverPort() const;
     QHostAddress serverAddress() const;
 
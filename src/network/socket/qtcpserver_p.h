@@ -23,10 +23,14 @@
 #include "QtNetwork/qabstractsocket.h"
 #include "qnetworkproxy.h"
 #include "QtCore/qlist.h"
+#include "QtCore/qmutex.h"
 #include "qhostaddress.h"
 
 QT_BEGIN_NAMESPACE
 
+class QThread;
+class QTcpServerListener;
+
 class Q_NETWORK_EXPORT QTcpServerPrivate : public QObjectPrivate,
                                            public QAbstractSocketEngineReceiver
 {
@@ -50,6 +54,29 @@ public:
     int listenBacklog = 50;
     int maxConnections;
 
+    // Listening sockets sharing the port through SO_REUSEPORT; the first one
+    // is socketEngine, the others each accept in a thread of their own.
+    int listenerCount = 1;
+    QList<qint64> acceptedCounts;
+#if QT_CONFIG(thread)
+    struct ListenerThread {
+        QThread *thread;
+        QTcpServerListener *listener;
+    };
+    QList<ListenerThread> listenerThreads;
+    // Accepted by the listeners, waiting for the server's thread
+    QMutex listenerMutex;
+    QList<qintptr> listenerDescriptors;
+
+    bool startListeners(const QHostAddress &address, QAbstractSocket::NetworkLayerProtocol protocol);
+    void stopListeners();
+    void setListenersAccepting(bool accepting);
+    void listenerAccepted(qintptr descriptor);
+    void processListenerDescriptors();
+    static void closeDescriptors(const QList<qintptr> &descriptors);
+    void listenerError(QAbstractSocket::SocketError error, const QString &errorString);
+#endif
+
 #ifndef QT_NO_NETWORKPROXY
     QNetworkProxy proxy;
     QNetworkProxy resolveProxy(const QHostAddress &address, quint16 port);
@@ -66,6 +66,7 @@
 #include "qnetworkdatagram.h"
 #include "qnetworkinterface.h"
 #include "qabstractsocket_p.h"
+#include "qvarlengtharray.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -395,6 +396,63 @@ qint64 QUdpSocket::writeDatagram(const QNetworkDatagram &datagram)
     return sent;
 }
 
+/*!
+    \since 6.5
+
+    Sends the \a count datagrams in the array \a datagrams, as if by calling
+    writeDatagram() for each of them, and returns the number of datagrams
+    sent. On platforms that support it, several datagrams are handed to the
+    operating system at once, which is considerably cheaper than sending
+    them one by one.
+
+    Fewer than \a count datagrams are sent if the socket's send buffer
+    fills up. There is no signal telling when it has room again, so send
+    the remaining ones later, for instance from a timer. If the buffer is
+    full before any datagram could be sent, this function returns -1 and
+    error() returns QAbstractSocket::TemporaryError, like writeDatagram()
+    does; it also returns -1 if any other error occurs before the first
+    datagram is sent.
+
+    The bytesWritten() signal is emitted once, before this function
+    returns, with the total size of the datagrams sent.
+
+    \sa writeDatagram(), receiveDatagrams()
+*/
+qsizetype QUdpSocket::writeDatagrams(const QNetworkDatagram *datagrams, qsizetype count)
+{
+    Q_D(QUdpSocket);
+#if defined QUDPSOCKET_DEBUG
+    qDebug("QUdpSocket::writeDatagrams(%p, %lld)", datagrams, qlonglong(count));
+#endif
+    if (count <= 0)
+        return 0;
+    if (!d->doEnsureInitialized(QHostAddress::Any, 0, datagrams[0].destinationAddress()))
+        return -1;
+    if (state() == UnconnectedState)
+        bind();
+
+    QVarLengthArray<const QNetworkDatagramPrivate *, 64> privates(count);
+    for (qsizetype i = 0; i < count; ++i)
+        privates[i] = datagrams[i].d;
+
+    const qsizetype sent = d->socketEngine->writeDatagrams(privates.constData(), count);
+    d->cachedSocketDescriptor = d->socketEngine->socketDescriptor();
+
+    if (sent > 0) {
+        qint64 bytes = 0;
+        for (qsizetype i = 0; i < sent; ++i)
+            bytes += datagrams[i].d->data.size();
+        emit bytesWritten(bytes);
+    } else if (sent == 0) {
+        // The send buffer is full. Treat as a temporary error.
+        d->setErrorAndEmit(QAbstractSocket::TemporaryError, tr("Unable to send a datagram"));
+        return -1;
+    } else {
+        d->setErrorAndEmit(d->socketEngine->error(), d->socketEngine->errorString());
+    }
+    return sent;
+}
+
 /*!
     \since 5.8
 
@@ -440,6 +498,48 @@ QNetworkDatagram QUdpSocket::receiveDatagram(qint64 maxSize)
     return result;
 }
 
+/*!
+    \since 6.5
+
+    Receives up to \a count pending datagrams into the array \a datagrams,
+    as if by calling receiveDatagram() with \a maxSize for each of them,
+    and returns the number of datagrams received. On platforms that support
+    it, several datagrams are fetched from the operating system at once,
+    which is considerably cheaper than receiving them one by one.
+
+    Returns 0 if no datagram was pending, and -1 if an error occurred
+    before any datagram could be received. The contents of the entries
+    past the last datagram received are unspecified.
+
+    \sa receiveDatagram(), writeDatagrams(), hasPendingDatagrams()
+*/
+qsizetype QUdpSocket::receiveDatagrams(QNetworkDatagram *datagrams, qsizetype count, qint64 maxSize)
+{
+    Q_D(QUdpSocket);
+
+#if defined QUDPSOCKET_DEBUG
+    qDebug("QUdpSocket::receiveDatagrams(%p, %lld, %lld)", datagrams, qlonglong(count), maxSize);
+#endif
+    QT_CHECK_BOUND("QUdpSocket::receiveDatagrams()", -1);
+    if (count <= 0)
+        return 0;
+
+    QVarLengthArray<QNetworkDatagramPrivate *, 64> privates(count);
+    for (qsizetype i = 0; i < count; ++i) {
+        if (!datagrams[i].d)
+            datagrams[i].d = new QNetworkDatagramPrivate;
+        privates[i] = datagrams[i].d;
+    }
+
+    const qsizetype received = d->socketEngine->readDatagrams(privates.constData(), count, maxSize,
+                                                              QAbstractSocketEngine::WantAll);
+    d->hasPendingData = false;
+    d->socketEngine->setReadNotificationEnabled(true);
+    if (received < 0)
+        d->setErrorAndEmit(d->socketEngine->error(), d->socketEngine->errorString());
+    return received;
+}
+
 /*!
     Receives a datagram no larger than \a maxSize bytes and stores
     it in \a data. The sender's host address and port is stored in
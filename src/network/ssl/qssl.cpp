@@ -117,7 +117,16 @@ Q_LOGGING_CATEGORY(lcSsl, "qt.network.ssl");
     option can allow connections for legacy servers, but it introduces the
     possibility that an attacker could inject plaintext into the SSL session.
     \value SslOptionDisableSessionSharing Disables SSL session sharing via
-    the session ID handshake attribute.
+    the session ID handshake attribute. With the OpenSSL backend, this also
+    keeps client connections out of the process-wide session cache, which
+    otherwise lets a new connection to the same peer, with the same
+    configuration, resume the session of an earlier one. Only sessions
+    established without any SSL errors are cached. The cache holds 256
+    sessions; set the \c QT_SSL_SESSION_CACHE_SIZE environment variable to
+    change that, or to 0 to disable the cache. On the server side, the
+    OpenSSL backend otherwise shares the keys protecting session tickets
+    among all server sockets of the process, so that clients can resume
+    their sessions on a new connection; the keys are replaced every hour.
     \value SslOptionDisableSessionPersistence Disables storing the SSL session
     in ASN.1 format as returned by QSslConfiguration::sessionTicket(). Enabling
     this feature adds memory overhead of approximately 1K per used session
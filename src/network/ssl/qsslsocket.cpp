@@ -802,7 +802,10 @@ qint64 QSslSocket::bytesToWrite() const
     Q_D(const QSslSocket);
     if (d->mode == UnencryptedMode)
         return d->plainSocket ? d->plainSocket->bytesToWrite() : 0;
-    return d->writeBuffer.size();
+    qint64 pendingBytes = d->writeBuffer.size();
+    if (d->sendFileFallback)
+        pendingBytes += d->sendFileFallback->bytesToWrite();
+    return pendingBytes;
 }
 
 /*!
@@ -866,6 +869,10 @@ void QSslSocket::close()
 
     if (!d->abortCalled && (encryptedBytesToWrite() || !d->writeBuffer.isEmpty()))
         flush();
+    // Unlike what's already been encrypted, files queued with sendFile()
+    // are not sent after close()
+    if (d->sendFileFallback)
+        d->sendFileFallback->clear();
     if (d->plainSocket) {
         if (d->abortCalled)
             d->plainSocket->abort();
@@ -1895,7 +1902,7 @@ void QSslSocket::disconnectFromHost()
         emit stateChanged(d->state);
     }
 
-    if (!d->writeBuffer.isEmpty()) {
+    if (!d->writeBuffer.isEmpty() || (d->sendFileFallback && !d->sendFileFallback->isEmpty())) {
         d->pendingClose = true;
         return;
     }
@@ -1944,6 +1951,10 @@ qint64 QSslSocket::writeData(const char *data, qint64 len)
     if (d->mode == UnencryptedMode && !d->autoStartHandshake)
         return d->plainSocket->write(data, len);
 
+    // What is written after a file that is sent in blocks goes out after it
+    if (d->sendFileFallback && d->sendFileFallback->enqueueData(data, len))
+        return len;
+
     d->write(data, len);
 
     // make sure we flush to the plain socket's buffer
@@ -2578,8 +2589,12 @@ void QSslSocketPrivate::_q_bytesWrittenSlot(qint64 written)
         emit q->bytesWritten(written);
     else
         emit q->encryptedBytesWritten(written);
-    if (state == QAbstractSocket::ClosingState && writeBuffer.isEmpty())
+    if (sendFileFallback)
+        sendFileFallback->feed();
+    if (state == QAbstractSocket::ClosingState && writeBuffer.isEmpty()
+        && (!sendFileFallback || sendFileFallback->isEmpty())) {
         q->disconnectFromHost();
+    }
 }
 
 /*!
@@ -2844,6 +2859,22 @@ bool QSslSocketPrivate::flush()
     return plainSocket && plainSocket->flush();
 }
 
+/*!
+    \internal
+
+    Unencrypted data goes to the plain socket, which can send \a file
+    without copying it; anything else has to pass through the TLS layer,
+    a block at a time as the encrypted data goes out.
+*/
+qint64 QSslSocketPrivate::sendFile(QFileDevice *file, qint64 offset, qint64 length)
+{
+    if (mode == QSslSocket::UnencryptedMode && !autoStartHandshake && plainSocket)
+        return plainSocket->sendFile(file, offset, length);
+    return sendFileInBlocks(file, offset, length, [this] {
+        return writeBuffer.size() + (plainSocket ? plainSocket->bytesToWrite() : 0);
+    });
+}
+
 /*!
     \internal
 */
@@ -118,6 +118,7 @@ public:
     qint64 peek(char *data, qint64 maxSize) override;
     QByteArray peek(qint64 maxSize) override;
     bool flush() override;
+    qint64 sendFile(QFileDevice *file, qint64 offset, qint64 length) override;
 
     void startClientEncryption();
     void startServerEncryption();
@@ -19,6 +19,10 @@
 
 #include <QtNetwork/private/qssldiffiehellmanparameters_p.h>
 
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdeadlinetimer.h>
+#include <QtCore/qmutex.h>
+
 #include <vector>
 
 QT_BEGIN_NAMESPACE
@@ -53,6 +57,54 @@ extern "C" int q_verify_cookie_callback(SSL *ssl, const unsigned char *cookie,
 extern "C" int q_ssl_sess_set_new_cb(SSL *context, SSL_SESSION *session);
 #endif // TLS1_3_VERSION
 
+// Every server-side socket has an SSL_CTX of its own. For a client to
+// resume its session on a new connection, all of them have to decrypt each
+// other's session tickets, so they share these keys. They are replaced
+// every hour, so that a leaked key only exposes the sessions of that hour;
+// tickets issued with older keys just lead to a full handshake.
+namespace {
+struct ServerSessionTicketKeys
+{
+    static constexpr std::chrono::hours Lifetime{1};
+
+    QByteArray current()
+    {
+        QMutexLocker locker(&mutex);
+        if (keys.isEmpty() || expiry.hasExpired()) {
+            keys.resize(80); // name, HMAC and AES keys
+            if (q_RAND_bytes(reinterpret_cast<unsigned char *>(keys.data()), keys.size()) != 1)
+                keys.clear();
+            expiry.setRemainingTime(Lifetime);
+        }
+        return keys;
+    }
+
+    QMutex mutex;
+    QByteArray keys;
+    QDeadlineTimer expiry;
+};
+} // unnamed namespace
+
+Q_GLOBAL_STATIC(ServerSessionTicketKeys, serverSessionTicketKeys)
+
+// Ties the sessions of a server to the parts of its configuration deciding
+// which clients it accepts, so that they cannot be resumed elsewhere.
+static QByteArray serverSessionIdContext(const QSslConfiguration &configuration)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(configuration.localCertificate().toDer());
+    const int verification[] = { int(configuration.peerVerifyMode()),
+                                 configuration.peerVerifyDepth(),
+                                 int(configuration.missingCertificateIsFatal()) };
+    hash.addData(QByteArrayView(reinterpret_cast<const char *>(verification), sizeof verification));
+    if (configuration.peerVerifyMode() == QSslSocket::VerifyPeer) {
+        for (const QSslCertificate &certificate : configuration.caCertificates())
+            hash.addData(certificate.digest(QCryptographicHash::Sha256));
+    }
+    static_assert(SSL_MAX_SID_CTX_LENGTH == 32);
+    return hash.result();
+}
+
 static inline QString msgErrorSettingBackendConfig(const QString &why)
 {
     return QSslSocket::tr("Error when setting the OpenSSL configuration (%1)").arg(why);
@@ -672,6 +724,22 @@ QT_WARNING_POP
 
 #endif // TLS1_3_VERSION
 
+    // Let clients resume their sessions with any socket of this server
+    if (mode == QSslSocket::SslServerMode && !isDtls) {
+        const QByteArray sessionIdContext = serverSessionIdContext(sslContext->sslConfiguration);
+        q_SSL_CTX_set_session_id_context(sslContext->ctx,
+                                         reinterpret_cast<const unsigned char *>(sessionIdContext.constData()),
+                                         sessionIdContext.size());
+        if (!configuration.testSslOption(QSsl::SslOptionDisableSessionTickets)
+            && !configuration.testSslOption(QSsl::SslOptionDisableSessionSharing)) {
+            QByteArray ticketKeys = serverSessionTicketKeys->current();
+            if (!ticketKeys.isEmpty()) {
+                q_SSL_CTX_ctrl(sslContext->ctx, SSL_CTRL_SET_TLSEXT_TICKET_KEYS, ticketKeys.size(),
+                               ticketKeys.data());
+            }
+        }
+    }
+
 #if QT_CONFIG(dtls)
     // DTLS cookies:
     if (mode == QSslSocket::SslServerMode && isDtls && configuration.dtlsCookieVerificationEnabled()) {
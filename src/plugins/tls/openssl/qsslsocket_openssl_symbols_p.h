@@ -412,6 +412,7 @@ int q_SSL_CTX_set_cipher_list(SSL_CTX *a, const char *b);
 int q_SSL_CTX_set_default_verify_paths(SSL_CTX *a);
 void q_SSL_CTX_set_verify(SSL_CTX *a, int b, int (*c)(int, X509_STORE_CTX *));
 void q_SSL_CTX_set_verify_depth(SSL_CTX *a, int b);
+int q_SSL_CTX_set_session_id_context(SSL_CTX *a, const unsigned char *b, unsigned int c);
 extern "C" {
 typedef void (*GenericCallbackType)();
 }
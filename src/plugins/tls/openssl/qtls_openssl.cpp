@@ -18,6 +18,8 @@
 
 #include <QtCore/qscopedvaluerollback.h>
 #include <QtCore/qscopeguard.h>
+#include <QtCore/qcache.h>
+#include <QtCore/qmutex.h>
 
 #include <algorithm>
 #include <cstring>
@@ -64,6 +66,53 @@ QSsl::AlertType tlsAlertType(int value)
     return QSsl::AlertType(value & 0xff);
 }
 
+// Client sessions shared by all sockets of the process, so that connecting
+// to a peer again resumes the previous session even if the application does
+// not copy QSslConfiguration::sessionTicket() around. Sessions are kept in
+// their ASN.1 form, so that no OpenSSL object outlives the library at exit.
+class ClientSessionCache
+{
+public:
+    ClientSessionCache()
+    {
+        bool ok = false;
+        const int size = qEnvironmentVariableIntValue("QT_SSL_SESSION_CACHE_SIZE", &ok);
+        cache.setMaxCost(ok ? qMax(size, 0) : 256);
+    }
+
+    bool isEnabled() const { return cache.maxCost() > 0; }
+
+    // A session is handed out once: TLS 1.3 tickets must not be reused,
+    // and the connection resuming it puts its own session back.
+    QByteArray take(const QString &key, const QSslConfiguration &configuration)
+    {
+        QMutexLocker locker(&mutex);
+        const std::unique_ptr<Entry> entry(cache.take(key));
+        if (!entry || entry->configuration != configuration)
+            return {};
+        return entry->session;
+    }
+
+    void insert(const QString &key, const QSslConfiguration &configuration,
+                const QByteArray &session)
+    {
+        QMutexLocker locker(&mutex);
+        cache.insert(key, new Entry{ configuration, session });
+    }
+
+private:
+    struct Entry
+    {
+        QSslConfiguration configuration;
+        QByteArray session;
+    };
+
+    QMutex mutex;
+    QCache<QString, Entry> cache;
+};
+
+Q_GLOBAL_STATIC(ClientSessionCache, clientSessionCache)
+
 #ifdef Q_OS_WIN
 
 QSslCertificate findCertificateToFetch(const QList<QSslError> &tlsErrors, bool checkAIA)
@@ -702,6 +751,8 @@ bool TlsCryptographOpenSSL::startHandshake()
 
     if (!errors.isEmpty()) {
         sslErrors = errors;
+        // Resuming would skip verification, and with it these errors
+        sessionCacheKey.clear();
 #ifdef Q_OS_WIN
         const bool fetchEnabled = QSslSocketPrivate::rootCertOnDemandLoadingSupported()
                                   && d->isRootsOnDemandAllowed();
@@ -800,6 +851,8 @@ void TlsCryptographOpenSSL::continueHandshake()
     }
 #endif // QT_DECRYPT_SSL_TRAFFIC
 
+    cacheClientSession();
+
     const auto &configuration = q->sslConfiguration();
     // Cache this SSL session inside the QSslContext
     if (!(configuration.testSslOption(QSsl::SslOptionDisableSessionSharing))) {
@@ -1219,6 +1272,29 @@ bool TlsCryptographOpenSSL::checkSslErrors()
     return true;
 }
 
+void TlsCryptographOpenSSL::cacheClientSession()
+{
+    if (sessionCacheKey.isEmpty() || !ssl)
+        return;
+
+    SSL_SESSION *session = q_SSL_get_session(ssl);
+    if (!session)
+        return;
+#ifdef TLS1_3_VERSION
+    if (!q_SSL_SESSION_is_resumable(session))
+        return;
+#endif // TLS1_3_VERSION
+
+    const int sessionSize = q_i2d_SSL_SESSION(session, nullptr);
+    if (sessionSize <= 0)
+        return;
+    QByteArray asn1(sessionSize, Qt::Uninitialized);
+    auto data = reinterpret_cast<unsigned char *>(asn1.data());
+    if (!q_i2d_SSL_SESSION(session, &data))
+        return;
+    clientSessionCache()->insert(sessionCacheKey, sessionCacheConfiguration, asn1);
+}
+
 int TlsCryptographOpenSSL::handleNewSessionTicket(SSL *connection)
 {
     // If we return 1, this means we own the session, but we don't.
@@ -1229,6 +1305,9 @@ int TlsCryptographOpenSSL::handleNewSessionTicket(SSL *connection)
     Q_ASSERT(q);
     Q_ASSERT(d);
 
+    // With TLS 1.3, the session only becomes resumable now
+    cacheClientSession();
+
     if (q->sslConfiguration().testSslOption(QSsl::SslOptionDisableSessionPersistence)) {
         // We silently ignore, do nothing, remove from cache.
         return 0;
@@ -1405,6 +1484,30 @@ bool TlsCryptographOpenSSL::initSslContext()
         }
     }
 
+    // Resume the session of an earlier connection to the same peer, unless
+    // the application manages sessions itself.
+    sessionCacheKey.clear();
+    if (mode == QSslSocket::SslClientMode && !q_SSL_get_session(ssl)
+        && configuration.sessionTicket().isEmpty()
+        && !configuration.testSslOption(QSsl::SslOptionDisableSessionSharing)
+        && clientSessionCache()->isEnabled()) {
+        const auto verificationPeerName = d->verificationName();
+        const QString peerName = verificationPeerName.isEmpty() ? q->peerName() : verificationPeerName;
+        if (!peerName.isEmpty()) {
+            sessionCacheKey = peerName + u':' + QString::number(q->peerPort());
+            sessionCacheConfiguration = configuration;
+            const QByteArray asn1 = clientSessionCache()->take(sessionCacheKey, configuration);
+            auto data = reinterpret_cast<const unsigned char *>(asn1.constData());
+            if (!asn1.isEmpty()) {
+                if (SSL_SESSION *session = q_d2i_SSL_SESSION(nullptr, &data, asn1.size())) {
+                    if (!q_SSL_set_session(ssl, session))
+                        qCWarning(lcTlsBackend, "could not set SSL session");
+                    q_SSL_SESSION_free(session);
+                }
+            }
+        }
+    }
+
     // Clear the session.
     errorList.clear();
 
@@ -99,6 +99,7 @@ private:
     // easier (see qsslsocket_openssl.cpp, while it exists).
     bool initSslContext();
     void destroySslContext();
+    void cacheClientSession();
 
     std::shared_ptr<QSslContext> sslContextPointer;
     SSL *ssl = nullptr; // TLSTODO: RAII.
@@ -130,6 +131,11 @@ private:
 
     bool inSslRead = false;
     bool renegotiated = false;
+
+    // Where this connection's session goes in the process-wide client
+    // session cache; empty if the connection does not use the cache.
+    QString sessionCacheKey;
+    QSslConfiguration sessionCacheConfiguration;
 };
 
 } // namespace QTlsPrivate
@@ -81,14 +81,20 @@ bool QDomBuilder::parseDTD(const QString &dtd)
     return true;
 }
 
-bool QDomBuilder::startElement(const QString &nsURI, const QString &qName,
+bool QDomBuilder::startElement(QStringView nsURI, const QString &qName,
                                const QXmlStreamAttributes &atts)
 {
-    QDomNodePrivate *n =
-            nsProcessing ? doc->createElementNS(nsURI, qName) : doc->createElement(qName);
+    QDomNodePrivate *n = nsProcessing ? doc->createElementNS(internedName(nsURI), qName)
+                                      : doc->createElement(qName);
     if (!n)
         return false;
 
+    // Splitting a prefixed name creates new strings for both parts
+    if (!n->prefix.isEmpty()) {
+        n->prefix = internedName(n->prefix);
+        n->name = internedName(n->name);
+    }
+
     n->setLocation(int(reader->lineNumber()), int(reader->columnNumber()));
 
     node->appendChild(n);
@@ -98,11 +104,11 @@ bool QDomBuilder::startElement(const QString &nsURI, const QString &qName,
     for (const auto &attr : atts) {
         auto domElement = static_cast<QDomElementPrivate *>(node);
         if (nsProcessing) {
-            domElement->setAttributeNS(attr.namespaceUri().toString(),
-                                       attr.qualifiedName().toString(),
+            domElement->setAttributeNS(internedName(attr.namespaceUri()),
+                                       internedName(attr.qualifiedName()),
                                        attr.value().toString());
         } else {
-            domElement->setAttribute(attr.qualifiedName().toString(),
+            domElement->setAttribute(internedName(attr.qualifiedName()),
                                      attr.value().toString());
         }
     }
@@ -178,6 +184,25 @@ QDomBuilder::ErrorInfo QDomBuilder::error() const
     return ErrorInfo(errorMsg, errorLine, errorColumn);
 }
 
+/*!
+    \internal
+
+    Returns a QString with the contents of \a name that shares its data with
+    all other names of the same value created by this builder. A null \a name
+    stays null, as that distinguishes "no namespace" from an empty one.
+*/
+QString QDomBuilder::internedName(QStringView name)
+{
+    if (name.isNull())
+        return QString();
+    auto it = names.constFind(name);
+    if (it == names.cend()) {
+        QString string = name.toString();
+        it = names.insert(QStringView(string), string);
+    }
+    return *it;
+}
+
 bool QDomBuilder::startEntity(const QString &name)
 {
     entityName = name;
@@ -337,9 +362,8 @@ bool QDomParser::parseBody()
     while (!reader->atEnd() && !reader->hasError()) {
         switch (reader->tokenType()) {
         case QXmlStreamReader::StartElement:
-            tagStack.push(reader->qualifiedName().toString());
-            if (!domBuilder.startElement(reader->namespaceUri().toString(),
-                                         reader->qualifiedName().toString(),
+            tagStack.push(domBuilder.internedName(reader->qualifiedName()));
+            if (!domBuilder.startElement(reader->namespaceUri(), tagStack.top(),
                                          reader->attributes())) {
                 domBuilder.fatalError(
                         QDomParser::tr("Error occurred while processing a start element"));
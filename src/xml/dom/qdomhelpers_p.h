@@ -4,6 +4,8 @@
 #define QDOMHELPERS_P_H
 
 #include <qcoreapplication.h>
+#include <qhash.h>
+#include <qstring.h>
 #include <private/qglobal_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -37,7 +39,7 @@ public:
     ~QDomBuilder();
 
     bool endDocument();
-    bool startElement(const QString &nsURI, const QString &qName, const QXmlStreamAttributes &atts);
+    bool startElement(QStringView nsURI, const QString &qName, const QXmlStreamAttributes &atts);
     bool endElement();
     bool characters(const QString &characters, bool cdata = false);
     bool processingInstruction(const QString &target, const QString &data);
@@ -57,6 +59,8 @@ public:
     using ErrorInfo = std::tuple<QString, int, int>;
     ErrorInfo error() const;
 
+    QString internedName(QStringView name);
+
     QString errorMsg;
     int errorLine;
     int errorColumn;
@@ -69,6 +73,11 @@ private:
     QXmlStreamReader *reader;
     QString entityName;
     bool nsProcessing;
+
+    // Element and attribute names, prefixes and namespace URIs repeat a lot
+    // in typical documents. The nodes created while parsing share a single
+    // copy of each of them; the keys are views into the values.
+    QHash<QStringView, QString> names;
 };
 
 /**************************************************************
@@ -3294,6 +3294,14 @@ void tst_QFile::mapOpenMode_data()
     QTest::newRow("ReadWrite,Unbuffered") << int(QIODevice::ReadWrite | QIODevice::Unbuffered) << int(QFileDevice::NoOptions);
     QTest::newRow("ReadOnly + MapPrivate") << int(QIODevice::ReadOnly) << int(QFileDevice::MapPrivateOption);
     QTest::newRow("ReadWrite + MapPrivate") << int(QIODevice::ReadWrite) << int(QFileDevice::MapPrivateOption);
+    QTest::newRow("ReadOnly + MapPrefault") << int(QIODevice::ReadOnly) << int(QFileDevice::MapPrefaultOption);
+    QTest::newRow("ReadWrite + MapPrefault") << int(QIODevice::ReadWrite) << int(QFileDevice::MapPrefaultOption);
+    QTest::newRow("ReadWrite + MapPrivate + MapPrefault") << int(QIODevice::ReadWrite)
+        << int(QFileDevice::MapPrivateOption | QFileDevice::MapPrefaultOption);
+    QTest::newRow("ReadOnly + MapSequentialAccess") << int(QIODevice::ReadOnly) << int(QFileDevice::MapSequentialAccessOption);
+    QTest::newRow("ReadWrite + MapRandomAccess") << int(QIODevice::ReadWrite) << int(QFileDevice::MapRandomAccessOption);
+    QTest::newRow("ReadOnly + both access hints") << int(QIODevice::ReadOnly)
+        << int(QFileDevice::MapSequentialAccessOption | QFileDevice::MapRandomAccessOption);
 }
 
 void tst_QFile::mapOpenMode()
@@ -4,14 +4,20 @@
 
 #include <QTest>
 #include <QSignalSpy>
+#include <QCborArray>
+#include <QCborMap>
 #include <QJsonArray>
 #include <qdir.h>
 #include <qendian.h>
 #include <qpluginloader.h>
+#include <qtemporarydir.h>
 #include <qtemporaryfile.h>
 #include <QScopeGuard>
 #include "theplugin/plugininterface.h"
 
+#ifdef QT_BUILD_INTERNAL
+#  include <QtCore/private/qplugin_p.h>
+#endif
 #if defined(QT_BUILD_INTERNAL) && defined(Q_OF_MACH_O)
 #  include <QtCore/private/qmachparser_p.h>
 #endif
@@ -206,6 +212,11 @@ private slots:
     void preloadedPlugin_data();
     void preloadedPlugin();
     void staticPlugins();
+    void metaDataCache();
+    void metaDataCacheCorrupt_data();
+    void metaDataCacheCorrupt();
+    void metaDataCacheDisabled_data();
+    void metaDataCacheDisabled();
 };
 
 Q_IMPORT_PLUGIN(StaticPlugin)
@@ -1104,6 +1115,233 @@ void tst_QPluginLoader::staticPlugins()
     QCOMPARE(metaData.value("URI").toString(), "qt.test.pluginloader.staticplugin");
 }
 
+#ifdef QT_BUILD_INTERNAL
+extern void qt_resetPluginMetaDataCache();
+
+static constexpr char CacheVariable[] = "QT_PLUGIN_METADATA_CACHE";
+static constexpr QLatin1StringView CachePluginsKey("plugins");
+
+static QString pluginClassName(const QString &fileName)
+{
+    return QPluginLoader(fileName).metaData().value("className").toString();
+}
+
+static bool setModificationTime(const QString &fileName, const QDateTime &time)
+{
+    QFile file(fileName);
+    return file.open(QIODevice::ReadWrite)
+            && file.setFileTime(time, QFileDevice::FileModificationTime);
+}
+
+static QStringList cachedPlugins(const QString &cacheFile)
+{
+    QFile file(cacheFile);
+    if (!file.open(QIODevice::ReadOnly))
+        return {};
+    QStringList plugins;
+    const QCborMap cache = QCborValue::fromCbor(file.readAll()).toMap();
+    for (auto it : cache.value(CachePluginsKey).toMap())
+        plugins.append(it.first.toString());
+    plugins.sort();
+    return plugins;
+}
+
+// The cache file maps the plugin file names to [size, mtime, inode, device,
+// metadata] arrays. Change the class name in every entry's metadata, to tell
+// whether QPluginLoader took a plugin's metadata from the cache.
+static bool markCachedClassNames(const QString &cacheFile)
+{
+    QFile file(cacheFile);
+    if (!file.open(QIODevice::ReadWrite))
+        return false;
+    QCborMap cache = QCborValue::fromCbor(file.readAll()).toMap();
+    QCborMap plugins = cache.value(CachePluginsKey).toMap();
+    for (auto it = plugins.begin(); it != plugins.end(); ++it) {
+        QCborArray entry = it.value().toArray();
+        QCborMap metaData = entry.at(4).toMap();
+        metaData.insert(int(QtPluginMetaDataKeys::ClassName), QLatin1StringView("CachedPlugin"));
+        entry[4] = metaData;
+        it.value() = entry;
+    }
+    cache.insert(CachePluginsKey, plugins);
+    const QByteArray data = cache.toCborValue().toCbor();
+    return file.resize(0) && file.seek(0) && file.write(data) == data.size();
+}
+#endif // QT_BUILD_INTERNAL
+
+void tst_QPluginLoader::metaDataCache()
+{
+#if !defined(QT_SHARED)
+    QSKIP("This test requires a shared build of Qt, as QPluginLoader::setFileName is a no-op in static builds");
+#elif !defined(QT_BUILD_INTERNAL)
+    QSKIP("This test requires a developer build of Qt");
+#else
+    QTemporaryDir dir;
+    QVERIFY2(dir.isValid(), qPrintable(dir.errorString()));
+    const QString cacheFile = dir.filePath("cache.cbor");
+    const QString plugin = QDir(dir.path()).canonicalPath() + "/" PREFIX "theplugin" SUFFIX;
+    const QString removedPlugin = QDir(dir.path()).canonicalPath() + "/" PREFIX "removedplugin" SUFFIX;
+    QVERIFY(QFile::copy(sys_qualifiedLibraryName("theplugin"), plugin));
+    QVERIFY(QFile::copy(sys_qualifiedLibraryName("theplugin"), removedPlugin));
+    const QDateTime mtime(QDate(2020, 1, 1), QTime(12, 0), Qt::UTC);
+    QVERIFY(setModificationTime(plugin, mtime));
+
+    qputenv(CacheVariable, QFile::encodeName(cacheFile));
+    qt_resetPluginMetaDataCache();
+    auto restoreEnvironment = qScopeGuard([] {
+        qunsetenv(CacheVariable);
+        qt_resetPluginMetaDataCache();
+    });
+
+    // The first scans read the plugins and fill the cache
+    QCOMPARE(pluginClassName(plugin), "ThePlugin");
+    QCOMPARE(pluginClassName(removedPlugin), "ThePlugin");
+    qt_resetPluginMetaDataCache();
+    QCOMPARE(cachedPlugins(cacheFile), QStringList({ removedPlugin, plugin }));
+
+    // Later ones find the metadata there
+    QVERIFY(markCachedClassNames(cacheFile));
+    QCOMPARE(pluginClassName(plugin), "CachedPlugin");
+
+    // unless the plugin was modified since
+    QVERIFY(setModificationTime(plugin, mtime.addSecs(1)));
+    QCOMPARE(pluginClassName(plugin), "ThePlugin");
+
+    qt_resetPluginMetaDataCache();
+    QVERIFY(markCachedClassNames(cacheFile));
+    QCOMPARE(pluginClassName(plugin), "CachedPlugin");
+    {
+        // even if its modification time is the same
+        QFile file(plugin);
+        QVERIFY(file.open(QIODevice::Append));
+        QCOMPARE(file.write("", 1), 1);
+    }
+    QVERIFY(setModificationTime(plugin, mtime.addSecs(1)));
+    QCOMPARE(pluginClassName(plugin), "ThePlugin");
+
+    // The entries of plugins that are gone are dropped when the cache is
+    // written, even if nothing else changed
+    qt_resetPluginMetaDataCache();
+    QVERIFY(QFile::remove(removedPlugin));
+    QCOMPARE(pluginClassName(plugin), "ThePlugin");
+    qt_resetPluginMetaDataCache();
+    QCOMPARE(cachedPlugins(cacheFile), QStringList{ plugin });
+#endif
+}
+
+void tst_QPluginLoader::metaDataCacheCorrupt_data()
+{
+    QTest::addColumn<QByteArray>("contents");
+
+    const QCborArray entry = { 1, 2, 3, 4, QCborMap() };
+    const QByteArray cache = QCborMap{
+        { QLatin1StringView("qt"), QT_VERSION },
+        { QLatin1StringView("plugins"), QCborMap{ { QLatin1StringView("/nowhere/plugin" SUFFIX), entry } } }
+    }.toCborValue().toCbor();
+    const QCborMap badEntries = {
+        { QLatin1StringView("a"), 1 },
+        { QLatin1StringView("b"), QCborArray{ 1, 2 } },
+        { QLatin1StringView("c"), QCborArray{ "x", "y", "z", "w", QCborMap() } },
+    };
+
+    QTest::newRow("empty") << QByteArray();
+    QTest::newRow("garbage") << QByteArray("this is not CBOR");
+    QTest::newRow("not-a-map") << QCborValue(42).toCbor();
+    QTest::newRow("truncated") << cache.left(cache.size() / 2);
+    QTest::newRow("other-version")
+            << QCborMap{ { QLatin1StringView("qt"), QT_VERSION - 1 },
+                         { QLatin1StringView("plugins"), QCborMap{} } }.toCborValue().toCbor();
+    QTest::newRow("bad-entries")
+            << QCborMap{ { QLatin1StringView("qt"), QT_VERSION },
+                         { QLatin1StringView("plugins"), badEntries } }.toCborValue().toCbor();
+}
+
+void tst_QPluginLoader::metaDataCacheCorrupt()
+{
+#if !defined(QT_SHARED)
+    QSKIP("This test requires a shared build of Qt, as QPluginLoader::setFileName is a no-op in static builds");
+#elif !defined(QT_BUILD_INTERNAL)
+    QSKIP("This test requires a developer build of Qt");
+#else
+    QFETCH(QByteArray, contents);
+
+    QTemporaryDir dir;
+    QVERIFY2(dir.isValid(), qPrintable(dir.errorString()));
+    const QString cacheFile = dir.filePath("cache.cbor");
+    const QString plugin = QDir(dir.path()).canonicalPath() + "/" PREFIX "theplugin" SUFFIX;
+    QVERIFY(QFile::copy(sys_qualifiedLibraryName("theplugin"), plugin));
+    {
+        QFile file(cacheFile);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        QCOMPARE(file.write(contents), contents.size());
+    }
+
+    qputenv(CacheVariable, QFile::encodeName(cacheFile));
+    qt_resetPluginMetaDataCache();
+    auto restoreEnvironment = qScopeGuard([] {
+        qunsetenv(CacheVariable);
+        qt_resetPluginMetaDataCache();
+    });
+
+    // The plugin is read as if there were no cache, which is then replaced
+    QCOMPARE(pluginClassName(plugin), "ThePlugin");
+    qt_resetPluginMetaDataCache();
+    QCOMPARE(cachedPlugins(cacheFile), QStringList{ plugin });
+#endif
+}
+
+void tst_QPluginLoader::metaDataCacheDisabled_data()
+{
+    QTest::addColumn<bool>("setEmpty");
+    QTest::newRow("unset") << false;
+    QTest::newRow("empty") << true;
+}
+
+void tst_QPluginLoader::metaDataCacheDisabled()
+{
+#if !defined(QT_SHARED)
+    QSKIP("This test requires a shared build of Qt, as QPluginLoader::setFileName is a no-op in static builds");
+#elif !defined(QT_BUILD_INTERNAL)
+    QSKIP("This test requires a developer build of Qt");
+#else
+    QFETCH(bool, setEmpty);
+
+    QTemporaryDir dir;
+    QVERIFY2(dir.isValid(), qPrintable(dir.errorString()));
+    const QString cacheFile = dir.filePath("cache.cbor");
+    const QString plugin = QDir(dir.path()).canonicalPath() + "/" PREFIX "theplugin" SUFFIX;
+    QVERIFY(QFile::copy(sys_qualifiedLibraryName("theplugin"), plugin));
+
+    // Fill a cache that would be used if it were enabled
+    qputenv(CacheVariable, QFile::encodeName(cacheFile));
+    qt_resetPluginMetaDataCache();
+    auto restoreEnvironment = qScopeGuard([] {
+        qunsetenv(CacheVariable);
+        qt_resetPluginMetaDataCache();
+    });
+    QCOMPARE(pluginClassName(plugin), "ThePlugin");
+    qt_resetPluginMetaDataCache();
+    QVERIFY(markCachedClassNames(cacheFile));
+    QFile file(cacheFile);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const QByteArray contents = file.readAll();
+    file.close();
+
+    if (setEmpty)
+        qputenv(CacheVariable, QByteArray());
+    else
+        qunsetenv(CacheVariable);
+    qt_resetPluginMetaDataCache();
+
+    // The plugin is read, and the cache neither consulted nor written
+    QCOMPARE(pluginClassName(plugin), "ThePlugin");
+    QVERIFY(setModificationTime(plugin, QDateTime(QDate(2020, 1, 1), QTime(12, 0), Qt::UTC)));
+    QCOMPARE(pluginClassName(plugin), "ThePlugin");
+    qt_resetPluginMetaDataCache();
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QCOMPARE(file.readAll(), contents);
+#endif
+}
 
 QTEST_MAIN(tst_QPluginLoader)
 #include "tst_qpluginloader.moc"
@@ -560,6 +560,7 @@ private slots:
     void setEntityResolver();
     void readFromQBuffer() const;
     void readFromQBufferInvalid() const;
+    void readLargeByteArray() const;
     void readFromLatin1String() const;
     void readNextStartElement() const;
     void readElementText() const;
@@ -1086,6 +1087,53 @@ void tst_QXmlStream::readFromQBuffer() const
     QVERIFY(!reader.hasError());
 }
 
+void tst_QXmlStream::readLargeByteArray() const
+{
+    // In-memory data larger than the internal decoding chunk size must give
+    // the same result as reading it in one go, including multi-byte UTF-8
+    // sequences, CRLF pairs and attribute values that straddle chunk ends.
+    QByteArray in = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\r\n<root>\r\n";
+    QString expectedText;
+    QStringList expectedAttributes;
+    for (int i = 0; i < 5000; ++i) {
+        const QByteArray number = QByteArray::number(i);
+        in += "<item value=\"K\xc3\xb6ln " + number + " \xe2\x82\xac\">"
+              "Gr\xc3\xbc\xc3\x9f" "e, " + number + " ]&amp;]\r\n\t \xf0\x9f\x98\x80</item>\r\n";
+        expectedAttributes << u"K\u00f6ln "_s + QString::number(i) + u" \u20ac"_s;
+        expectedText += u"Gr\u00fc\u00dfe, "_s + QString::number(i)
+                + u" ]&]\n\t \U0001F600"_s;
+    }
+    in += "</root>\r\n";
+    QVERIFY(in.size() > 256 * 1024);
+
+    auto check = [&](QXmlStreamReader &reader) {
+        QString text;
+        QStringList attributes;
+        while (!reader.atEnd()) {
+            reader.readNext();
+            if (reader.isStartElement() && reader.name() == "item"_L1) {
+                attributes << reader.attributes().value("value"_L1).toString();
+                text += reader.readElementText();
+            }
+        }
+        QVERIFY2(!reader.hasError(), qPrintable(reader.errorString()));
+        QCOMPARE(attributes, expectedAttributes);
+        QCOMPARE(text, expectedText);
+        QCOMPARE(reader.lineNumber(), 10004);
+    };
+
+    {
+        QXmlStreamReader reader(in);
+        check(reader);
+    }
+    {
+        QBuffer buffer(&in);
+        QVERIFY(buffer.open(QIODevice::ReadOnly));
+        QXmlStreamReader reader(&buffer);
+        check(reader);
+    }
+}
+
 void tst_QXmlStream::readFromQBufferInvalid() const
 {
     QByteArray in("<e/><e/>");
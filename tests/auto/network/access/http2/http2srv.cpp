@@ -140,6 +140,16 @@ QByteArray Http2Server::requestAuthorizationHeader()
     return authentication == requestHeaders.cend() ? QByteArray() : authentication->value;
 }
 
+QByteArray Http2Server::requestPath(quint32 streamID) const
+{
+    const auto it = activeRequests.find(streamID);
+    if (it == activeRequests.end())
+        return QByteArray();
+    const auto isPath = [](const HeaderField &field) { return field.name == ":path"; };
+    const auto path = std::find_if(it->second.cbegin(), it->second.cend(), isPath);
+    return path == it->second.cend() ? QByteArray() : path->value;
+}
+
 void Http2Server::startServer()
 {
     if (listen()) {
@@ -218,7 +228,15 @@ void Http2Server::sendDATA(quint32 streamID, quint32 windowSize)
     const quint32 offset = it->second;
     Q_ASSERT(offset < quint32(responseBody.size()));
 
-    quint32 bytesToSend = std::min<quint32>(windowSize, responseBody.size() - offset);
+    // 'windowSize' is what our peer has added to the stream's window; both
+    // the stream and the session window limit what we can send.
+    qint64 &streamWindow = streamSendWindows[streamID];
+    streamWindow += windowSize;
+    const qint64 window = std::min(streamWindow, sessionSendWindow);
+    if (window <= 0)
+        return;
+
+    quint32 bytesToSend = quint32(std::min<qint64>(window, responseBody.size() - offset));
     quint32 bytesSent = 0;
     const quint32 frameSizeLimit(clientSetting(Settings::MAX_FRAME_SIZE_ID, Http2::minPayloadLimit));
     const uchar *src = reinterpret_cast<const uchar *>(responseBody.constData() + offset);
@@ -238,6 +256,8 @@ void Http2Server::sendDATA(quint32 streamID, quint32 windowSize)
         src += chunkSize;
         bytesToSend -= chunkSize;
         bytesSent += chunkSize;
+        streamWindow -= chunkSize;
+        sessionSendWindow -= chunkSize;
         if (frameSizeLimit != Http2::minPayloadLimit) {
             // Our test is probably interested in how many DATA frames were sent.
             emit sendingData();
@@ -252,6 +272,7 @@ void Http2Server::sendDATA(quint32 streamID, quint32 windowSize)
         writer.setPayloadSize(0);
         writer.write(*socket);
         suspendedStreams.erase(it);
+        streamSendWindows.erase(streamID);
         activeRequests.erase(streamID);
 
         Q_ASSERT(closedStreams.find(streamID) == closedStreams.end());
@@ -329,7 +350,8 @@ bool Http2Server::readMethodLine()
 {
     // We know for sure that Qt did the right thing sending us the correct
     // Request-line with CRLF at the end ...
-    // We're overly simplistic here but all we need to know - the method.
+    // We're overly simplistic here but all we need to know - the method
+    // and the path.
     while (socket->bytesAvailable()) {
         char c = 0;
         if (socket->read(&c, 1) != 1)
@@ -341,6 +363,8 @@ bool Http2Server::readMethodLine()
                 requestType = QHttpNetworkRequest::Post;
             else
                 requestType = QHttpNetworkRequest::Custom; // 'invalid'.
+            const QList<QByteArray> parts = requestLine.split(' ');
+            upgradeRequestPath = parts.size() > 1 ? parts[1] : QByteArray();
             requestLine.clear();
 
             return true;
@@ -537,6 +561,7 @@ void Http2Server::handleProtocolUpgrade()
     HttpHeader h2header;
     h2header.push_back(HeaderField(":scheme", "http")); // we are in clearTextHTTP2 mode.
     h2header.push_back(HeaderField(":authority", authority));
+    h2header.push_back(HeaderField(":path", upgradeRequestPath));
     activeRequests[1] = std::move(h2header);
     // After protocol switch we immediately send our SETTINGS.
     sendServerSettings();
@@ -618,7 +643,7 @@ void Http2Server::handleIncomingFrame()
         // TODO: this is not tested for now.
         break;
     case FrameType::PING:
-        // TODO: this is not tested for now.
+        handlePING();
         break;
     case FrameType::GOAWAY:
         // TODO: this is not tested for now.
@@ -748,10 +773,33 @@ void Http2Server::handleDATA()
 void Http2Server::handleWINDOW_UPDATE()
 {
     const auto streamID = inboundFrame.streamID();
-    if (!streamID) // We ignore this for now to keep things simple.
+    if (!streamID) {
+        const quint32 delta = qFromBigEndian<quint32>(inboundFrame.dataBegin());
+        if (!delta || delta > quint32(std::numeric_limits<qint32>::max())) {
+            sendGOAWAY(connectionStreamID, PROTOCOL_ERROR, connectionStreamID);
+            emit invalidFrame();
+            connectionError = true;
+            return;
+        }
+
+        // Resume the streams that were waiting for the session window:
+        sessionSendWindow += delta;
+        std::vector<quint32> streamIDs;
+        for (const auto &stream : suspendedStreams)
+            streamIDs.push_back(stream.first);
+        for (const quint32 id : streamIDs) {
+            if (sessionSendWindow <= 0)
+                break;
+            if (suspendedStreams.find(id) != suspendedStreams.end())
+                sendDATA(id, 0);
+        }
         return;
+    }
 
-    if (streamID && suspendedStreams.find(streamID) == suspendedStreams.end()) {
+    // Our peer can update the window of a stream we haven't started to
+    // respond on yet:
+    const bool responding = suspendedStreams.find(streamID) != suspendedStreams.end();
+    if (!responding && activeRequests.find(streamID) == activeRequests.end()) {
         if (closedStreams.find(streamID) == closedStreams.end()) {
             sendRST_STREAM(streamID, PROTOCOL_ERROR);
             emit invalidFrame();
@@ -769,8 +817,32 @@ void Http2Server::handleWINDOW_UPDATE()
         return;
     }
 
-    emit windowUpdate(streamID);
-    sendDATA(streamID, delta);
+    emit windowUpdate(streamID, delta);
+    if (responding)
+        sendDATA(streamID, delta);
+    else
+        streamSendWindows[streamID] += delta;
+}
+
+void Http2Server::handlePING()
+{
+    Q_ASSERT(inboundFrame.type() == FrameType::PING);
+
+    if (inboundFrame.streamID() != connectionStreamID || inboundFrame.dataSize() != 8) {
+        sendGOAWAY(connectionStreamID, PROTOCOL_ERROR, connectionStreamID);
+        emit invalidFrame();
+        connectionError = true;
+        return;
+    }
+
+    if (inboundFrame.flags().testFlag(FrameFlag::ACK))
+        return; // We never send PING frames ourselves.
+
+    emit receivedPING();
+
+    writer.start(FrameType::PING, FrameFlag::ACK, connectionStreamID);
+    writer.append(inboundFrame.dataBegin(), inboundFrame.dataBegin() + 8);
+    writer.write(*socket);
 }
 
 void Http2Server::sendResponse(quint32 streamID, bool emptyBody)
@@ -877,6 +949,7 @@ void Http2Server::sendResponse(quint32 streamID, bool emptyBody)
         sendDATA(streamID, windowSize);
     } else {
         activeRequests.erase(streamID);
+        streamSendWindows.erase(streamID);
         closedStreams.insert(streamID);
     }
 }
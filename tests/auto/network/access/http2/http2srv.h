@@ -74,6 +74,8 @@ public:
     bool isClearText() const;
 
     QByteArray requestAuthorizationHeader();
+    // The :path of the request on \a streamID; to be called on the server's thread.
+    QByteArray requestPath(quint32 streamID) const;
 
     // Invokables, since we can call them from the main thread,
     // but server (can) work on its own thread.
@@ -92,6 +94,7 @@ public:
     Q_INVOKABLE void handleSETTINGS();
     Q_INVOKABLE void handleDATA();
     Q_INVOKABLE void handleWINDOW_UPDATE();
+    Q_INVOKABLE void handlePING();
 
     Q_INVOKABLE void sendResponse(quint32 streamID, bool emptyBody);
 
@@ -113,7 +116,8 @@ Q_SIGNALS:
     void receivedData(quint32 streamID);
     // Emitted for every DATA frame. Includes the content of the frame as \a body.
     void receivedDATAFrame(quint32 streamID, const QByteArray &body);
-    void windowUpdate(quint32 streamID);
+    void windowUpdate(quint32 streamID, quint32 delta);
+    void receivedPING();
     void sendingData();
 
 private slots:
@@ -161,6 +165,10 @@ private:
     std::set<quint32> closedStreams;
     // streamID + offset in response body to send.
     std::map<quint32, quint32> suspendedStreams;
+    // Our peer's receive windows, which limit how much of the response
+    // bodies we can send; per stream and for the whole session:
+    std::map<quint32, qint64> streamSendWindows;
+    qint64 sessionSendWindow = Http2::defaultSessionWindowSize;
 
     // We potentially reset this once (see sendServerSettings)
     // and do not change later:
@@ -183,6 +191,7 @@ private:
     // from the initial HTTP/1.1 request.
     bool upgradeProtocol = false;
     QByteArray requestLine;
+    QByteArray upgradeRequestPath;
     QHttpNetworkRequest::Operation requestType;
     // We need QHttpNetworkReply (actually its private d-object) to handle the
     // first HTTP/1.1 request. QHttpNetworkReplyPrivate does parsing + in case
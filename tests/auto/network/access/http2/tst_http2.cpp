@@ -74,6 +74,8 @@ private slots:
     void multipleRequests();
     void flowControlClientSide();
     void flowControlServerSide();
+    void flowControlAutoTuning_data();
+    void flowControlAutoTuning();
     void pushPromise();
     void goaway_data();
     void goaway();
@@ -408,6 +410,103 @@ void tst_Http2::flowControlServerSide()
     QVERIFY(serverGotSettingsACK);
 }
 
+void tst_Http2::flowControlAutoTuning_data()
+{
+    QTest::addColumn<bool>("autoTuning");
+
+    QTest::addRow("enabled") << true;
+    QTest::addRow("disabled") << false;
+}
+
+void tst_Http2::flowControlAutoTuning()
+{
+    // With window auto-tuning, the client measures the bandwidth-delay
+    // product with PING frames while DATA frames come in. Our server ACKs
+    // them right away, after sending all the data our windows allow, so the
+    // estimate is at least a whole window: the most urgent stream must get a
+    // larger one, the less urgent one must not, as long as the most urgent
+    // one is open.
+    using namespace Http2;
+
+    QFETCH(bool, autoTuning);
+
+    clearHTTP2State();
+
+    serverPort = 0;
+    nRequests = 2;
+    windowUpdates = 0;
+
+    QHttp2Configuration params;
+    params.setReceiveWindowAutoTuningEnabled(autoTuning);
+    params.setSessionReceiveWindowSize(Http2::defaultSessionWindowSize * 5);
+    params.setStreamReceiveWindowSize(Http2::defaultSessionWindowSize);
+
+    ServerPtr srv(newServer(defaultServerSettings, defaultConnectionType(),
+                            qt_H2ConfigurationToSettings(params)));
+    srv->setResponseBody(QByteArray(int(Http2::defaultSessionWindowSize * 10), 'x'));
+    int pings = 0;
+    connect(srv.data(), &Http2Server::receivedPING, this, [&pings] { ++pings; });
+
+    // The largest WINDOW_UPDATE the server received for each stream; for
+    // the low-priority one, only those received while the high-priority
+    // one had data left. Shared, since queued calls can outlive this test.
+    const QByteArray lowPriorityPath("/stream0.html");
+    const QByteArray highPriorityPath("/stream1.html");
+    struct WindowUpdates
+    {
+        quint32 highPriorityStreamID = 0; // Only used on the server's thread
+        quint32 highPriority = 0;
+        quint32 lowPriority = 0;
+    };
+    const auto maxWindowUpdates = std::make_shared<WindowUpdates>();
+    Http2Server *server = srv.data();
+    connect(server, &Http2Server::receivedRequest, server,
+            [server, maxWindowUpdates, highPriorityPath](quint32 streamID) {
+        if (server->requestPath(streamID) == highPriorityPath)
+            maxWindowUpdates->highPriorityStreamID = streamID;
+    }, Qt::DirectConnection);
+    connect(server, &Http2Server::windowUpdate, server,
+            [this, server, maxWindowUpdates, lowPriorityPath, highPriorityPath]
+            (quint32 streamID, quint32 delta) {
+        const QByteArray path = server->requestPath(streamID);
+        const quint32 highPriorityStreamID = maxWindowUpdates->highPriorityStreamID;
+        if (path == lowPriorityPath
+            && (!highPriorityStreamID || server->requestPath(highPriorityStreamID).isEmpty())) {
+            return;
+        }
+        QMetaObject::invokeMethod(this, [maxWindowUpdates, path, highPriorityPath, delta] {
+            quint32 &maxDelta = path == highPriorityPath ? maxWindowUpdates->highPriority
+                                                         : maxWindowUpdates->lowPriority;
+            maxDelta = std::max(maxDelta, delta);
+        });
+    }, Qt::DirectConnection);
+
+    QMetaObject::invokeMethod(srv.data(), "startServer", Qt::QueuedConnection);
+
+    runEventLoop();
+    QVERIFY(serverPort != 0);
+
+    sendRequest(0, QNetworkRequest::LowPriority, {}, params);
+    sendRequest(1, QNetworkRequest::HighPriority, {}, params);
+
+    runEventLoop(120000);
+    STOP_ON_FAILURE
+
+    QCOMPARE(nRequests, 0);
+    QVERIFY(windowUpdates > 0);
+    QVERIFY(maxWindowUpdates->lowPriority > 0);
+    QVERIFY(maxWindowUpdates->lowPriority <= quint32(Http2::defaultSessionWindowSize));
+    if (autoTuning) {
+        QVERIFY(pings > 0);
+        QVERIFY2(maxWindowUpdates->highPriority > quint32(Http2::defaultSessionWindowSize),
+                 QByteArray::number(maxWindowUpdates->highPriority));
+    } else {
+        QCOMPARE(pings, 0);
+        QVERIFY(maxWindowUpdates->highPriority > 0);
+        QVERIFY(maxWindowUpdates->highPriority <= quint32(Http2::defaultSessionWindowSize));
+    }
+}
+
 void tst_Http2::pushPromise()
 {
     // We will first send some request, the server should reply and also emulate
@@ -15,6 +15,8 @@ private Q_SLOTS:
     void adjustableLimits_data();
     void adjustableLimits();
 
+    void fields();
+
     // general parsing tests can be found in tst_QHttpNetworkReply
 };
 
@@ -90,5 +92,43 @@ void tst_QHttpHeaderParser::adjustableLimits()
     QCOMPARE(parser.parseHeaders(headers), success);
 }
 
+void tst_QHttpHeaderParser::fields()
+{
+    QHttpHeaderParser parser;
+    QVERIFY(parser.parseHeaders("content-TYPE: text/plain\r\n"
+                                "X-Custom:  first\r\n"
+                                "\tsecond \r\n"
+                                "Set-Cookie: a=1\r\n"
+                                "set-cookie: b=2\r\n"
+                                "x-custom: third\r\n"
+                                "\r\n"));
+
+    // Names are kept as they were received, well-known or not
+    using Fields = QList<QPair<QByteArray, QByteArray>>;
+    QCOMPARE(parser.headers(), Fields({ { "content-TYPE", "text/plain" },
+                                        { "X-Custom", "first second" },
+                                        { "Set-Cookie", "a=1" },
+                                        { "set-cookie", "b=2" },
+                                        { "x-custom", "third" } }));
+
+    // Lookups ignore case
+    QCOMPARE(parser.firstHeaderField("Content-Type"), "text/plain");
+    QCOMPARE(parser.combinedHeaderValue("SET-COOKIE"), "a=1, b=2");
+    QCOMPARE(parser.headerFieldValues("X-CUSTOM"), QList<QByteArray>({ "first second", "third" }));
+    QCOMPARE(parser.firstHeaderField("Content-Length", "none"), "none");
+    QCOMPARE(parser.combinedHeaderValue("X-Other", "none"), "none");
+
+    parser.setHeaderField("X-Custom", "replaced");
+    parser.prependHeaderField("Content-Length", "0");
+    parser.removeHeaderField("set-cookie");
+    QCOMPARE(parser.headers(), Fields({ { "Content-Length", "0" },
+                                        { "content-TYPE", "text/plain" },
+                                        { "X-Custom", "replaced" } }));
+
+    parser.clearHeaders();
+    QVERIFY(parser.headers().isEmpty());
+    QCOMPARE(parser.firstHeaderField("Content-Type"), QByteArray());
+}
+
 QTEST_MAIN(tst_QHttpHeaderParser)
 #include "tst_qhttpheaderparser.moc"
@@ -48,6 +48,8 @@
 #include <QtNetwork/QNetworkCookieJar>
 #include <QtNetwork/QHttpPart>
 #include <QtNetwork/QHttpMultiPart>
+#include <QtNetwork/QHttp1Configuration>
+#include <QtNetwork/QHttpConnectionPoolStatistics>
 #include <QtNetwork/QNetworkProxyQuery>
 #if QT_CONFIG(ssl)
 #include <QtNetwork/qsslerror.h>
@@ -367,6 +369,8 @@ private Q_SLOTS:
 
     void httpConnectionCount_data();
     void httpConnectionCount();
+    void httpConnectionPool_data();
+    void httpConnectionPool();
 
     void httpReUsingConnectionSequential_data();
     void httpReUsingConnectionSequential();
@@ -6239,6 +6243,95 @@ void tst_QNetworkReply::httpConnectionCount()
     QCOMPARE(pendingConnectionCount, 6);
 }
 
+void tst_QNetworkReply::httpConnectionPool_data()
+{
+    QTest::addColumn<int>("connections");
+    QTest::addColumn<int>("maximumConnections");
+    QTest::addColumn<int>("expectedConnections");
+
+    QTest::addRow("1") << 1 << 1 << 1;
+    QTest::addRow("8") << 8 << 8 << 8;
+    QTest::addRow("2-4") << 2 << 4 << 4;
+}
+
+void tst_QNetworkReply::httpConnectionPool()
+{
+    QFETCH(int, connections);
+    QFETCH(int, maximumConnections);
+    QFETCH(int, expectedConnections);
+    constexpr int RequestCount = 10;
+
+    QTcpServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+    QList<QTcpSocket *> sockets;
+    connect(&server, &QTcpServer::newConnection, this, [&] {
+        while (QTcpSocket *socket = server.nextPendingConnection())
+            sockets.append(socket);
+    });
+
+    QHttp1Configuration configuration;
+    QVERIFY(configuration.setNumberOfConnectionsPerHost(connections));
+    QVERIFY(configuration.setMaximumNumberOfConnectionsPerHost(maximumConnections));
+    QTest::ignoreMessage(QtWarningMsg, "QHttp1Configuration: invalid number of connections per host 0");
+    QVERIFY(!configuration.setNumberOfConnectionsPerHost(0));
+    QCOMPARE(configuration.numberOfConnectionsPerHost(), connections);
+
+    // A manager of our own, so no other test's connections show up in the statistics
+    QNetworkAccessManager manager;
+    QNetworkRequest request(QUrl("http://127.0.0.1:" + QString::number(server.serverPort())
+                                 + QLatin1Char('/')));
+    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, false);
+    request.setHttp1Configuration(configuration);
+    QCOMPARE(request.http1Configuration(), configuration);
+
+    int finished = 0;
+    for (int i = 0; i < RequestCount; ++i) {
+        QNetworkReply *reply = manager.get(request);
+        reply->setParent(&server);
+        connect(reply, &QNetworkReply::finished, this, [&finished] { ++finished; });
+    }
+
+    // The server does not answer, so requests pile up in the queue; an
+    // adaptive pool opens connections up to its maximum, but not beyond.
+    QTRY_COMPARE(sockets.size(), expectedConnections);
+    QTest::qWait(200);
+    QCOMPARE(sockets.size(), expectedConnections);
+
+    QList<QHttpConnectionPoolStatistics> pools = manager.httpConnectionPoolStatistics();
+    QCOMPARE(pools.size(), 1);
+    QCOMPARE(pools.first().host(), QStringLiteral("127.0.0.1"));
+    QCOMPARE(pools.first().port(), server.serverPort());
+    QVERIFY(!pools.first().isEncrypted());
+    QCOMPARE(pools.first().connectionLimit(), expectedConnections);
+    QTRY_COMPARE(manager.httpConnectionPoolStatistics().first().openedConnectionCount(),
+                 expectedConnections);
+    QCOMPARE(manager.httpConnectionPoolStatistics().first().queueDepth(),
+             RequestCount - expectedConnections);
+
+    // Now answer every request, the remaining ones go over open connections:
+    for (QTcpSocket *socket : std::as_const(sockets)) {
+        socket->setParent(&server);
+        const auto respond = [socket] {
+            const QByteArray data = socket->readAll();
+            for (qsizetype i = 0; (i = data.indexOf("\r\n\r\n", i)) >= 0; i += 4)
+                socket->write(httpEmpty200Response);
+        };
+        connect(socket, &QTcpSocket::readyRead, socket, respond);
+        respond();
+    }
+    QTRY_COMPARE(finished, RequestCount);
+
+    pools = manager.httpConnectionPoolStatistics();
+    QCOMPARE(pools.size(), 1);
+    const QHttpConnectionPoolStatistics &pool = pools.first();
+    QCOMPARE(pool.queueDepth(), 0);
+    QCOMPARE(pool.peakQueueDepth(), RequestCount);
+    QCOMPARE(pool.sentRequestCount(), RequestCount);
+    QCOMPARE(pool.openedConnectionCount(), expectedConnections);
+    QCOMPARE(pool.reusedConnectionRequestCount(), RequestCount - expectedConnections);
+    QVERIFY(pool.maximumQueueWaitTime() >= pool.averageQueueWaitTime());
+}
+
 void tst_QNetworkReply::httpReUsingConnectionSequential_data()
 {
     QTest::addColumn<bool>("doDeleteLater");
@@ -22,6 +22,12 @@
 #include <QDebug>
 #include <QTcpSocket>
 #include <QTcpServer>
+#include <QUdpSocket>
+#include <QNetworkDatagram>
+#include <QScopeGuard>
+#include <QSemaphore>
+#include <QSet>
+#include <QtEndian>
 
 #include <private/qthread_p.h>
 
@@ -35,6 +41,9 @@
 
 #include <qhostinfo.h>
 #include "private/qhostinfo_p.h"
+#if QT_CONFIG(udpsocket)
+#include "private/qdnsresolver_p.h"
+#endif
 
 #include <sys/types.h>
 #if defined(Q_OS_UNIX)
@@ -84,6 +93,15 @@ private slots:
     void cache();
 
     void abortHostLookup();
+
+#if QT_CONFIG(udpsocket)
+    void resolvConf();
+    void dnsResolver_data();
+    void dnsResolver();
+    void dnsResolverCache();
+    void dnsResolverRetry();
+    void dnsResolverThreads();
+#endif
 protected slots:
     void resultsReady(const QHostInfo &);
 
@@ -709,5 +727,388 @@ public:
     int id;
 };
 
+#if QT_CONFIG(udpsocket)
+// A name server for QHostInfo::Resolver::Dns, answering from a small zone
+// in the test's own thread, over UDP and TCP on the same port.
+class StubNameServer : public QObject
+{
+public:
+    enum Type : quint16 { A = 1, CNAME = 5, AAAA = 28 };
+
+    StubNameServer()
+    {
+        udp.bind(QHostAddress::LocalHost);
+        tcp.listen(QHostAddress::LocalHost, udp.localPort());
+        connect(&udp, &QUdpSocket::readyRead, this, [this] {
+            while (udp.hasPendingDatagrams()) {
+                const QNetworkDatagram query = udp.receiveDatagram();
+                ++udpQueries;
+                udpSourcePorts.insert(query.senderPort());
+                if (!silent)
+                    udp.writeDatagram(query.makeReply(answer(query.data(), truncate)));
+            }
+        });
+        connect(&tcp, &QTcpServer::newConnection, this, [this] {
+            QTcpSocket *socket = tcp.nextPendingConnection();
+            connect(socket, &QTcpSocket::readyRead, socket, [this, socket] {
+                if (socket->bytesAvailable() < 2)
+                    return;
+                const QByteArray query = socket->readAll().mid(2);
+                ++tcpQueries;
+                QByteArray response = answer(query, false);
+                const quint16 length = qToBigEndian(quint16(response.size()));
+                socket->write(response.prepend(reinterpret_cast<const char *>(&length), 2));
+            });
+            connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+        });
+    }
+
+    bool isListening() const { return udp.state() == QUdpSocket::BoundState && tcp.isListening(); }
+
+    QDnsResolverConfiguration::NameServer address() const
+    {
+        return { QHostAddress(QHostAddress::LocalHost), udp.localPort() };
+    }
+
+    void addRecord(const QByteArray &name, Type type, quint32 ttl, const QByteArray &data)
+    {
+        records.append({ name, type, ttl, data });
+    }
+    void addAddress(const QByteArray &name, const QHostAddress &address, quint32 ttl = 60)
+    {
+        QByteArray data;
+        if (address.protocol() == QAbstractSocket::IPv4Protocol) {
+            data.resize(4);
+            qToBigEndian(address.toIPv4Address(), data.data());
+            addRecord(name, A, ttl, data);
+        } else {
+            const Q_IPV6ADDR ipv6 = address.toIPv6Address();
+            addRecord(name, AAAA, ttl, QByteArray(reinterpret_cast<const char *>(ipv6.c), 16));
+        }
+    }
+    void addAlias(const QByteArray &name, const QByteArray &target, quint32 ttl = 60)
+    {
+        addRecord(name, CNAME, ttl, target);
+    }
+
+    int udpQueries = 0;
+    QSet<int> udpSourcePorts;
+    int tcpQueries = 0;
+    bool truncate = false;
+    bool silent = false;
+    quint32 negativeTtl = 60;
+
+private:
+    struct Record
+    {
+        QByteArray name;
+        Type type;
+        quint32 ttl;
+        QByteArray data; // the target's name for CNAME
+    };
+
+    static QByteArray encodeName(const QByteArray &name)
+    {
+        QByteArray encoded;
+        for (const QByteArray &label : name.split('.'))
+            encoded.append(char(label.size())).append(label);
+        return encoded.append('\0');
+    }
+
+    static void appendUInt16(QByteArray &data, quint16 value)
+    {
+        data.append(char(value >> 8)).append(char(value));
+    }
+
+    static void appendRecord(QByteArray &response, const QByteArray &name, quint16 type,
+                             quint32 ttl, const QByteArray &data)
+    {
+        response += encodeName(name);
+        appendUInt16(response, type);
+        appendUInt16(response, 1); // IN
+        appendUInt16(response, quint16(ttl >> 16));
+        appendUInt16(response, quint16(ttl));
+        appendUInt16(response, quint16(data.size()));
+        response += data;
+    }
+
+    QByteArray answer(const QByteArray &query, bool truncated) const
+    {
+        // The question: labels, then type and class
+        QByteArrayList labels;
+        qsizetype pos = 12;
+        while (pos < query.size() && query.at(pos)) {
+            labels.append(query.mid(pos + 1, quint8(query.at(pos))));
+            pos += 1 + quint8(query.at(pos));
+        }
+        const QByteArray question = query.mid(12, pos + 5 - 12);
+        const quint16 type = qFromBigEndian<quint16>(query.constData() + pos + 1);
+
+        QList<Record> answers;
+        QByteArray name = labels.join('.');
+        bool exists = false;
+        for (int hops = 0; hops < 16; ++hops) {
+            bool aliased = false;
+            for (const Record &record : records) {
+                if (record.name != name)
+                    continue;
+                exists = true;
+                if (record.type == CNAME) {
+                    answers.append(record);
+                    name = record.data;
+                    aliased = true;
+                    break;
+                }
+            }
+            if (!aliased)
+                break;
+        }
+        for (const Record &record : records) {
+            if (record.name == name && record.type == type)
+                answers.append(record);
+        }
+
+        QByteArray response = query.left(2);
+        appendUInt16(response, 0x8180 | (truncated ? 0x0200 : 0) | (exists ? 0 : 3));
+        appendUInt16(response, 1);
+        appendUInt16(response, truncated ? 0 : quint16(answers.size()));
+        appendUInt16(response, truncated || !answers.isEmpty() ? 0 : 1);
+        appendUInt16(response, 0);
+        response += question;
+        if (truncated)
+            return response;
+        for (const Record &record : std::as_const(answers)) {
+            appendRecord(response, record.name, record.type, record.ttl,
+                         record.type == CNAME ? encodeName(record.data) : record.data);
+        }
+        if (answers.isEmpty()) {
+            // SOA: primary server, mailbox, serial, refresh, retry, expire, minimum
+            QByteArray soa = encodeName("ns.test") + encodeName("admin.test");
+            for (int i = 0; i < 4; ++i)
+                soa.append("\0\0\x0e\x10", 4);
+            soa.append(char(negativeTtl >> 24)).append(char(negativeTtl >> 16))
+               .append(char(negativeTtl >> 8)).append(char(negativeTtl));
+            appendRecord(response, "test", 6, 3600, soa);
+        }
+        return response;
+    }
+
+    QUdpSocket udp;
+    QTcpServer tcp;
+    QList<Record> records;
+};
+
+static auto useNameServers(const QList<QDnsResolverConfiguration::NameServer> &nameServers,
+                           int timeout = 1000)
+{
+    auto configuration = std::make_shared<QDnsResolverConfiguration>();
+    configuration->nameServers = nameServers;
+    configuration->timeout = timeout;
+    configuration->attempts = 1;
+    configuration->hosts.insert("fromhosts.test", { QHostAddress("192.0.2.99") });
+    QDnsResolver::setConfiguration(std::move(configuration));
+    QHostInfo::setResolver(QHostInfo::Resolver::Dns);
+    return qScopeGuard([] {
+        QHostInfo::setResolver(QHostInfo::Resolver::System);
+        QDnsResolver::setConfiguration(nullptr);
+    });
+}
+
+void tst_QHostInfo::resolvConf()
+{
+    QDnsResolverConfiguration configuration;
+    configuration.parseResolvConf("# comment\n"
+                                  "nameserver 192.0.2.53\n"
+                                  "nameserver   2001:db8::53 # second\n"
+                                  "nameserver not-an-address\n"
+                                  "domain example.com\n"
+                                  "search Example.org example.net\n"
+                                  "options rotate ndots:3 timeout:2 attempts:9\n"
+                                  "nameserver 192.0.2.54\n"
+                                  "nameserver 192.0.2.55\n");
+    QCOMPARE(configuration.nameServers.size(), 3);
+    QCOMPARE(configuration.nameServers.at(0).address, QHostAddress("192.0.2.53"));
+    QCOMPARE(configuration.nameServers.at(1).address, QHostAddress("2001:db8::53"));
+    QCOMPARE(configuration.nameServers.at(2).address, QHostAddress("192.0.2.54"));
+    QCOMPARE(configuration.searchDomains, QList<QByteArray>({ "example.org", "example.net" }));
+    QCOMPARE(configuration.ndots, 3);
+    QCOMPARE(configuration.timeout, 2000);
+    QCOMPARE(configuration.attempts, 5);
+
+    configuration.parseHosts("127.0.0.1 localhost\n"
+                             "::1 localhost ip6-localhost # loopback\n"
+                             "garbage line\n");
+    QCOMPARE(configuration.hosts.value("localhost"),
+             QList<QHostAddress>({ QHostAddress::LocalHost, QHostAddress::LocalHostIPv6 }));
+    QCOMPARE(configuration.hosts.value("ip6-localhost"),
+             QList<QHostAddress>({ QHostAddress::LocalHostIPv6 }));
+    QVERIFY(!configuration.hosts.contains("line"));
+}
+
+void tst_QHostInfo::dnsResolver_data()
+{
+    QTest::addColumn<QString>("hostname");
+    QTest::addColumn<bool>("truncate");
+    QTest::addColumn<QString>("addresses");
+    QTest::addColumn<int>("err");
+
+    // IPv6 first, then alternating
+    QTest::newRow("a-and-aaaa") << "host.test" << false
+                                << "2001:db8::1 192.0.2.1 192.0.2.2" << int(QHostInfo::NoError);
+    QTest::newRow("case-insensitive") << "HoSt.TeSt" << false
+                                      << "2001:db8::1 192.0.2.1 192.0.2.2" << int(QHostInfo::NoError);
+    QTest::newRow("absolute") << "host.test." << false
+                              << "2001:db8::1 192.0.2.1 192.0.2.2" << int(QHostInfo::NoError);
+    QTest::newRow("a-only") << "v4.test" << false << "192.0.2.4" << int(QHostInfo::NoError);
+    QTest::newRow("cname-chain") << "alias2.test" << false
+                                 << "2001:db8::1 192.0.2.1 192.0.2.2" << int(QHostInfo::NoError);
+    QTest::newRow("tcp-fallback") << "host.test" << true
+                                  << "2001:db8::1 192.0.2.1 192.0.2.2" << int(QHostInfo::NoError);
+    QTest::newRow("hosts-file") << "fromhosts.test" << false << "192.0.2.99" << int(QHostInfo::NoError);
+    QTest::newRow("nxdomain") << "missing.test" << false << "" << int(QHostInfo::HostNotFound);
+    QTest::newRow("invalid") << "bad..test" << false << "" << int(QHostInfo::HostNotFound);
+}
+
+void tst_QHostInfo::dnsResolver()
+{
+    QFETCH(QString, hostname);
+    QFETCH(bool, truncate);
+    QFETCH(QString, addresses);
+    QFETCH(int, err);
+
+    StubNameServer server;
+    QVERIFY(server.isListening());
+    server.truncate = truncate;
+    server.addAddress("host.test", QHostAddress("192.0.2.1"));
+    server.addAddress("host.test", QHostAddress("192.0.2.2"));
+    server.addAddress("host.test", QHostAddress("2001:db8::1"));
+    server.addAddress("v4.test", QHostAddress("192.0.2.4"));
+    server.addAlias("alias1.test", "host.test");
+    server.addAlias("alias2.test", "alias1.test");
+    const auto restore = useNameServers({ server.address() });
+
+    lookupDone = false;
+    QHostInfo::lookupHost(hostname, this, SLOT(resultsReady(QHostInfo)));
+    QTestEventLoop::instance().enterLoop(5);
+    QVERIFY(!QTestEventLoop::instance().timeout());
+    QVERIFY(lookupDone);
+
+    QCOMPARE(int(lookupResults.error()), err);
+    QCOMPARE(lookupResults.hostName(), hostname);
+    QStringList results;
+    for (const QHostAddress &address : lookupResults.addresses())
+        results.append(address.toString());
+    QCOMPARE(results.join(u' '), addresses);
+    QCOMPARE(server.tcpQueries, truncate ? 2 : 0);
+}
+
+void tst_QHostInfo::dnsResolverCache()
+{
+    QFETCH_GLOBAL(bool, cache);
+    if (!cache)
+        return; // test makes only sense when cache enabled
+
+    StubNameServer server;
+    QVERIFY(server.isListening());
+    server.addAddress("host.test", QHostAddress("192.0.2.1"), 1);
+    server.addAddress("host.test", QHostAddress("2001:db8::1"), 300);
+    server.negativeTtl = 120;
+    const auto restore = useNameServers({ server.address() });
+
+    // Lookups of the same name at the same time share the queries
+    lookupsDoneCounter = 0;
+    QHostInfo::lookupHost("host.test", this, SLOT(resultsReady(QHostInfo)));
+    QHostInfo::lookupHost("host.test", this, SLOT(resultsReady(QHostInfo)));
+    QTRY_COMPARE(lookupsDoneCounter, 2);
+    QCOMPARE(server.udpQueries, 2);
+
+    bool valid = false;
+    int id = -1;
+    QHostInfo result = qt_qhostinfo_lookup("host.test", this, SLOT(resultsReady(QHostInfo)), &valid, &id);
+    QVERIFY(valid);
+    QCOMPARE(result.addresses().size(), 2);
+
+    // Names that don't exist are cached too
+    lookupsDoneCounter = 0;
+    QHostInfo::lookupHost("missing.test", this, SLOT(resultsReady(QHostInfo)));
+    QTRY_COMPARE(lookupsDoneCounter, 1);
+    QCOMPARE(server.udpQueries, 4);
+    result = qt_qhostinfo_lookup("missing.test", this, SLOT(resultsReady(QHostInfo)), &valid, &id);
+    QVERIFY(valid);
+    QCOMPARE(result.error(), QHostInfo::HostNotFound);
+
+    // The shortest time to live counts
+    QTest::qWait(1100);
+    result = qt_qhostinfo_lookup("host.test", this, SLOT(resultsReady(QHostInfo)), &valid, &id);
+    QVERIFY(!valid);
+    QTRY_COMPARE(lookupsDoneCounter, 2);
+    QCOMPARE(server.udpQueries, 6);
+}
+
+void tst_QHostInfo::dnsResolverRetry()
+{
+    StubNameServer unresponsive;
+    unresponsive.silent = true;
+    StubNameServer server;
+    QVERIFY(unresponsive.isListening());
+    QVERIFY(server.isListening());
+    server.addAddress("host.test", QHostAddress("192.0.2.1"));
+    const auto restore = useNameServers({ unresponsive.address(), server.address() }, 200);
+
+    lookupDone = false;
+    QHostInfo::lookupHost("host.test", this, SLOT(resultsReady(QHostInfo)));
+    QTestEventLoop::instance().enterLoop(5);
+    QVERIFY(!QTestEventLoop::instance().timeout());
+    QCOMPARE(lookupResults.error(), QHostInfo::NoError);
+    QCOMPARE(lookupResults.addresses(), QList<QHostAddress>({ QHostAddress("192.0.2.1") }));
+    QCOMPARE(unresponsive.udpQueries, 2);
+    // Each query comes from a port of its own
+    QCOMPARE(unresponsive.udpSourcePorts.size(), 2);
+    QCOMPARE(server.udpSourcePorts.size(), 2);
+
+    // When no name server answers, that's an error, not a name that doesn't exist
+    server.silent = true;
+    qt_qhostinfo_clear_cache();
+    lookupDone = false;
+    QHostInfo::lookupHost("host.test", this, SLOT(resultsReady(QHostInfo)));
+    QTestEventLoop::instance().enterLoop(5);
+    QVERIFY(!QTestEventLoop::instance().timeout());
+    QCOMPARE(lookupResults.error(), QHostInfo::UnknownError);
+}
+
+void tst_QHostInfo::dnsResolverThreads()
+{
+    StubNameServer server;
+    QVERIFY(server.isListening());
+    server.addAddress("host.test", QHostAddress("192.0.2.1"));
+    const auto restore = useNameServers({ server.address() });
+    qt_qhostinfo_clear_cache();
+
+    // The lookup happens in the receiver's thread, not in one that never
+    // gets back to its event loop
+    QSemaphore resultsSeen;
+    lookupDone = false;
+    std::unique_ptr<QThread> thread(QThread::create([this, &resultsSeen] {
+        QHostInfo::lookupHost("host.test", this, SLOT(resultsReady(QHostInfo)));
+        resultsSeen.acquire();
+    }));
+    thread->start();
+    QTestEventLoop::instance().enterLoop(5);
+    resultsSeen.release();
+    QVERIFY(thread->wait());
+    QVERIFY(!QTestEventLoop::instance().timeout());
+    QCOMPARE(lookupResults.error(), QHostInfo::NoError);
+    QCOMPARE(lookupResults.addresses(), QList<QHostAddress>({ QHostAddress("192.0.2.1") }));
+    QCOMPARE(server.udpQueries, 2);
+
+    // Without a context object, the system's resolver does it
+    qt_qhostinfo_clear_cache();
+    bool done = false;
+    QHostInfo::lookupHost("host.test", [&done](const QHostInfo &) { done = true; });
+    QTRY_VERIFY_WITH_TIMEOUT(done, 30000);
+    QCOMPARE(server.udpQueries, 2);
+}
+#endif // QT_CONFIG(udpsocket)
+
 QTEST_MAIN(tst_QHostInfo)
 #include "tst_qhostinfo.moc"
@@ -12,9 +12,12 @@
 #include <QLoggingCategory>
 #include <QMutex>
 #include <QList>
+#include <QRegularExpression>
+#include <QTemporaryFile>
 
 #include <qtextstream.h>
 #include <qdatastream.h>
+#include <qdeadlinetimer.h>
 #include <qelapsedtimer.h>
 #include <qproperty.h>
 #include <QtNetwork/qlocalsocket.h>
@@ -106,6 +109,7 @@ private slots:
 
     void multiConnect();
     void writeOnlySocket();
+    void sendFile();
 
     void writeToClientAndDisconnect_data();
     void writeToClientAndDisconnect();
@@ -1491,6 +1495,55 @@ void tst_QLocalSocket::writeOnlySocket()
     QCOMPARE(client.state(), QLocalSocket::UnconnectedState);
 }
 
+void tst_QLocalSocket::sendFile()
+{
+    CrashSafeLocalServer server;
+    QVERIFY2(server.listen("sendFileServer"), qUtf8Printable(server.errorString()));
+
+    QLocalSocket client;
+    client.connectToServer("sendFileServer");
+    QVERIFY(client.waitForConnected());
+    QVERIFY(server.waitForNewConnection(200));
+    QLocalSocket *serverSocket = server.nextPendingConnection();
+    QVERIFY(serverSocket);
+
+    QByteArray fileData(3 * 1024 * 1024 + 17, Qt::Uninitialized);
+    for (qsizetype i = 0; i < fileData.size(); ++i)
+        fileData[i] = char(i * 7);
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(fileData), fileData.size());
+    QVERIFY(file.seek(42));
+
+    // Data written around a file must keep its relative order
+    const qint64 offset = 1000;
+    const qint64 length = fileData.size() - 2 * offset;
+    QCOMPARE(client.write("head"), qint64(4));
+    QCOMPARE(client.sendFile(&file, offset, length), length);
+    QCOMPARE(client.write("tail"), qint64(4));
+    QCOMPARE(client.sendFile(&file, fileData.size() - 10), qint64(10));
+    QCOMPARE(file.pos(), qint64(42));
+
+    const QByteArray expected = "head" + fileData.mid(offset, length) + "tail"
+            + fileData.right(10);
+    QByteArray received;
+    QDeadlineTimer deadline(30000);
+    while (received.size() < expected.size()) {
+        QVERIFY(!deadline.hasExpired());
+        if (client.bytesToWrite())
+            client.waitForBytesWritten(10);
+        serverSocket->waitForReadyRead(10);
+        received += serverSocket->readAll();
+    }
+    QCOMPARE(client.bytesToWrite(), qint64(0));
+    QCOMPARE(received.size(), expected.size());
+    QVERIFY(received == expected);
+
+    // Invalid arguments
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression("::sendFile: offset \\d+ is outside of the file"));
+    QCOMPARE(client.sendFile(&file, fileData.size() + 1), qint64(-1));
+}
+
 void tst_QLocalSocket::writeToClientAndDisconnect_data()
 {
     QTest::addColumn<int>("chunks");
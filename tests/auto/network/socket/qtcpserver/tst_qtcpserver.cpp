@@ -38,6 +38,8 @@
 #include <QSet>
 #include <QList>
 
+#include <numeric>
+
 #include "../../../network-settings.h"
 
 #if defined(Q_OS_LINUX)
@@ -97,6 +99,9 @@ private slots:
     void pendingConnectionAvailable_data();
     void pendingConnectionAvailable();
 
+    void multipleListeners();
+    void multipleListenersIncomingConnection();
+
 private:
     bool shouldSkipIpv6TestsForBrokenGetsockopt();
 #ifdef SHOULD_CHECK_SYSCALL_SUPPORT
@@ -1135,5 +1140,108 @@ void tst_QTcpServer::pendingConnectionAvailable()
     QCOMPARE(pendingConnectionSpy.count(), 1);
 }
 
+void tst_QTcpServer::multipleListeners()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        QSKIP("Additional listeners are not used through a proxy");
+
+    constexpr int ListenerCount = 4;
+    constexpr int ClientCount = 64;
+
+    QTcpServer server;
+    QCOMPARE(server.listenerCount(), 1);
+    server.setListenerCount(ListenerCount);
+    QCOMPARE(server.listenerCount(), ListenerCount);
+    server.setMaxPendingConnections(ClientCount);
+    QSignalSpy newConnectionSpy(&server, &QTcpServer::newConnection);
+    QVERIFY2(server.listen(QHostAddress::LocalHost), qPrintable(server.errorString()));
+
+#ifdef Q_OS_LINUX
+    QCOMPARE(server.acceptedConnectionCounts().size(), ListenerCount);
+#else
+    QCOMPARE(server.acceptedConnectionCounts().size(), 1);
+#endif
+
+    QList<QTcpSocket *> clients;
+    for (int i = 0; i < ClientCount; ++i) {
+        QTcpSocket *client = new QTcpSocket(this);
+        client->connectToHost(QHostAddress::LocalHost, server.serverPort());
+        clients << client;
+    }
+
+    // Connections accepted in the listeners' threads still end up as
+    // pending connections living in the server's thread
+    QTRY_COMPARE(newConnectionSpy.count(), ClientCount);
+    for (int i = 0; i < ClientCount; ++i) {
+        QTcpSocket *socket = server.nextPendingConnection();
+        QVERIFY(socket);
+        QCOMPARE(socket->thread(), server.thread());
+        QCOMPARE(socket->state(), QAbstractSocket::ConnectedState);
+    }
+    QVERIFY(!server.hasPendingConnections());
+
+    const QList<qint64> counts = server.acceptedConnectionCounts();
+    QCOMPARE(std::accumulate(counts.cbegin(), counts.cend(), qint64(0)), qint64(ClientCount));
+
+    server.close();
+    QCOMPARE(server.acceptedConnectionCounts(), counts);
+    qDeleteAll(clients);
+}
+
+class SocketOwningServer : public QTcpServer
+{
+public:
+    QList<QTcpSocket *> sockets;
+    QSet<QThread *> threads;
+
+protected:
+    void incomingConnection(qintptr socketDescriptor) override
+    {
+        threads.insert(QThread::currentThread());
+        QTcpSocket *socket = new QTcpSocket(this);
+        if (socket->setSocketDescriptor(socketDescriptor))
+            sockets.append(socket);
+    }
+};
+
+void tst_QTcpServer::multipleListenersIncomingConnection()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        QSKIP("Additional listeners are not used through a proxy");
+
+    constexpr int ClientCount = 64;
+
+    auto server = std::make_unique<SocketOwningServer>();
+    server->setListenerCount(4);
+    QSignalSpy newConnectionSpy(server.get(), &QTcpServer::newConnection);
+    QVERIFY2(server->listen(QHostAddress::LocalHost), qPrintable(server->errorString()));
+
+    QList<QTcpSocket *> clients;
+    const auto connectClients = [&] {
+        for (int i = 0; i < ClientCount; ++i) {
+            QTcpSocket *client = new QTcpSocket(this);
+            client->connectToHost(QHostAddress::LocalHost, server->serverPort());
+            clients << client;
+        }
+    };
+    connectClients();
+
+    // A reimplementation is only ever called in the server's thread
+    QTRY_COMPARE(newConnectionSpy.count(), ClientCount);
+    QCOMPARE(server->sockets.size(), ClientCount);
+    QCOMPARE(server->threads, QSet<QThread *>({ QThread::currentThread() }));
+
+    // Destroying the server while listeners accept must not reach the
+    // subclass, and must not leak the connections still in flight
+    connectClients();
+    QTest::qWait(10);
+    server.reset();
+    for (QTcpSocket *client : std::as_const(clients))
+        QTRY_COMPARE(client->state(), QAbstractSocket::UnconnectedState);
+    qDeleteAll(clients);
+}
+
 QTEST_MAIN(tst_QTcpServer)
 #include "tst_qtcpserver.moc"
@@ -23,6 +23,7 @@
 #include <QSignalSpy>
 #include <QAuthenticator>
 #include <QCoreApplication>
+#include <QDeadlineTimer>
 #include <QEventLoop>
 #include <QFile>
 #include <QHostAddress>
@@ -34,7 +35,9 @@
 # include <QProcess>
 #endif
 #include <QRandomGenerator>
+#include <QRegularExpression>
 #include <QStringList>
+#include <QTemporaryFile>
 #include <QTcpServer>
 #include <QTcpSocket>
 #ifndef QT_NO_SSL
@@ -177,6 +180,7 @@ private slots:
     void socketDiscardDataInWriteMode();
     void writeOnReadBufferOverflow();
     void readNotificationsAfterBind();
+    void sendFile();
 
 protected slots:
     void nonBlockingIMAP_hostFound();
@@ -3211,5 +3215,57 @@ void tst_QTcpSocket::readNotificationsAfterBind()
     QCOMPARE(spyReadyRead.count(), 0);
 }
 
+void tst_QTcpSocket::sendFile()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+
+    QTcpServer tcpServer;
+    QVERIFY(tcpServer.listen(QHostAddress::LocalHost));
+    std::unique_ptr<QTcpSocket> socket(newSocket());
+    socket->connectToHost(tcpServer.serverAddress(), tcpServer.serverPort());
+    QVERIFY(socket->waitForConnected(5000));
+    QVERIFY2(tcpServer.waitForNewConnection(5000), "Network timeout");
+    std::unique_ptr<QTcpSocket> serverSocket(tcpServer.nextPendingConnection());
+    QVERIFY(serverSocket);
+
+    QByteArray fileData(3 * 1024 * 1024 + 17, Qt::Uninitialized);
+    for (qsizetype i = 0; i < fileData.size(); ++i)
+        fileData[i] = char(i * 7);
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(fileData), fileData.size());
+    QVERIFY(file.seek(42));
+
+    // Data written around a file must keep its relative order
+    const qint64 offset = 1000;
+    const qint64 length = fileData.size() - 2 * offset;
+    QCOMPARE(socket->write("head"), qint64(4));
+    QCOMPARE(socket->sendFile(&file, offset, length), length);
+    QCOMPARE(socket->write("tail"), qint64(4));
+    QCOMPARE(socket->sendFile(&file, fileData.size() - 10), qint64(10));
+    QCOMPARE(file.pos(), qint64(42));
+
+    const QByteArray expected = "head" + fileData.mid(offset, length) + "tail"
+            + fileData.right(10);
+    QByteArray received;
+    QDeadlineTimer deadline(30000);
+    while (received.size() < expected.size()) {
+        QVERIFY(!deadline.hasExpired());
+        if (socket->bytesToWrite())
+            socket->waitForBytesWritten(10);
+        serverSocket->waitForReadyRead(10);
+        received += serverSocket->readAll();
+    }
+    QCOMPARE(socket->bytesToWrite(), qint64(0));
+    QCOMPARE(received.size(), expected.size());
+    QVERIFY(received == expected);
+
+    // Invalid arguments
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression("::sendFile: offset \\d+ is outside of the file"));
+    QCOMPARE(socket->sendFile(&file, fileData.size() + 1), qint64(-1));
+}
+
 QTEST_MAIN(tst_QTcpSocket)
 #include "tst_qtcpsocket.moc"
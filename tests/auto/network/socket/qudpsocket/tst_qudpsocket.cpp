@@ -101,6 +101,8 @@ private slots:
     void readyRead();
     void readyReadForEmptyDatagram();
     void asyncReadDatagram();
+    void batchedDatagrams_data();
+    void batchedDatagrams();
     void writeInHostLookupState();
 
 protected slots:
@@ -1896,6 +1898,69 @@ void tst_QUdpSocket::asyncReadDatagram()
     delete m_asyncReceiver;
 }
 
+void tst_QUdpSocket::batchedDatagrams_data()
+{
+    QTest::addColumn<qint64>("maxSize");
+    QTest::newRow("unlimited") << qint64(-1);
+    QTest::newRow("truncating") << qint64(4);
+    QTest::newRow("discarding") << qint64(0);
+}
+
+void tst_QUdpSocket::batchedDatagrams()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+    QFETCH(qint64, maxSize);
+
+    // more than the engine passes to the kernel at once
+    constexpr int Count = 40;
+
+    QUdpSocket sender, receiver;
+    QVERIFY(receiver.bind(QHostAddress(QHostAddress::AnyIPv4), 0));
+    const QHostAddress address = makeNonAny(receiver.localAddress());
+    const quint16 port = receiver.localPort();
+    QVERIFY(port != 0);
+
+    // every eighth datagram is too large for the room the engine makes in its storage
+    QList<QNetworkDatagram> outgoing;
+    for (int i = 0; i < Count; ++i) {
+        const QByteArray data = i % 8 == 7 ? QByteArray(10000 + i, char('a' + i % 26))
+                                           : QByteArray::number(i * 1000003);
+        outgoing.append(QNetworkDatagram(data, address, port));
+    }
+
+    QSignalSpy bytesWrittenSpy(&sender, &QUdpSocket::bytesWritten);
+    QCOMPARE(sender.writeDatagrams(outgoing.constData(), outgoing.size()), qsizetype(Count));
+    QCOMPARE(bytesWrittenSpy.size(), 1);
+    qint64 totalBytes = 0;
+    for (const QNetworkDatagram &datagram : std::as_const(outgoing))
+        totalBytes += datagram.data().size();
+    QCOMPARE(bytesWrittenSpy.at(0).at(0).toLongLong(), totalBytes);
+
+    QList<QNetworkDatagram> incoming(Count);
+    int received = 0;
+    while (received < Count) {
+        QVERIFY(receiver.hasPendingDatagrams() || receiver.waitForReadyRead(5000));
+        const qsizetype n = receiver.receiveDatagrams(incoming.data() + received,
+                                                      Count - received, maxSize);
+        QVERIFY2(n >= 0, QtNetworkSettings::msgSocketError(receiver).constData());
+        received += n;
+    }
+    QVERIFY(!receiver.hasPendingDatagrams());
+
+    for (int i = 0; i < Count; ++i) {
+        const QNetworkDatagram &datagram = incoming.at(i);
+        const QByteArray expected = outgoing.at(i).data();
+        QCOMPARE(datagram.data(), maxSize < 0 ? expected : expected.left(maxSize));
+        // doesn't hold on to the room made for a larger datagram
+        if (datagram.data().size() < 1024)
+            QCOMPARE_LT(datagram.data().capacity(), 1024);
+        QCOMPARE(datagram.senderPort(), int(sender.localPort()));
+        QCOMPARE(datagram.destinationPort(), int(port));
+    }
+}
+
 void tst_QUdpSocket::writeInHostLookupState()
 {
     QFETCH_GLOBAL(bool, setProxy);
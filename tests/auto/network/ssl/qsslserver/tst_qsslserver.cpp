@@ -9,6 +9,7 @@
 #include <QtNetwork/QSslServer>
 #include <QtNetwork/QSslKey>
 #include "private/qtlsbackend_p.h"
+#include "private/qsslconfiguration_p.h"
 
 class tst_QSslServer : public QObject
 {
@@ -22,6 +23,7 @@ private slots:
 #if QT_CONFIG(openssl)
     void testHandshakeInterruptedOnError();
     void testPreSharedKeyAuthenticationRequired();
+    void testClientSessionCache();
 #endif
 
 private:
@@ -434,6 +436,62 @@ void tst_QSslServer::testPreSharedKeyAuthenticationRequired()
     QCOMPARE(client.state(), QAbstractSocket::ConnectedState);
 }
 
+void tst_QSslServer::testClientSessionCache()
+{
+    if (!isTestingOpenSsl)
+        QSKIP("The client session cache is only implemented by the OpenSSL backend");
+
+    QSslConfiguration serverConfiguration = selfSignedServerQSslConfiguration();
+    SslServerSpy server(serverConfiguration);
+    QVERIFY(server.server.listen());
+    connect(&server.server, &QTcpServer::pendingConnectionAvailable, this, [&server]() {
+        // With TLS 1.3, the session ticket precedes this byte
+        while (QTcpSocket *socket = server.server.nextPendingConnection())
+            socket->write("x", 1);
+    });
+
+    // Returns 1 if the session was resumed, 0 if not, -1 on failure
+    const auto connectOnce = [&server](const QSslConfiguration &configuration) {
+        QSslSocket client;
+        client.setSslConfiguration(configuration);
+        connect(&client, &QSslSocket::sslErrors, &client, [&client]() {
+            client.ignoreSslErrors();
+        });
+        QSignalSpy readyReadSpy(&client, &QIODevice::readyRead);
+        // The CN of the server's certificate
+        client.connectToHostEncrypted(QHostAddress(QHostAddress::LocalHost).toString(),
+                                      server.server.serverPort(), QStringLiteral("AusweisApp2"));
+        if (!readyReadSpy.wait() || !client.isEncrypted() || client.peerCertificate().isNull())
+            return -1;
+        return int(QSslConfigurationPrivate::peerSessionWasShared(client.sslConfiguration()));
+    };
+
+    QSslConfiguration trusting = QSslConfiguration::defaultConfiguration();
+    trusting.setCaCertificates({ serverConfiguration.localCertificate() });
+    QCOMPARE(connectOnce(trusting), 0);
+    QCOMPARE(connectOnce(trusting), 1);
+    QCOMPARE(connectOnce(trusting), 1);
+
+    // Sessions are only shared between connections with the same configuration
+    QSslConfiguration notSharing = trusting;
+    notSharing.setSslOption(QSsl::SslOptionDisableSessionSharing, true);
+    QCOMPARE(connectOnce(notSharing), 0);
+    QCOMPARE(connectOnce(notSharing), 0);
+
+    // A server not sharing sessions keeps its ticket keys to each connection
+    QSslConfiguration notSharingServer = serverConfiguration;
+    notSharingServer.setSslOption(QSsl::SslOptionDisableSessionSharing, true);
+    server.server.setSslConfiguration(notSharingServer);
+    QCOMPARE(connectOnce(trusting), 0);
+    QCOMPARE(connectOnce(trusting), 0);
+    server.server.setSslConfiguration(serverConfiguration);
+
+    // Resuming would hide the errors of a handshake, so such sessions are not cached
+    const QSslConfiguration untrusting = QSslConfiguration::defaultConfiguration();
+    QCOMPARE(connectOnce(untrusting), 0);
+    QCOMPARE(connectOnce(untrusting), 0);
+}
+
 #endif
 
 QTEST_MAIN(tst_QSslServer)
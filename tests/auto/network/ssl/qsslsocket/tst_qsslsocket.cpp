@@ -9,6 +9,8 @@
 #include <QtCore/qelapsedtimer.h>
 #include <QtCore/qrandom.h>
 #include <QtCore/qscopeguard.h>
+#include <QtCore/qdeadlinetimer.h>
+#include <QtCore/qtemporaryfile.h>
 #include <QtNetwork/qhostaddress.h>
 #include <QtNetwork/qhostinfo.h>
 #include <QtNetwork/qnetworkproxy.h>
@@ -210,6 +212,7 @@ private slots:
     void abortOnSslErrors();
     void readFromClosedSocket();
     void writeBigChunk();
+    void sendFile();
     void blacklistedCertificates();
     void versionAccessors();
     void encryptWithoutConnecting();
@@ -3032,6 +3035,75 @@ void tst_QSslSocket::writeBigChunk()
     socket->close();
 }
 
+void tst_QSslSocket::sendFile()
+{
+    if (!QSslSocket::supportsSsl())
+        return;
+
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+
+    SslServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    QSslSocketPtr client(new QSslSocket);
+    socket = client.data();
+    connect(socket, SIGNAL(sslErrors(QList<QSslError>)), this, SLOT(ignoreErrorSlot()));
+    client->connectToHostEncrypted(QHostAddress(QHostAddress::LocalHost).toString(),
+                                   server.serverPort());
+    QTRY_VERIFY_WITH_TIMEOUT(client->isEncrypted() && server.socket
+                             && server.socket->isEncrypted(), 10000);
+    QSslSocket *receiver = server.socket;
+
+    QByteArray fileData(3 * 1024 * 1024 + 17, Qt::Uninitialized);
+    for (qsizetype i = 0; i < fileData.size(); ++i)
+        fileData[i] = char(i * 7);
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(fileData), fileData.size());
+    QVERIFY(file.seek(42));
+
+    // The file has to be encrypted, so it can't be sent directly; it must
+    // still not be read into memory all at once, and data written around
+    // it must keep its relative order.
+    const qint64 offset = 1000;
+    const qint64 length = fileData.size() - 2 * offset;
+    QCOMPARE(client->write("head"), qint64(4));
+    QCOMPARE(client->sendFile(&file, offset, length), length);
+    QCOMPARE(client->write("tail"), qint64(4));
+    QCOMPARE(client->sendFile(&file, fileData.size() - 10), qint64(10));
+    QCOMPARE(file.pos(), qint64(42));
+    QVERIFY(client->bytesToWrite() > length / 2);
+    QVERIFY(client->encryptedBytesToWrite() < 8 * QIODEVICE_BUFFERSIZE);
+
+    const QByteArray expected = "head" + fileData.mid(offset, length) + "tail"
+            + fileData.right(10);
+    QByteArray received;
+    QDeadlineTimer deadline(30000);
+    connect(receiver, &QIODevice::readyRead, this, [&] {
+        received += receiver->readAll();
+        QVERIFY(client->encryptedBytesToWrite() < 8 * QIODEVICE_BUFFERSIZE);
+        if (received.size() >= expected.size())
+            exitLoop();
+    });
+    enterLoop(30);
+    QVERIFY(!timeout());
+    QCOMPARE(client->bytesToWrite(), qint64(0));
+    QCOMPARE(received.size(), expected.size());
+    QVERIFY(received == expected);
+
+    // What is still queued goes out before the connection is closed
+    QCOMPARE(client->sendFile(&file, 0, 100000), qint64(100000));
+    client->disconnectFromHost();
+    received.clear();
+    connect(receiver, &QAbstractSocket::disconnected, this, &tst_QSslSocket::exitLoop);
+    enterLoop(30);
+    QVERIFY(!timeout());
+    received += receiver->readAll();
+    QVERIFY(received == fileData.left(100000));
+}
+
 void tst_QSslSocket::blacklistedCertificates()
 {
     QFETCH_GLOBAL(bool, setProxy);
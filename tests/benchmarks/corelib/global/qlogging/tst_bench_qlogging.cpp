@@ -0,0 +1,83 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QLoggingCategory>
+#include <QTest>
+#include <QThread>
+
+#include <memory>
+#include <vector>
+
+Q_LOGGING_CATEGORY(lcBench, "bench.logging")
+
+// Formats like the default handler does, but discards the result, so that
+// only the caller-side cost of logging is measured
+static void formattingHandler(QtMsgType type, const QMessageLogContext &context,
+                              const QString &message)
+{
+    const QString formatted = qFormatLogMessage(type, context, message);
+    Q_UNUSED(formatted);
+}
+
+class tst_QLogging : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void info_data();
+    void info();
+
+private:
+    QtMessageHandler oldHandler = nullptr;
+};
+
+void tst_QLogging::initTestCase()
+{
+    oldHandler = qInstallMessageHandler(formattingHandler);
+}
+
+void tst_QLogging::cleanupTestCase()
+{
+    qInstallMessageHandler(oldHandler);
+    qSetMessagePattern(QString());
+}
+
+void tst_QLogging::info_data()
+{
+    QTest::addColumn<QString>("pattern");
+    QTest::addColumn<int>("threadCount");
+
+    const QString plain = QStringLiteral("%{category} %{type}: %{message}");
+    const QString timed = QStringLiteral("%{time yyyy-MM-dd hh:mm:ss.zzz} %{category} %{type}: %{message}");
+    for (int threadCount : { 1, 8, 32 }) {
+        QTest::addRow("plain-%d", threadCount) << plain << threadCount;
+        QTest::addRow("time-%d", threadCount) << timed << threadCount;
+    }
+}
+
+void tst_QLogging::info()
+{
+    QFETCH(QString, pattern);
+    QFETCH(int, threadCount);
+
+    qSetMessagePattern(pattern);
+
+    QBENCHMARK {
+        std::vector<std::unique_ptr<QThread>> threads;
+        for (int t = 0; t < threadCount; ++t) {
+            threads.emplace_back(QThread::create([] {
+                for (int i = 0; i < 1000; ++i)
+                    qCInfo(lcBench, "message number %d from a worker thread", i);
+            }));
+            threads.back()->start();
+        }
+        for (const auto &thread : threads)
+            QVERIFY(thread->wait());
+    }
+}
+
+QTEST_MAIN(tst_QLogging)
+
+#include "tst_bench_qlogging.moc"
@@ -2,7 +2,9 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
 #include <QDebug>
 #include <QDirIterator>
+#include <QFile>
 #include <QString>
+#include <QTemporaryDir>
 #include <qplatformdefs.h>
 
 #ifdef Q_OS_WIN
@@ -29,6 +31,7 @@ class tst_QDirIterator : public QObject
 
     void data();
 private slots:
+    void initTestCase();
     void posix();
     void posix_data() { data(); }
     void diriterator();
@@ -37,8 +40,30 @@ private slots:
     void fsiterator_data() { data(); }
     void stdRecursiveDirectoryIterator();
     void stdRecursiveDirectoryIterator_data() { data(); }
+
+private:
+    QTemporaryDir syntheticTree;
 };
 
+// A tree of 1000 directories with 1000 empty files each
+static constexpr int SyntheticDirCount = 1000;
+static constexpr int SyntheticFilesPerDir = 1000;
+
+void tst_QDirIterator::initTestCase()
+{
+    QVERIFY(syntheticTree.isValid());
+    QDir root(syntheticTree.path());
+    for (int d = 0; d < SyntheticDirCount; ++d) {
+        const QString dirName = QString::number(d);
+        QVERIFY(root.mkdir(dirName));
+        const QString dirPath = root.filePath(dirName) + u'/';
+        for (int f = 0; f < SyntheticFilesPerDir; ++f) {
+            QFile file(dirPath + QString::number(f));
+            QVERIFY(file.open(QIODevice::WriteOnly));
+        }
+    }
+}
+
 void tst_QDirIterator::data()
 {
     const char hereRelative[] = "tests/benchmarks/corelib/io/qdiriterator";
@@ -50,11 +75,11 @@ void tst_QDirIterator::data()
     QTest::addColumn<QByteArray>("dirpath");
     const QByteArray ba = dir + "/src/corelib";
 
-    if (!QFileInfo(QString::fromLocal8Bit(ba)).isDir())
-        QSKIP("Missing Qt directory");
-
-    QTest::newRow("corelib") << ba;
-    QTest::newRow("corelib/io") << (ba + "/io");
+    if (QFileInfo(QString::fromLocal8Bit(ba)).isDir()) {
+        QTest::newRow("corelib") << ba;
+        QTest::newRow("corelib/io") << (ba + "/io");
+    }
+    QTest::newRow("synthetic-1M") << QFile::encodeName(syntheticTree.path());
 }
 
 #ifdef Q_OS_WIN
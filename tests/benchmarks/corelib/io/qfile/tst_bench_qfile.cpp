@@ -81,6 +81,11 @@ private slots:
     void readBigFile_posix() { readBigFile(); }
     void readBigFile_Win32() { readBigFile(); }
 
+    void readAllSmallFiles();
+
+    void mapScan_data();
+    void mapScan();
+
 private:
     void readFile_data(BenchmarkType type, QIODevice::OpenModeFlag t, QIODevice::OpenModeFlag b);
     void readBigFile();
@@ -588,6 +593,64 @@ void tst_qfile::readSmallFiles()
     }
 }
 
+void tst_qfile::readAllSmallFiles()
+{
+    QDir dir(tempDir.path());
+    QStringList files = dir.entryList(QDir::NoDotAndDotDot|QDir::NoSymLinks|QDir::Files);
+    files.removeOne(QFileInfo(tempDir.filename).fileName());
+    for (QString &file : files)
+        file = tempDir.filePath(file);
+
+    QBENCHMARK {
+        qint64 total = 0;
+        for (const QString &fileName : std::as_const(files)) {
+            QFile file(fileName);
+            QVERIFY(file.open(QIODevice::ReadOnly));
+            total += file.readAll().size();
+        }
+        QCOMPARE(total, qint64(files.size()) * 512);
+    }
+}
+
+void tst_qfile::mapScan_data()
+{
+    QTest::addColumn<bool>("randomOrder");
+    QTest::addColumn<int>("flags");
+
+    QTest::newRow("sequential") << false << int(QFileDevice::NoOptions);
+    QTest::newRow("sequential-hint") << false << int(QFileDevice::MapSequentialAccessOption);
+    QTest::newRow("sequential-prefault") << false << int(QFileDevice::MapPrefaultOption);
+    QTest::newRow("random") << true << int(QFileDevice::NoOptions);
+    QTest::newRow("random-hint") << true << int(QFileDevice::MapRandomAccessOption);
+    QTest::newRow("random-prefault") << true << int(QFileDevice::MapPrefaultOption);
+}
+
+void tst_qfile::mapScan()
+{
+    QFETCH(bool, randomOrder);
+    QFETCH(int, flags);
+
+    QFile file(tempDir.filename);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    const qint64 size = file.size();
+    const qint64 pageSize = 4096;
+    const qint64 pages = size / pageSize;
+
+    QBENCHMARK {
+        // map anew each time, so that every iteration pays for its page faults
+        uchar *memory = file.map(0, size, QFileDevice::MemoryMapFlags(flags));
+        QVERIFY(memory);
+        uint sum = 0;
+        for (qint64 i = 0; i < pages; ++i) {
+            // stepping by a prime visits every page exactly once, in scattered order
+            const qint64 page = randomOrder ? (i * 7919) % pages : i;
+            sum += memory[page * pageSize];
+        }
+        [[maybe_unused]] volatile uint sink = sum;
+        QVERIFY(file.unmap(memory));
+    }
+}
+
 QTEST_MAIN(tst_qfile)
 
 #include "tst_bench_qfile.moc"
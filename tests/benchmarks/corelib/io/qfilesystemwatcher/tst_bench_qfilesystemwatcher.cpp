@@ -0,0 +1,81 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QDir>
+#include <QFile>
+#include <QFileSystemWatcher>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+
+// stays below the historical default of 8192 inotify watches per user
+static constexpr int DirCount = 5000;
+
+class tst_QFileSystemWatcher : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase();
+
+    void addPaths();
+    void removePaths();
+    void directoryChanges();
+
+private:
+    QTemporaryDir tree;
+    QStringList directories;
+};
+
+void tst_QFileSystemWatcher::initTestCase()
+{
+    QVERIFY(tree.isValid());
+    QDir root(tree.path());
+    directories.reserve(DirCount);
+    for (int i = 0; i < DirCount; ++i) {
+        const QString name = QString::number(i);
+        QVERIFY(root.mkdir(name));
+        directories.append(root.filePath(name));
+    }
+}
+
+void tst_QFileSystemWatcher::addPaths()
+{
+    QBENCHMARK {
+        QFileSystemWatcher watcher;
+        QVERIFY(watcher.addPaths(directories).isEmpty());
+        QCOMPARE(watcher.directories().size(), DirCount);
+    }
+}
+
+void tst_QFileSystemWatcher::removePaths()
+{
+    QFileSystemWatcher watcher;
+    QBENCHMARK {
+        QVERIFY(watcher.addPaths(directories).isEmpty());
+        QVERIFY(watcher.removePaths(directories).isEmpty());
+        QVERIFY(watcher.directories().isEmpty());
+    }
+}
+
+void tst_QFileSystemWatcher::directoryChanges()
+{
+    QFileSystemWatcher watcher;
+    QVERIFY(watcher.addPaths(directories).isEmpty());
+    QSignalSpy spy(&watcher, &QFileSystemWatcher::directoryChanged);
+
+    // one change in each of the first 1000 directories
+    int round = 0;
+    QBENCHMARK {
+        spy.clear();
+        for (int i = 0; i < 1000; ++i) {
+            QFile file(directories.at(i) + u'/' + QString::number(round));
+            QVERIFY(file.open(QIODevice::WriteOnly));
+        }
+        ++round;
+        QTRY_COMPARE(spy.size(), 1000);
+    }
+}
+
+QTEST_MAIN(tst_QFileSystemWatcher)
+
+#include "tst_bench_qfilesystemwatcher.moc"
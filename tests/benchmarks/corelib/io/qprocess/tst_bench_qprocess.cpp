@@ -13,6 +13,8 @@ class tst_QProcess : public QObject
 private slots:
 
     void echoTest_performance();
+    void startAndFinish_data();
+    void startAndFinish();
 };
 
 #ifdef Q_OS_WIN
@@ -66,5 +68,36 @@ void tst_QProcess::echoTest_performance()
     QVERIFY(process.waitForFinished());
 }
 
+void tst_QProcess::startAndFinish_data()
+{
+    QTest::addColumn<bool>("eventLoop");
+
+    QTest::newRow("blocking") << false;
+    QTest::newRow("event-loop") << true;
+}
+
+void tst_QProcess::startAndFinish()
+{
+    QFETCH(bool, eventLoop);
+    const QString program = QFINDTESTDATA("../testProcessNoop/testProcessNoop" EXE);
+    QVERIFY(!program.isEmpty());
+
+    // 100 short-lived processes per iteration, to measure launch overhead
+    QBENCHMARK {
+        for (int i = 0; i < 100; ++i) {
+            QProcess process;
+            process.start(program, {});
+            if (eventLoop) {
+                QSignalSpy finishedSpy(&process, &QProcess::finished);
+                QVERIFY(finishedSpy.wait(5000));
+            } else {
+                QVERIFY(process.waitForFinished(5000));
+            }
+            QCOMPARE(process.exitStatus(), QProcess::NormalExit);
+            QCOMPARE(process.exitCode(), 0);
+        }
+    }
+}
+
 QTEST_MAIN(tst_QProcess)
 #include "tst_bench_qprocess.moc"
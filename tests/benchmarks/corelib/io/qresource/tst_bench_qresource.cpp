@@ -0,0 +1,70 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QFile>
+#include <QResource>
+#include <QTest>
+
+static constexpr int DirCount = 100;
+static constexpr int FilesPerDir = 100;
+
+class tst_QResource : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase();
+
+    void lookup();
+    void openAll();
+    void openSame();
+
+private:
+    QStringList paths;
+};
+
+void tst_QResource::initTestCase()
+{
+    paths.reserve(DirCount * FilesPerDir);
+    for (int dir = 0; dir < DirCount; ++dir) {
+        for (int file = 0; file < FilesPerDir; ++file)
+            paths.append(QStringLiteral(":/tree/%1/%2.txt").arg(dir).arg(file));
+    }
+    QResource first(paths.first());
+    QVERIFY(first.isValid());
+    QVERIFY(first.compressionAlgorithm() != QResource::NoCompression);
+}
+
+void tst_QResource::lookup()
+{
+    QBENCHMARK {
+        for (const QString &path : std::as_const(paths))
+            QVERIFY(QResource(path).isValid());
+    }
+}
+
+void tst_QResource::openAll()
+{
+    QBENCHMARK {
+        for (const QString &path : std::as_const(paths)) {
+            QFile file(path);
+            QVERIFY(file.open(QIODevice::ReadOnly));
+            QVERIFY(!file.readAll().isEmpty());
+        }
+    }
+}
+
+void tst_QResource::openSame()
+{
+    const QString path = paths.at(paths.size() / 2);
+    QBENCHMARK {
+        for (int i = 0; i < 1000; ++i) {
+            QFile file(path);
+            QVERIFY(file.open(QIODevice::ReadOnly));
+            QVERIFY(!file.readAll().isEmpty());
+        }
+    }
+}
+
+QTEST_MAIN(tst_QResource)
+
+#include "tst_bench_qresource.moc"
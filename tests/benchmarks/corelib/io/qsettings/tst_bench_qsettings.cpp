@@ -0,0 +1,121 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QRandomGenerator>
+#include <QSettings>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QThread>
+
+#include <memory>
+#include <vector>
+
+static constexpr int KeyCount = 50000;
+static constexpr int GroupCount = 100;
+
+class tst_QSettings : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase();
+
+    void coldOpen();
+    void randomReads();
+    void concurrentReads_data();
+    void concurrentReads();
+    void setAndSync();
+
+private:
+    QString fileName;
+    QTemporaryDir dir;
+};
+
+static QString keyName(int i)
+{
+    return QStringLiteral("group%1/key%2").arg(i % GroupCount).arg(i);
+}
+
+void tst_QSettings::initTestCase()
+{
+    QVERIFY(dir.isValid());
+    fileName = dir.filePath(QStringLiteral("large.ini"));
+
+    QSettings settings(fileName, QSettings::IniFormat);
+    for (int i = 0; i < KeyCount; ++i)
+        settings.setValue(keyName(i), QStringLiteral("value number %1").arg(i));
+    settings.sync();
+    QCOMPARE(settings.status(), QSettings::NoError);
+}
+
+void tst_QSettings::coldOpen()
+{
+    // Only the first open of a file in a process reads it from disk
+    QBENCHMARK_ONCE {
+        QSettings settings(fileName, QSettings::IniFormat);
+        QCOMPARE(settings.value(keyName(KeyCount / 2)).toString(),
+                 QStringLiteral("value number %1").arg(KeyCount / 2));
+    }
+}
+
+void tst_QSettings::randomReads()
+{
+    QSettings settings(fileName, QSettings::IniFormat);
+    QList<QString> keys;
+    for (int i = 0; i < 10000; ++i)
+        keys.append(keyName(QRandomGenerator::global()->bounded(KeyCount)));
+
+    QBENCHMARK {
+        for (const QString &key : std::as_const(keys))
+            QVERIFY(settings.contains(key));
+    }
+}
+
+void tst_QSettings::concurrentReads_data()
+{
+    QTest::addColumn<int>("threadCount");
+
+    QTest::newRow("1") << 1;
+    QTest::newRow("4") << 4;
+    QTest::newRow("16") << 16;
+}
+
+void tst_QSettings::concurrentReads()
+{
+    QFETCH(int, threadCount);
+
+    // warm up, so that all threads share the parsed file
+    {
+        QSettings settings(fileName, QSettings::IniFormat);
+        QVERIFY(settings.contains(keyName(0)));
+    }
+
+    QBENCHMARK {
+        std::vector<std::unique_ptr<QThread>> threads;
+        for (int t = 0; t < threadCount; ++t) {
+            threads.emplace_back(QThread::create([this, t] {
+                QSettings settings(fileName, QSettings::IniFormat);
+                for (int i = 0; i < 2000; ++i)
+                    settings.value(keyName((t * 7919 + i * 104729) % KeyCount));
+            }));
+            threads.back()->start();
+        }
+        for (const auto &thread : threads)
+            QVERIFY(thread->wait());
+    }
+}
+
+void tst_QSettings::setAndSync()
+{
+    QSettings settings(fileName, QSettings::IniFormat);
+    int i = 0;
+
+    QBENCHMARK {
+        settings.setValue(keyName(i++ % KeyCount), i);
+        settings.sync();
+    }
+    QCOMPARE(settings.status(), QSettings::NoError);
+}
+
+QTEST_MAIN(tst_QSettings)
+
+#include "tst_bench_qsettings.moc"
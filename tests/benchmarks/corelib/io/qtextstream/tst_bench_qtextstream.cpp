@@ -5,18 +5,46 @@
 #include <QIODevice>
 #include <QString>
 #include <QBuffer>
+#include <QTemporaryFile>
 #include <qtest.h>
 
 class tst_QTextStream : public QObject
 {
     Q_OBJECT
 private slots:
+    void initTestCase();
+
     void writeSingleChar_data();
     void writeSingleChar();
+    void readLineInto_data();
+    void readLineInto();
+    void readLineFromFile();
+    void readIntegers();
+    void readDoubles();
 
 private:
+    QByteArray csv;
+    QTemporaryFile csvFile;
 };
 
+static QByteArray csvData(int lines, const char *lineEnd)
+{
+    QByteArray data;
+    for (int i = 0; i < lines; ++i) {
+        data += QByteArray::number(i) + ',' + QByteArray::number(i * 31 % 1000)
+                + ",some text field," + QByteArray::number(i / 7.0, 'g', 10) + lineEnd;
+    }
+    return data;
+}
+
+void tst_QTextStream::initTestCase()
+{
+    csv = csvData(100000, "\n");
+    QVERIFY(csvFile.open());
+    QCOMPARE(csvFile.write(csv), csv.size());
+    QVERIFY(csvFile.flush());
+}
+
 enum Output { StringOutput, DeviceOutput };
 Q_DECLARE_METATYPE(Output);
 
@@ -90,6 +118,86 @@ void tst_QTextStream::writeSingleChar()
     QCOMPARE(result.left(10), QString("hhhhhhhhhh"));
 }
 
+void tst_QTextStream::readLineInto_data()
+{
+    QTest::addColumn<QByteArray>("data");
+
+    QTest::newRow("lf") << csv;
+    QTest::newRow("crlf") << csvData(100000, "\r\n");
+}
+
+void tst_QTextStream::readLineInto()
+{
+    QFETCH(QByteArray, data);
+
+    QBENCHMARK {
+        QBuffer buffer(&data);
+        QVERIFY(buffer.open(QIODevice::ReadOnly));
+        QTextStream stream(&buffer);
+        QString line;
+        int lines = 0;
+        while (stream.readLineInto(&line))
+            ++lines;
+        QCOMPARE(lines, 100000);
+    }
+}
+
+void tst_QTextStream::readLineFromFile()
+{
+    QBENCHMARK {
+        QFile file(csvFile.fileName());
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        QTextStream stream(&file);
+        QString line;
+        int lines = 0;
+        while (stream.readLineInto(&line))
+            ++lines;
+        QCOMPARE(lines, 100000);
+    }
+}
+
+void tst_QTextStream::readIntegers()
+{
+    QByteArray data;
+    for (int i = 0; i < 100000; ++i)
+        data += QByteArray::number(i * 13) + ' ';
+
+    QBENCHMARK {
+        QBuffer buffer(&data);
+        QVERIFY(buffer.open(QIODevice::ReadOnly));
+        QTextStream stream(&buffer);
+        qint64 sum = 0;
+        int value;
+        for (int i = 0; i < 100000; ++i) {
+            stream >> value;
+            sum += value;
+        }
+        QCOMPARE(stream.status(), QTextStream::Ok);
+        QVERIFY(sum > 0);
+    }
+}
+
+void tst_QTextStream::readDoubles()
+{
+    QByteArray data;
+    for (int i = 0; i < 100000; ++i)
+        data += QByteArray::number(i / 7.0, 'g', 10) + ' ';
+
+    QBENCHMARK {
+        QBuffer buffer(&data);
+        QVERIFY(buffer.open(QIODevice::ReadOnly));
+        QTextStream stream(&buffer);
+        double sum = 0;
+        double value;
+        for (int i = 0; i < 100000; ++i) {
+            stream >> value;
+            sum += value;
+        }
+        QCOMPARE(stream.status(), QTextStream::Ok);
+        QVERIFY(sum > 0);
+    }
+}
+
 QTEST_MAIN(tst_QTextStream)
 
 #include "tst_bench_qtextstream.moc"
@@ -23,6 +23,9 @@ private slots:
     void equality_data();
     void equality();
     void qmlPropertyWriteUseCase();
+    void components();
+    void toEncoded_data();
+    void toEncoded();
 
 private:
     void generateFirstRunData();
@@ -180,6 +183,40 @@ void tst_QUrl::qmlPropertyWriteUseCase()
     }
 }
 
+void tst_QUrl::components()
+{
+    const QString str = QStringLiteral("https://user@www.example.com:8080/api/v2/Resources/"
+                                       "Item12345/details?format=json&lang=en#section2");
+
+    QBENCHMARK {
+        QUrl u(str);
+        [[maybe_unused]] auto host = u.host();
+        [[maybe_unused]] auto path = u.path();
+        [[maybe_unused]] auto query = u.query();
+    }
+}
+
+void tst_QUrl::toEncoded_data()
+{
+    QTest::addColumn<QUrl>("url");
+
+    QTest::newRow("ascii") << QUrl("http://www.example.com/SomeLongDirectoryName/"
+                                   "AnotherDirectory2023/yet/more/path/Components/file.html");
+    QTest::newRow("encoded") << QUrl("http://www.example.com/some%20dir/other%20dir/"
+                                     "with spaces and %C3%BCml%C3%A4uts/file name.html");
+    QTest::newRow("unicode") << QUrl(QString::fromUtf8("http://www.example.com/k\xc3\xb6ln/"
+                                                       "stra\xc3\x9f" "e/m\xc3\xbcnchen/index.html"));
+}
+
+void tst_QUrl::toEncoded()
+{
+    QFETCH(QUrl, url);
+
+    QBENCHMARK {
+        [[maybe_unused]] auto r = url.toEncoded();
+    }
+}
+
 QTEST_MAIN(tst_QUrl)
 
 #include "tst_bench_qurl.moc"
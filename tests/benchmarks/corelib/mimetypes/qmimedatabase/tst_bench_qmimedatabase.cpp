@@ -4,6 +4,7 @@
 
 #include <QTest>
 #include <QMimeDatabase>
+#include <QTemporaryDir>
 
 namespace {
 struct MatchModeInfo
@@ -45,6 +46,12 @@ private slots:
     void benchMimeTypeForName();
     void benchMimeTypeForFile_data();
     void benchMimeTypeForFile();
+    void benchMimeTypesForFileName_data();
+    void benchMimeTypesForFileName();
+    void benchMimeTypeForData_data();
+    void benchMimeTypeForData();
+    void benchMimeTypeForFileMix();
+    void benchMimeTypeForFileMixUncached();
 };
 
 void tst_QMimeDatabase::inheritsPerformance()
@@ -128,12 +135,151 @@ void tst_QMimeDatabase::benchMimeTypeForFile()
 
     QMimeDatabase db;
 
+    // On Unix, the results for existent files are cached after the first
+    // iteration, unless matching by extension only
     QBENCHMARK {
         const auto mimeType = db.mimeTypeForFile(fileName, mode);
         QCOMPARE(mimeType.name(), expectedMimeName);
     }
 }
 
+void tst_QMimeDatabase::benchMimeTypesForFileName_data()
+{
+    QTest::addColumn<QString>("fileName");
+    QTest::addColumn<QString>("expectedMimeName");
+
+    QTest::newRow("extension") << "u.txt" << "text/plain";
+    QTest::newRow("upper-case extension") << "U.TXT" << "text/plain";
+    QTest::newRow("compound extension") << "a.tar.gz" << "application/x-compressed-tar";
+    QTest::newRow("literal") << "Makefile" << "text/x-makefile";
+    QTest::newRow("wildcard") << "README" << "text/x-readme";
+    QTest::newRow("no match") << "X" << QString();
+}
+
+void tst_QMimeDatabase::benchMimeTypesForFileName()
+{
+    QFETCH(const QString, fileName);
+    QFETCH(const QString, expectedMimeName);
+
+    QMimeDatabase db;
+
+    // Glob matching only, without looking at the file
+    QBENCHMARK {
+        const auto mimeTypes = db.mimeTypesForFileName(fileName);
+        QCOMPARE(mimeTypes.value(0).name(), expectedMimeName);
+    }
+}
+
+static QByteArray binaryData(qsizetype size)
+{
+    // deterministic bytes that no magic rule should recognize
+    QByteArray data(size, Qt::Uninitialized);
+    quint32 state = 0x12345678;
+    for (char &c : data) {
+        state = state * 1103515245 + 12345;
+        c = char(state >> 24);
+    }
+    data[0] = '\x01';
+    return data;
+}
+
+void tst_QMimeDatabase::benchMimeTypeForData_data()
+{
+    QTest::addColumn<QByteArray>("data");
+    QTest::addColumn<QString>("expectedMimeName");
+
+    QTest::newRow("png") << QByteArray("\x89PNG\r\n\x1a\n\0\0\0\rIHDR", 16) + binaryData(512)
+                         << "image/png";
+    QTest::newRow("pdf") << "%PDF-1.7\n%\xe2\xe3\xcf\xd3\n" + binaryData(512) << "application/pdf";
+    QTest::newRow("gzip") << QByteArray("\x1f\x8b\x08\0\0\0\0\0", 8) + binaryData(512)
+                          << "application/gzip";
+    QTest::newRow("text") << QByteArray("Lorem ipsum dolor sit amet, consectetur adipiscing "
+                                        "elit.\n").repeated(10)
+                          << "text/plain";
+    QTest::newRow("unknown binary") << binaryData(2048) << "application/octet-stream";
+}
+
+void tst_QMimeDatabase::benchMimeTypeForData()
+{
+    QFETCH(const QByteArray, data);
+    QFETCH(const QString, expectedMimeName);
+
+    QMimeDatabase db;
+
+    QBENCHMARK {
+        const auto mimeType = db.mimeTypeForData(data);
+        QCOMPARE(mimeType.name(), expectedMimeName);
+    }
+}
+
+// A mix of files like an upload service would see, with and without extensions
+static void createFileMix(const QTemporaryDir &dir, QStringList *files)
+{
+    QVERIFY(dir.isValid());
+    const QByteArray contents[] = {
+        QByteArray("\x89PNG\r\n\x1a\n\0\0\0\rIHDR", 16) + binaryData(4096),
+        "%PDF-1.7\n" + binaryData(4096),
+        QByteArray("\x1f\x8b\x08\0\0\0\0\0", 8) + binaryData(4096),
+        QByteArray("<!DOCTYPE html>\n<html><body>hello</body></html>\n"),
+        QByteArray("{ \"key\": \"value\" }\n"),
+        QByteArray("plain text\n").repeated(100),
+        binaryData(4096),
+    };
+    const char *suffixes[] = { ".png", ".pdf", ".gz", ".html", ".json", ".txt", "" };
+    for (int i = 0; i < 700; ++i) {
+        const int kind = i % std::size(contents);
+        // every other file of each kind has no extension, to force content matching
+        const char *suffix = (i / std::size(contents)) % 2 ? "" : suffixes[kind];
+        const QString fileName = dir.filePath(QString::number(i) + QLatin1StringView(suffix));
+        QFile file(fileName);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write(contents[kind]);
+        files->append(fileName);
+    }
+}
+
+void tst_QMimeDatabase::benchMimeTypeForFileMix()
+{
+    QTemporaryDir dir;
+    QStringList files;
+    createFileMix(dir, &files);
+    if (QTest::currentTestFailed())
+        return;
+
+    QMimeDatabase db;
+    for (const QString &fileName : std::as_const(files))
+        db.mimeTypeForFile(fileName);
+
+    // On Unix, these lookups are all answered from the cache
+    QBENCHMARK {
+        for (const QString &fileName : std::as_const(files))
+            QVERIFY(db.mimeTypeForFile(fileName).isValid());
+    }
+}
+
+void tst_QMimeDatabase::benchMimeTypeForFileMixUncached()
+{
+    QTemporaryDir dir;
+    QStringList files;
+    createFileMix(dir, &files);
+    if (QTest::currentTestFailed())
+        return;
+
+    QMimeDatabase db;
+    const auto matchFiles = [&] {
+        for (const QString &fileName : std::as_const(files)) {
+            QFile file(fileName);
+            QVERIFY(db.mimeTypeForFileNameAndData(fileName, &file).isValid());
+        }
+    };
+    matchFiles(); // loads the globs and magic rules
+
+    // The glob and magic matching that mimeTypeForFile() does on a cache miss
+    QBENCHMARK {
+        matchFiles();
+    }
+}
+
 QTEST_MAIN(tst_QMimeDatabase)
 
 #include "tst_bench_qmimedatabase.moc"
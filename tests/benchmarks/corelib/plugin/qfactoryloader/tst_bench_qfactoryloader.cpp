@@ -0,0 +1,89 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <private/qfactoryloader_p.h>
+
+static constexpr int PluginCount = 300;
+static constexpr char PluginIid[] = "org.qt-project.Qt.benchmarks.qfactoryloader";
+
+class tst_QFactoryLoader : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase();
+
+    void uncachedScan();
+    void cachedScan();
+
+private:
+    QTemporaryDir dir;
+    QString cacheFile;
+};
+
+#ifdef QT_BUILD_INTERNAL
+extern void qt_resetPluginMetaDataCache();
+#endif
+
+static void scanPlugins()
+{
+    QFactoryLoader loader(PluginIid, QStringLiteral("/bench"));
+    QCOMPARE(loader.metaData().size(), PluginCount);
+}
+
+void tst_QFactoryLoader::initTestCase()
+{
+    QVERIFY(dir.isValid());
+
+    // Use a plugin metadata cache of our own. This must happen before the
+    // first plugin is scanned.
+    cacheFile = dir.filePath("cache.cbor");
+    qputenv("QT_PLUGIN_METADATA_CACHE", QFile::encodeName(cacheFile));
+
+    // Many copies of the same plugin, to simulate a populated plugin directory
+    const QFileInfo plugin(QStringLiteral(PLUGIN_PATH));
+    QVERIFY2(plugin.exists(), qPrintable(plugin.filePath()));
+    QVERIFY(QDir(dir.path()).mkdir(QStringLiteral("bench")));
+    for (int i = 0; i < PluginCount; ++i) {
+        const QString copy = dir.filePath(QStringLiteral("bench/plugin%1.").arg(i) + plugin.suffix());
+        QVERIFY(QFile::copy(plugin.filePath(), copy));
+    }
+    QCoreApplication::setLibraryPaths({ dir.path() });
+}
+
+void tst_QFactoryLoader::uncachedScan()
+{
+#ifndef QT_BUILD_INTERNAL
+    QSKIP("Clearing the plugin metadata cache requires a developer build of Qt");
+#else
+    // Reads every plugin and fills the cache
+    QBENCHMARK {
+        qt_resetPluginMetaDataCache();
+        QFile::remove(cacheFile);
+        scanPlugins();
+    }
+#endif
+}
+
+void tst_QFactoryLoader::cachedScan()
+{
+    scanPlugins();
+
+    // Like a new process, which finds the cache on disk. Without a developer
+    // build, only the first iteration does.
+    QBENCHMARK {
+#ifdef QT_BUILD_INTERNAL
+        qt_resetPluginMetaDataCache();
+#endif
+        scanPlugins();
+    }
+}
+
+QTEST_MAIN(tst_QFactoryLoader)
+
+#include "tst_bench_qfactoryloader.moc"
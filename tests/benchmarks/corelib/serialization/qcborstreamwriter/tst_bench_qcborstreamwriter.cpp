@@ -0,0 +1,128 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QCborArray>
+#include <QCborMap>
+#include <QCborStreamWriter>
+#include <QCborValue>
+#include <QTest>
+
+// A device that discards its input, to measure the encoder on its own
+class NullDevice : public QIODevice
+{
+public:
+    NullDevice() { open(QIODevice::WriteOnly | QIODevice::Unbuffered); }
+    bool isSequential() const override { return true; }
+
+    qint64 bytes = 0;
+
+protected:
+    qint64 readData(char *, qint64) override { return -1; }
+    qint64 writeData(const char *, qint64 len) override
+    {
+        bytes += len;
+        return len;
+    }
+};
+
+class tst_QCborStreamWriter : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase();
+
+    void messageToByteArray_data();
+    void messageToByteArray();
+    void messageToDevice_data();
+    void messageToDevice();
+    void valueToCbor_data();
+    void valueToCbor();
+
+private:
+    QByteArray attachment;
+};
+
+static void writeMessage(QCborStreamWriter &writer, const QByteArray &attachment, int count)
+{
+    writer.startMap(3);
+    writer.append(QLatin1StringView("id"));
+    writer.append(quint64(42));
+    writer.append(QLatin1StringView("type"));
+    writer.append(QLatin1StringView("upload"));
+    writer.append(QLatin1StringView("attachments"));
+    writer.startArray(count);
+    for (int i = 0; i < count; ++i)
+        writer.append(attachment);
+    writer.endArray();
+    writer.endMap();
+}
+
+void tst_QCborStreamWriter::initTestCase()
+{
+    attachment = QByteArray(1024 * 1024, 'a');
+}
+
+void tst_QCborStreamWriter::messageToByteArray_data()
+{
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("1x1MB") << 1;
+    QTest::newRow("16x1MB") << 16;
+}
+
+void tst_QCborStreamWriter::messageToByteArray()
+{
+    QFETCH(int, count);
+
+    QBENCHMARK {
+        QByteArray result;
+        QCborStreamWriter writer(&result);
+        writeMessage(writer, attachment, count);
+        QVERIFY(result.size() > count * attachment.size());
+    }
+}
+
+void tst_QCborStreamWriter::messageToDevice_data()
+{
+    messageToByteArray_data();
+}
+
+void tst_QCborStreamWriter::messageToDevice()
+{
+    QFETCH(int, count);
+
+    QBENCHMARK {
+        NullDevice sink;
+        QCborStreamWriter writer(&sink);
+        writeMessage(writer, attachment, count);
+        QVERIFY(sink.bytes > count * attachment.size());
+    }
+}
+
+void tst_QCborStreamWriter::valueToCbor_data()
+{
+    messageToByteArray_data();
+}
+
+void tst_QCborStreamWriter::valueToCbor()
+{
+    QFETCH(int, count);
+
+    QCborArray attachments;
+    for (int i = 0; i < count; ++i)
+        attachments.append(attachment);
+    const QCborMap message = {
+        { QLatin1StringView("id"), 42 },
+        { QLatin1StringView("type"), QLatin1StringView("upload") },
+        { QLatin1StringView("attachments"), attachments },
+    };
+
+    QBENCHMARK {
+        const QByteArray result = message.toCborValue().toCbor();
+        QVERIFY(result.size() > count * attachment.size());
+    }
+}
+
+QTEST_MAIN(tst_QCborStreamWriter)
+
+#include "tst_bench_qcborstreamwriter.moc"
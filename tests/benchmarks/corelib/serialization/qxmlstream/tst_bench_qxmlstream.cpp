@@ -0,0 +1,145 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QBuffer>
+#include <QXmlStreamReader>
+#include <QTest>
+
+class tst_QXmlStream : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase();
+
+    void readAll_data();
+    void readAll();
+    void readAllFromDevice_data();
+    void readAllFromDevice();
+    void readElementText();
+
+private:
+    QByteArray textHeavy;
+    QByteArray attributeHeavy;
+    QByteArray indented;
+};
+
+static QByteArray textHeavyDocument()
+{
+    QByteArray xml = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<feed>";
+    for (int i = 0; i < 2000; ++i) {
+        xml += "<entry><title>Entry number ";
+        xml += QByteArray::number(i);
+        xml += "</title><summary>Lorem ipsum dolor sit amet, consectetur adipiscing elit, "
+               "sed do eiusmod tempor incididunt ut labore et dolore magna aliqua. Ut enim "
+               "ad minim veniam, quis nostrud exercitation ullamco laboris nisi ut aliquip "
+               "ex ea commodo consequat &amp; more. Gr\xc3\xbc\xc3\x9f" "e aus K\xc3\xb6ln."
+               "</summary></entry>";
+    }
+    xml += "</feed>\n";
+    return xml;
+}
+
+static QByteArray attributeHeavyDocument()
+{
+    QByteArray xml = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<rows>";
+    for (int i = 0; i < 5000; ++i) {
+        const QByteArray n = QByteArray::number(i);
+        xml += "<row id=\"" + n + "\" name=\"row number " + n
+                + "\" url=\"https://www.example.com/some/path/to/resource?id=" + n
+                + "\" description='a somewhat longer attribute value to be scanned'/>";
+    }
+    xml += "</rows>\n";
+    return xml;
+}
+
+static QByteArray indentedDocument()
+{
+    QByteArray xml = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<tree>\n";
+    for (int i = 0; i < 5000; ++i) {
+        const QByteArray indent(4 + (i % 8) * 4, ' ');
+        xml += indent + "<node>\n" + indent + "    <leaf>x</leaf>\n"
+                + indent + "\t<leaf>y</leaf>\n" + indent + "</node>\n";
+    }
+    xml += "</tree>\n";
+    return xml;
+}
+
+void tst_QXmlStream::initTestCase()
+{
+    textHeavy = textHeavyDocument();
+    attributeHeavy = attributeHeavyDocument();
+    indented = indentedDocument();
+}
+
+void tst_QXmlStream::readAll_data()
+{
+    QTest::addColumn<QByteArray>("xml");
+
+    QTest::newRow("text") << textHeavy;
+    QTest::newRow("attributes") << attributeHeavy;
+    QTest::newRow("whitespace") << indented;
+}
+
+void tst_QXmlStream::readAll()
+{
+    QFETCH(QByteArray, xml);
+
+    QBENCHMARK {
+        QXmlStreamReader reader(xml);
+        qsizetype total = 0;
+        while (!reader.atEnd()) {
+            switch (reader.readNext()) {
+            case QXmlStreamReader::Characters:
+                total += reader.text().size();
+                break;
+            case QXmlStreamReader::StartElement:
+                for (const QXmlStreamAttribute &attribute : reader.attributes())
+                    total += attribute.value().size();
+                break;
+            default:
+                break;
+            }
+        }
+        QVERIFY2(!reader.hasError(), qPrintable(reader.errorString()));
+        QVERIFY(total > 0);
+    }
+}
+
+void tst_QXmlStream::readAllFromDevice_data()
+{
+    readAll_data();
+}
+
+void tst_QXmlStream::readAllFromDevice()
+{
+    QFETCH(QByteArray, xml);
+
+    QBENCHMARK {
+        QBuffer buffer(&xml);
+        QVERIFY(buffer.open(QIODevice::ReadOnly));
+        QXmlStreamReader reader(&buffer);
+        while (!reader.atEnd())
+            reader.readNext();
+        QVERIFY2(!reader.hasError(), qPrintable(reader.errorString()));
+    }
+}
+
+void tst_QXmlStream::readElementText()
+{
+    QBENCHMARK {
+        QXmlStreamReader reader(textHeavy);
+        qsizetype total = 0;
+        while (!reader.atEnd()) {
+            if (reader.readNext() == QXmlStreamReader::StartElement
+                && (reader.name() == u"title" || reader.name() == u"summary")) {
+                total += reader.readElementText().size();
+            }
+        }
+        QVERIFY2(!reader.hasError(), qPrintable(reader.errorString()));
+        QVERIFY(total > 0);
+    }
+}
+
+QTEST_MAIN(tst_QXmlStream)
+
+#include "tst_bench_qxmlstream.moc"
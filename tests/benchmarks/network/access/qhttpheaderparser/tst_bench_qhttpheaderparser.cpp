@@ -0,0 +1,122 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+
+#include <QtNetwork/private/qhttpheaderparser_p.h>
+
+QT_USE_NAMESPACE
+
+// What a small JSON API response and a static file response typically
+// come with, as sent by common servers and CDNs.
+static const char apiResponse[] =
+        "Date: Mon, 21 Nov 2022 10:04:32 GMT\r\n"
+        "Content-Type: application/json; charset=utf-8\r\n"
+        "Content-Length: 187\r\n"
+        "Connection: keep-alive\r\n"
+        "Cache-Control: no-cache, no-store, must-revalidate\r\n"
+        "Vary: Accept-Encoding\r\n"
+        "Vary: Origin\r\n"
+        "Access-Control-Allow-Origin: *\r\n"
+        "Strict-Transport-Security: max-age=31536000; includeSubDomains\r\n"
+        "X-Content-Type-Options: nosniff\r\n"
+        "X-Request-Id: 4f1c2a9e-7b3d-4c8e-9a61-0d2e5f7b8c91\r\n"
+        "Server: nginx\r\n"
+        "\r\n";
+
+static const char staticFileResponse[] =
+        "accept-ranges: bytes\r\n"
+        "age: 5234\r\n"
+        "cache-control: public, max-age=31536000, immutable\r\n"
+        "content-encoding: gzip\r\n"
+        "content-type: text/javascript\r\n"
+        "date: Mon, 21 Nov 2022 10:04:32 GMT\r\n"
+        "etag: \"5f8a7c1e-3b2d\"\r\n"
+        "last-modified: Fri, 16 Oct 2020 12:34:56 GMT\r\n"
+        "server: cloudflare\r\n"
+        "transfer-encoding: chunked\r\n"
+        "vary: Accept-Encoding\r\n"
+        "x-cache: HIT\r\n"
+        "\r\n";
+
+class tst_QHttpHeaderParser : public QObject
+{
+    Q_OBJECT
+private slots:
+    void parseHeaders_data();
+    void parseHeaders();
+    void parseAndLookUp_data();
+    void parseAndLookUp();
+    void parseAndCopyHeaders_data();
+    void parseAndCopyHeaders();
+};
+
+static void addRows()
+{
+    QTest::addColumn<QByteArray>("headers");
+
+    QTest::newRow("api") << QByteArray(apiResponse);
+    QTest::newRow("static-file") << QByteArray(staticFileResponse);
+}
+
+void tst_QHttpHeaderParser::parseHeaders_data()
+{
+    addRows();
+}
+
+void tst_QHttpHeaderParser::parseHeaders()
+{
+    QFETCH(QByteArray, headers);
+
+    QBENCHMARK {
+        QHttpHeaderParser parser;
+        if (!parser.parseHeaders(headers))
+            QFAIL("Parsing failed");
+    }
+}
+
+void tst_QHttpHeaderParser::parseAndLookUp_data()
+{
+    addRows();
+}
+
+// What QHttpNetworkReply asks for after every response
+void tst_QHttpHeaderParser::parseAndLookUp()
+{
+    QFETCH(QByteArray, headers);
+
+    qsizetype found = 0;
+    QBENCHMARK {
+        QHttpHeaderParser parser;
+        parser.parseHeaders(headers);
+        found += parser.firstHeaderField("content-length").size();
+        found += parser.combinedHeaderValue("transfer-encoding").size();
+        found += parser.combinedHeaderValue("connection").size();
+        found += parser.combinedHeaderValue("proxy-connection").size();
+        found += parser.combinedHeaderValue("content-encoding").size();
+    }
+    QVERIFY(found > 0);
+}
+
+void tst_QHttpHeaderParser::parseAndCopyHeaders_data()
+{
+    addRows();
+}
+
+// QNetworkReplyHttpImpl copies all of them into the QNetworkReply
+void tst_QHttpHeaderParser::parseAndCopyHeaders()
+{
+    QFETCH(QByteArray, headers);
+
+    QBENCHMARK {
+        QHttpHeaderParser parser;
+        parser.parseHeaders(headers);
+        const auto fields = parser.headers();
+        if (fields.size() != 12)
+            QFAIL("Wrong number of fields");
+    }
+}
+
+QTEST_MAIN(tst_QHttpHeaderParser)
+
+#include "tst_bench_qhttpheaderparser.moc"
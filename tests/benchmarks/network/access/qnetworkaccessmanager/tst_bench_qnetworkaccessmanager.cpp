@@ -0,0 +1,340 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+#include <QTestEventLoop>
+#include <QSemaphore>
+#include <QThread>
+#include <QTimer>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QHttp1Configuration>
+#include <QHttp2Configuration>
+#include <QHttpConnectionPoolStatistics>
+#include <QtEndian>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+
+// A keep-alive HTTP/1.1 server in its own thread, answering each request
+// after a fixed delay, like a backend that needs some time per request.
+class LatencyHttpServer : public QThread
+{
+public:
+    explicit LatencyHttpServer(int latency) : latency(latency) {}
+
+    ~LatencyHttpServer()
+    {
+        quit();
+        wait();
+    }
+
+    quint16 serverPort()
+    {
+        start();
+        ready.acquire();
+        return port;
+    }
+
+protected:
+    void run() override
+    {
+        QTcpServer server;
+        server.listen(QHostAddress::LocalHost);
+        port = server.serverPort();
+        QObject::connect(&server, &QTcpServer::newConnection, &server, [&server, this] {
+            while (QTcpSocket *socket = server.nextPendingConnection())
+                serve(socket);
+        });
+        ready.release();
+        exec();
+    }
+
+private:
+    void serve(QTcpSocket *socket)
+    {
+        auto buffer = std::make_shared<QByteArray>();
+        QObject::connect(socket, &QTcpSocket::readyRead, socket, [socket, buffer, this] {
+            buffer->append(socket->readAll());
+            qsizetype end;
+            while ((end = buffer->indexOf("\r\n\r\n")) >= 0) {
+                buffer->remove(0, end + 4);
+                QTimer::singleShot(latency, socket, [socket] {
+                    socket->write("HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nok");
+                });
+            }
+        });
+        QObject::connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+    }
+
+    const int latency;
+    quint16 port = 0;
+    QSemaphore ready;
+};
+
+// A minimal cleartext HTTP/2 server (prior knowledge only) in its own
+// thread. It answers every request with the same body, honoring the
+// client's flow control windows, and handles whatever it receives only
+// after a delay: the client sees a round-trip time of about that delay.
+class DelayedHttp2Server : public QThread
+{
+public:
+    DelayedHttp2Server(int delay, const QByteArray &body) : delay(delay), body(body) {}
+
+    ~DelayedHttp2Server()
+    {
+        quit();
+        wait();
+    }
+
+    quint16 serverPort()
+    {
+        start();
+        ready.acquire();
+        return port;
+    }
+
+protected:
+    void run() override
+    {
+        QTcpServer server;
+        server.listen(QHostAddress::LocalHost);
+        port = server.serverPort();
+        QObject::connect(&server, &QTcpServer::newConnection, &server, [&server, this] {
+            while (QTcpSocket *socket = server.nextPendingConnection())
+                serve(socket);
+        });
+        ready.release();
+        exec();
+    }
+
+private:
+    enum FrameType : char { Data = 0, Headers = 1, Settings = 4, Ping = 6, WindowUpdate = 8 };
+    enum FrameFlag : char { EndStream = 0x1, Ack = 0x1, EndHeaders = 0x4 };
+
+    struct Connection
+    {
+        QByteArray buffer;
+        bool prefaceReceived = false;
+        qint64 sessionWindow = 65535;
+        qint64 initialStreamWindow = 65535;
+        struct Stream
+        {
+            qint64 window = 0;
+            qsizetype sent = 0;
+        };
+        std::map<quint32, Stream> streams;
+    };
+
+    static QByteArray frame(char type, char flags, quint32 streamID, QByteArrayView payload = {})
+    {
+        QByteArray frame(9, Qt::Uninitialized);
+        qToBigEndian(quint32(payload.size()) << 8 | quint8(type), frame.data());
+        frame[4] = flags;
+        qToBigEndian(streamID, frame.data() + 5);
+        return frame.append(payload);
+    }
+
+    void serve(QTcpSocket *socket)
+    {
+        auto connection = std::make_shared<Connection>();
+        QObject::connect(socket, &QTcpSocket::readyRead, socket, [socket, connection, this] {
+            QTimer::singleShot(delay, Qt::PreciseTimer, socket,
+                               [socket, connection, data = socket->readAll(), this] {
+                                   process(socket, *connection, data);
+                               });
+        });
+        QObject::connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+    }
+
+    void process(QTcpSocket *socket, Connection &c, const QByteArray &data)
+    {
+        c.buffer += data;
+        if (!c.prefaceReceived) {
+            constexpr qsizetype prefaceLength = 24;
+            if (c.buffer.size() < prefaceLength)
+                return;
+            c.buffer.remove(0, prefaceLength);
+            c.prefaceReceived = true;
+            socket->write(frame(Settings, 0, 0));
+        }
+
+        while (c.buffer.size() >= 9) {
+            const qsizetype length = qFromBigEndian<quint32>(c.buffer.constData()) >> 8;
+            if (c.buffer.size() < 9 + length)
+                break;
+            const char type = c.buffer[3];
+            const char flags = c.buffer[4];
+            const quint32 streamID = qFromBigEndian<quint32>(c.buffer.constData() + 5) & 0x7fffffff;
+            const QByteArray payload = c.buffer.mid(9, length);
+            c.buffer.remove(0, 9 + length);
+
+            switch (type) {
+            case Settings:
+                if (flags & Ack)
+                    break;
+                for (qsizetype i = 0; i + 6 <= payload.size(); i += 6) {
+                    if (qFromBigEndian<quint16>(payload.constData() + i) != 4) // INITIAL_WINDOW_SIZE
+                        continue;
+                    const qint64 size = qFromBigEndian<quint32>(payload.constData() + i + 2);
+                    for (auto &stream : c.streams)
+                        stream.second.window += size - c.initialStreamWindow;
+                    c.initialStreamWindow = size;
+                }
+                socket->write(frame(Settings, Ack, 0));
+                break;
+            case Headers:
+                // HPACK static table entry 8 is ":status: 200"
+                socket->write(frame(Headers, EndHeaders, streamID, "\x88"));
+                c.streams[streamID].window = c.initialStreamWindow;
+                break;
+            case Ping:
+                if (!(flags & Ack))
+                    socket->write(frame(Ping, Ack, 0, payload));
+                break;
+            case WindowUpdate: {
+                const qint64 delta = qFromBigEndian<quint32>(payload.constData()) & 0x7fffffff;
+                if (!streamID)
+                    c.sessionWindow += delta;
+                else if (c.streams.count(streamID))
+                    c.streams[streamID].window += delta;
+                break;
+            }
+            default:
+                break;
+            }
+        }
+
+        for (auto it = c.streams.begin(); it != c.streams.end() && c.sessionWindow > 0;) {
+            auto &stream = it->second;
+            while (stream.window > 0 && c.sessionWindow > 0 && stream.sent < body.size()) {
+                const qsizetype size = qsizetype(std::min<qint64>({ 16384, stream.window, c.sessionWindow,
+                                                                    body.size() - stream.sent }));
+                const bool last = stream.sent + size == body.size();
+                socket->write(frame(Data, last ? EndStream : 0, it->first,
+                                    QByteArrayView(body).sliced(stream.sent, size)));
+                stream.sent += size;
+                stream.window -= size;
+                c.sessionWindow -= size;
+            }
+            if (stream.sent == body.size())
+                it = c.streams.erase(it);
+            else
+                ++it;
+        }
+    }
+
+    const int delay;
+    const QByteArray body;
+    quint16 port = 0;
+    QSemaphore ready;
+};
+
+static constexpr int Latency = 2; // milliseconds per request
+static constexpr int RequestCount = 500;
+
+class tst_QNetworkAccessManager : public QObject
+{
+    Q_OBJECT
+private slots:
+    void concurrentRequests_data();
+    void concurrentRequests();
+    void http2Download_data();
+    void http2Download();
+};
+
+void tst_QNetworkAccessManager::concurrentRequests_data()
+{
+    QTest::addColumn<int>("connections");
+    QTest::addColumn<int>("maximumConnections");
+
+    QTest::newRow("6 connections") << 6 << 6;
+    QTest::newRow("32 connections") << 32 << 32;
+    QTest::newRow("adaptive, 6 to 32 connections") << 6 << 32;
+}
+
+void tst_QNetworkAccessManager::concurrentRequests()
+{
+    QFETCH(int, connections);
+    QFETCH(int, maximumConnections);
+
+    LatencyHttpServer server(Latency);
+    const QUrl url(QStringLiteral("http://127.0.0.1:%1/").arg(server.serverPort()));
+
+    QHttp1Configuration configuration;
+    QVERIFY(configuration.setNumberOfConnectionsPerHost(connections));
+    QVERIFY(configuration.setMaximumNumberOfConnectionsPerHost(maximumConnections));
+    QNetworkRequest request(url);
+    request.setHttp1Configuration(configuration);
+
+    QNetworkAccessManager manager;
+    const auto runRequests = [&] {
+        int finished = 0;
+        for (int i = 0; i < RequestCount; ++i) {
+            QNetworkReply *reply = manager.get(request);
+            connect(reply, &QNetworkReply::finished, reply, [reply, &finished] {
+                QCOMPARE(reply->error(), QNetworkReply::NoError);
+                reply->deleteLater();
+                if (++finished == RequestCount)
+                    QTestEventLoop::instance().exitLoop();
+            });
+        }
+        QTestEventLoop::instance().enterLoop(30);
+        QVERIFY(!QTestEventLoop::instance().timeout());
+    };
+
+    QBENCHMARK {
+        runRequests();
+    }
+
+    const QList<QHttpConnectionPoolStatistics> pools = manager.httpConnectionPoolStatistics();
+    QCOMPARE(pools.size(), 1);
+    const QHttpConnectionPoolStatistics &pool = pools.first();
+    qDebug("%lld connections opened, limit %lld, reuse rate %.3f, queue wait %lld us average",
+           qlonglong(pool.openedConnectionCount()), qlonglong(pool.connectionLimit()),
+           pool.reuseRate(), qlonglong(pool.averageQueueWaitTime().count()));
+}
+
+void tst_QNetworkAccessManager::http2Download_data()
+{
+    QTest::addColumn<bool>("autoTuning");
+
+    QTest::newRow("fixed windows") << false;
+    QTest::newRow("auto-tuned windows") << true;
+}
+
+void tst_QNetworkAccessManager::http2Download()
+{
+    QFETCH(bool, autoTuning);
+
+    constexpr int RoundTripTime = 10; // milliseconds
+    DelayedHttp2Server server(RoundTripTime, QByteArray(8 * 1024 * 1024, 'x'));
+    const QUrl url(QStringLiteral("http://127.0.0.1:%1/").arg(server.serverPort()));
+
+    // Starting with the RFC's 64 KiB windows, as QNetworkRequest does by default:
+    QHttp2Configuration configuration;
+    configuration.setReceiveWindowAutoTuningEnabled(autoTuning);
+    QNetworkRequest request(url);
+    request.setAttribute(QNetworkRequest::Http2DirectAttribute, true);
+    request.setHttp2Configuration(configuration);
+
+    QBENCHMARK {
+        // A new manager each time, so windows start again from their configured size
+        QNetworkAccessManager manager;
+        QNetworkReply *reply = manager.get(request);
+        connect(reply, &QNetworkReply::finished, &QTestEventLoop::instance(),
+                &QTestEventLoop::exitLoop);
+        QTestEventLoop::instance().enterLoop(60);
+        QVERIFY(!QTestEventLoop::instance().timeout());
+        QCOMPARE(reply->error(), QNetworkReply::NoError);
+        QCOMPARE(reply->readAll().size(), 8 * 1024 * 1024);
+        delete reply;
+    }
+}
+
+QTEST_MAIN(tst_QNetworkAccessManager)
+
+#include "tst_bench_qnetworkaccessmanager.moc"
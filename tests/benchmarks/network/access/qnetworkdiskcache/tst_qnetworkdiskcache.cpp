@@ -18,6 +18,7 @@ enum Numbers { NumFakeCacheObjects   = 200,    //entries in pre-populated cache
                NumInsertions  = 100,           //insertions to be timed
                NumRemovals    = 100,           //removals to be timed
                NumReadContent = 100,           //meta requests to be timed
+               NumLargeCacheObjects = 100000,  //entries in a large cache
                HugeCacheLimit = 50*1024*1024,  // max size for a big cache
                TinyCacheLimit = 1*512*1024}; //  max size for a tiny cache
 
@@ -29,7 +30,7 @@ class tst_qnetworkdiskcache : public QObject
 {
     Q_OBJECT
 private:
-    void injectFakeData();
+    void injectFakeData(quint32 count = NumFakeCacheObjects);
     void insertOneItem();
     bool isUrlCached(quint32 id);
     void cleanRecursive(QString &path);
@@ -53,6 +54,11 @@ private slots:
 
     void timeExpiration_data();
     void timeExpiration();
+
+    void timeLargeCacheOpen_data();
+    void timeLargeCacheOpen();
+    void timeLargeCacheExpiration_data();
+    void timeLargeCacheExpiration();
 };
 
 
@@ -299,11 +305,102 @@ void tst_qnetworkdiskcache::timeExpiration()
     cleanRecursive(cacheDir);
 
 }
+void tst_qnetworkdiskcache::timeLargeCacheOpen_data()
+{
+    QTest::addColumn<QString>("cacheRootDirectory");
+
+    QString cacheLoc = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    QTest::newRow("QStandardPaths Cache Location") << cacheLoc;
+}
+
+//Times how long a new cache object takes to find
+//out the size of a cache with many entries
+void tst_qnetworkdiskcache::timeLargeCacheOpen()
+{
+    QFETCH(QString, cacheRootDirectory);
+
+    cacheDir = QString( cacheRootDirectory + QDir::separator() + "man_qndc");
+
+    //Housekeeping
+    cleanRecursive(cacheDir); // slow op.
+    initCacheObject();
+    cache->setCacheDirectory(cacheDir);
+    cache->setMaximumCacheSize(qint64(HugeCacheLimit));
+    cache->clear();
+
+    injectFakeData(NumLargeCacheObjects); // VERY SLOW
+    const qint64 size = cache->cacheSize();
+    cleanupCacheObject();
+
+    QBENCHMARK_ONCE {
+        initCacheObject();
+        cache->setCacheDirectory(cacheDir);
+        cache->setMaximumCacheSize(qint64(HugeCacheLimit));
+        QCOMPARE(cache->cacheSize(), size);
+    }
+
+    //Cleanup (slow)
+    cleanupCacheObject();
+    cleanRecursive(cacheDir);
+}
+
+void tst_qnetworkdiskcache::timeLargeCacheExpiration_data()
+{
+    QTest::addColumn<QString>("cacheRootDirectory");
+
+    QString cacheLoc = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    QTest::newRow("QStandardPaths Cache Location") << cacheLoc;
+}
+
+//Times insertions into a full cache with many entries,
+//each of which has to make room for itself
+void tst_qnetworkdiskcache::timeLargeCacheExpiration()
+{
+    QFETCH(QString, cacheRootDirectory);
+
+    cacheDir = QString( cacheRootDirectory + QDir::separator() + "man_qndc");
+
+    //Housekeeping
+    cleanRecursive(cacheDir); // slow op.
+    initCacheObject();
+    cache->setCacheDirectory(cacheDir);
+    cache->setMaximumCacheSize(qint64(HugeCacheLimit));
+    cache->clear();
+
+    injectFakeData(NumLargeCacheObjects); // VERY SLOW
+
+    //Make the cache full without evicting anything yet,
+    //so that the insertions below cause evictions
+    cache->setMaximumCacheSize(cache->cacheSize() + 1);
+
+    QBENCHMARK_ONCE {
+        for (quint32 i = NumLargeCacheObjects; i < (NumLargeCacheObjects + NumInsertions); i++) {
+            //prepare metata for url
+            QNetworkCacheMetaData meta;
+            QString fakeURL;
+            QTextStream stream(&fakeURL);
+            stream << fakeURLbase << i;
+            QUrl url(fakeURL);
+            meta.setUrl(url);
+            meta.setSaveToDisk(true);
+
+            //commit payload and metadata to disk
+            QIODevice *device = cache->prepare(meta);
+            device->write(payload);
+            cache->insert(device);
+        }
+    }
+
+    //Cleanup (slow)
+    cleanupCacheObject();
+    cleanRecursive(cacheDir);
+}
+
 // This function simulates a partially or fully occupied disk cache
 // like a normal user of a cache might encounter is real-life browsing.
 // The point of this is to trigger degradation in file-system and media performance
 // that occur due to the quantity and layout of data.
-void tst_qnetworkdiskcache::injectFakeData()
+void tst_qnetworkdiskcache::injectFakeData(quint32 count)
 {
 
     QNetworkCacheMetaData::RawHeaderList headers;
@@ -311,7 +408,7 @@ void tst_qnetworkdiskcache::injectFakeData()
 
 
     //Prep cache dir with fake data using QNetworkDiskCache APIs
-    for (quint32 i = 0; i < NumFakeCacheObjects; i++) {
+    for (quint32 i = 0; i < count; i++) {
 
         //prepare metata for url
         QNetworkCacheMetaData meta;
@@ -13,6 +13,12 @@
 #include <qhostinfo.h>
 
 #include <QNetworkProxy>
+#include <QAtomicInteger>
+#include <QEventLoop>
+#include <QThread>
+
+#include <memory>
+#include <vector>
 
 #include "../../../../auto/network-settings.h"
 
@@ -34,6 +40,11 @@ private slots:
     void ipv4LoopbackPerformanceTest();
     void ipv6LoopbackPerformanceTest();
     void ipv4PerformanceTest();
+    void acceptRate_data();
+    void acceptRate();
+
+private:
+    bool testServerAvailable = false;
 };
 
 tst_QTcpServer::tst_QTcpServer()
@@ -57,8 +68,8 @@ void tst_QTcpServer::initTestCase_data()
 
 void tst_QTcpServer::initTestCase()
 {
-    if (!QtNetworkSettings::verifyTestNetworkSettings())
-        QSKIP("No network test server available");
+    // Only ipv4PerformanceTest() needs it; the others run over loopback
+    testServerAvailable = QtNetworkSettings::verifyTestNetworkSettings();
 }
 
 void tst_QTcpServer::init()
@@ -190,6 +201,9 @@ void tst_QTcpServer::ipv6LoopbackPerformanceTest()
 //----------------------------------------------------------------------------------
 void tst_QTcpServer::ipv4PerformanceTest()
 {
+    if (!testServerAvailable)
+        QSKIP("No network test server available");
+
     QTcpSocket probeSocket;
     probeSocket.connectToHost(QtNetworkSettings::serverName(), 143);
     QVERIFY(probeSocket.waitForConnected(5000));
@@ -237,5 +251,73 @@ void tst_QTcpServer::ipv4PerformanceTest()
     delete clientB;
 }
 
+//----------------------------------------------------------------------------------
+class AcceptCountingServer : public QTcpServer
+{
+public:
+    QAtomicInt accepted;
+    int expected = 0;
+    QEventLoop loop;
+
+protected:
+    void incomingConnection(qintptr handle) override
+    {
+        // Only measure accepting; close the connection right away
+        QTcpSocket socket;
+        socket.setSocketDescriptor(handle);
+        if (accepted.fetchAndAddRelaxed(1) + 1 == expected)
+            QMetaObject::invokeMethod(&loop, &QEventLoop::quit, Qt::QueuedConnection);
+    }
+};
+
+void tst_QTcpServer::acceptRate_data()
+{
+    QTest::addColumn<int>("listeners");
+
+    for (int listeners : { 1, 2, 4, 8 })
+        QTest::addRow("%d listeners", listeners) << listeners;
+}
+
+void tst_QTcpServer::acceptRate()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+    QFETCH(int, listeners);
+
+    constexpr int ClientThreads = 8;
+    constexpr int ConnectionsPerThread = 250;
+
+    AcceptCountingServer server;
+    server.setListenerCount(listeners);
+    server.setListenBacklogSize(4096);
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+    if (server.acceptedConnectionCounts().size() != listeners)
+        QSKIP("Multiple listeners are not supported on this platform");
+    const quint16 port = server.serverPort();
+
+    QBENCHMARK {
+        server.accepted.storeRelaxed(0);
+        server.expected = ClientThreads * ConnectionsPerThread;
+
+        std::vector<std::unique_ptr<QThread>> clients;
+        for (int i = 0; i < ClientThreads; ++i) {
+            clients.emplace_back(QThread::create([port] {
+                for (int j = 0; j < ConnectionsPerThread; ++j) {
+                    QTcpSocket socket;
+                    socket.connectToHost(QHostAddress::LocalHost, port);
+                    socket.waitForConnected(5000);
+                }
+            }));
+            clients.back()->start();
+        }
+        server.loop.exec();
+        for (const auto &client : clients)
+            client->wait();
+    }
+
+    QCOMPARE(server.accepted.loadRelaxed(), ClientThreads * ConnectionsPerThread);
+}
+
 QTEST_MAIN(tst_QTcpServer)
 #include "tst_qtcpserver.moc"
@@ -0,0 +1,82 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+#include <QTemporaryFile>
+#include <QTcpServer>
+#include <QTcpSocket>
+
+#include <memory>
+
+class tst_QTcpSocket : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase();
+
+    void fileTransfer_data();
+    void fileTransfer();
+
+private:
+    QTemporaryFile file;
+};
+
+static constexpr qint64 FileSize = 64 * 1024 * 1024;
+
+void tst_QTcpSocket::initTestCase()
+{
+    QVERIFY(file.open());
+    const QByteArray block(1024 * 1024, 'q');
+    for (qint64 i = 0; i < FileSize; i += block.size())
+        QCOMPARE(file.write(block), block.size());
+    QVERIFY(file.flush());
+}
+
+void tst_QTcpSocket::fileTransfer_data()
+{
+    QTest::addColumn<bool>("useSendFile");
+
+    QTest::newRow("read+write") << false;
+    QTest::newRow("sendFile") << true;
+}
+
+void tst_QTcpSocket::fileTransfer()
+{
+    QFETCH(bool, useSendFile);
+
+    QTcpServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+    QTcpSocket client;
+    client.connectToHost(server.serverAddress(), server.serverPort());
+    QVERIFY(client.waitForConnected());
+    QVERIFY(server.waitForNewConnection(5000));
+    std::unique_ptr<QTcpSocket> peer(server.nextPendingConnection());
+    QVERIFY(peer);
+
+    QByteArray buffer(64 * 1024, Qt::Uninitialized);
+    QBENCHMARK {
+        if (useSendFile) {
+            QCOMPARE(client.sendFile(&file), FileSize);
+        } else {
+            QVERIFY(file.seek(0));
+            qint64 n;
+            while ((n = file.read(buffer.data(), buffer.size())) > 0)
+                QCOMPARE(client.write(buffer.constData(), n), n);
+        }
+
+        qint64 received = 0;
+        while (received < FileSize) {
+            if (client.bytesToWrite())
+                client.waitForBytesWritten(0);
+            if (!peer->bytesAvailable())
+                peer->waitForReadyRead(10);
+            while (peer->bytesAvailable())
+                received += peer->read(buffer.data(), buffer.size());
+        }
+        QCOMPARE(received, FileSize);
+    }
+}
+
+QTEST_MAIN(tst_QTcpSocket)
+
+#include "tst_bench_qtcpsocket.moc"
@@ -16,6 +16,8 @@ public:
 private slots:
     void pendingDatagramSize_data();
     void pendingDatagramSize();
+    void loopbackThroughput_data();
+    void loopbackThroughput();
 };
 
 tst_QUdpSocket::tst_QUdpSocket()
@@ -51,5 +53,60 @@ void tst_QUdpSocket::pendingDatagramSize()
     }
 }
 
+void tst_QUdpSocket::loopbackThroughput_data()
+{
+    QTest::addColumn<int>("size");
+    QTest::addColumn<bool>("batched");
+    for (int size : {64, 512, 1400}) {
+        QTest::addRow("%d-single", size) << size << false;
+        QTest::addRow("%d-batched", size) << size << true;
+    }
+}
+
+void tst_QUdpSocket::loopbackThroughput()
+{
+    // Few enough datagrams to fit in the default socket buffers
+    constexpr int Count = 64;
+    QFETCH(int, size);
+    QFETCH(bool, batched);
+
+    QUdpSocket receiver;
+    QVERIFY(receiver.bind(QHostAddress::LocalHost));
+    QUdpSocket sender;
+    QVERIFY(sender.bind(QHostAddress::LocalHost));
+
+    QList<QNetworkDatagram> outgoing(Count);
+    for (QNetworkDatagram &datagram : outgoing) {
+        datagram.setData(QByteArray(size, 'a'));
+        datagram.setDestination(QHostAddress::LocalHost, receiver.localPort());
+    }
+    QList<QNetworkDatagram> incoming(Count);
+
+    QBENCHMARK {
+        if (batched) {
+            QCOMPARE(sender.writeDatagrams(outgoing.constData(), Count), Count);
+        } else {
+            for (const QNetworkDatagram &datagram : std::as_const(outgoing))
+                QCOMPARE(sender.writeDatagram(datagram), size);
+        }
+
+        int received = 0;
+        while (received < Count) {
+            if (!receiver.hasPendingDatagrams() && !receiver.waitForReadyRead(5000))
+                QFAIL("Timed out waiting for datagrams");
+            if (batched) {
+                const qsizetype n = receiver.receiveDatagrams(incoming.data() + received,
+                                                              Count - received);
+                QVERIFY(n >= 0);
+                received += n;
+            } else {
+                while (received < Count && receiver.hasPendingDatagrams())
+                    incoming[received++] = receiver.receiveDatagram();
+            }
+        }
+        QCOMPARE(incoming.last().data().size(), size);
+    }
+}
+
 QTEST_MAIN(tst_QUdpSocket)
 #include "tst_qudpsocket.moc"
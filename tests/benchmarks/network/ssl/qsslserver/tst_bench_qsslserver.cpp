@@ -0,0 +1,138 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+#include <QEventLoop>
+#include <QFile>
+#include <QSignalSpy>
+#include <QSslKey>
+#include <QSslServer>
+#include <QSslSocket>
+
+// The CN of the certificate in certs/
+static constexpr char PeerName[] = "AusweisApp2";
+
+class tst_QSslServer : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase();
+
+    void reconnect_data();
+    void reconnect();
+    void throughput();
+
+private:
+    QSslConfiguration serverConfiguration;
+    QSslConfiguration clientConfiguration;
+};
+
+void tst_QSslServer::initTestCase()
+{
+    if (!QSslSocket::supportsSsl())
+        QSKIP("No TLS backend available");
+
+    QFile keyFile(QStringLiteral(":/certs/selfsigned-server.key"));
+    QVERIFY(keyFile.open(QIODevice::ReadOnly));
+    const QSslKey key(keyFile.readAll(), QSsl::Rsa, QSsl::Pem, QSsl::PrivateKey);
+    QVERIFY(!key.isNull());
+    QFile certificateFile(QStringLiteral(":/certs/selfsigned-server.crt"));
+    QVERIFY(certificateFile.open(QIODevice::ReadOnly));
+    const QList<QSslCertificate> certificates = QSslCertificate::fromData(certificateFile.readAll());
+    QCOMPARE(certificates.size(), 1);
+
+    serverConfiguration = QSslConfiguration::defaultConfiguration();
+    serverConfiguration.setPrivateKey(key);
+    serverConfiguration.setLocalCertificate(certificates.first());
+
+    // Trust the server, so that handshakes complete without errors
+    clientConfiguration = QSslConfiguration::defaultConfiguration();
+    clientConfiguration.setCaCertificates(certificates);
+}
+
+void tst_QSslServer::reconnect_data()
+{
+    QTest::addColumn<bool>("sessionSharing");
+
+    QTest::newRow("full-handshake") << false;
+    QTest::newRow("resumed-session") << true;
+}
+
+void tst_QSslServer::reconnect()
+{
+    QFETCH(bool, sessionSharing);
+
+    QSslServer server;
+    server.setSslConfiguration(serverConfiguration);
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+    connect(&server, &QTcpServer::pendingConnectionAvailable, &server, [&server] {
+        while (QTcpSocket *socket = server.nextPendingConnection()) {
+            // With TLS 1.3, the session ticket follows the handshake; the
+            // client has it once this byte arrives.
+            socket->write("x", 1);
+            connect(socket, &QAbstractSocket::disconnected, socket, &QObject::deleteLater);
+        }
+    });
+
+    QSslConfiguration configuration = clientConfiguration;
+    configuration.setSslOption(QSsl::SslOptionDisableSessionSharing, !sessionSharing);
+    const auto connectOnce = [&] {
+        QSslSocket client;
+        client.setSslConfiguration(configuration);
+        QSignalSpy readyReadSpy(&client, &QIODevice::readyRead);
+        client.connectToHostEncrypted(QHostAddress(QHostAddress::LocalHost).toString(),
+                                      server.serverPort(), QLatin1String(PeerName));
+        QVERIFY(readyReadSpy.wait());
+        QVERIFY(client.isEncrypted());
+        client.disconnectFromHost();
+    };
+
+    // The first connection fills the session cache
+    connectOnce();
+    QBENCHMARK {
+        connectOnce();
+    }
+}
+
+void tst_QSslServer::throughput()
+{
+    constexpr qint64 ChunkSize = 1024 * 1024;
+    constexpr qint64 TotalSize = 64 * ChunkSize;
+
+    QSslServer server;
+    server.setSslConfiguration(serverConfiguration);
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    QSslSocket client;
+    client.setSslConfiguration(clientConfiguration);
+    QSignalSpy pendingSpy(&server, &QTcpServer::pendingConnectionAvailable);
+    client.connectToHostEncrypted(QHostAddress(QHostAddress::LocalHost).toString(),
+                                  server.serverPort(), QLatin1String(PeerName));
+    QVERIFY(pendingSpy.wait());
+    QTcpSocket *peer = server.nextPendingConnection();
+    QVERIFY(peer);
+    QTRY_VERIFY(client.isEncrypted());
+
+    QEventLoop loop;
+    qint64 received = 0;
+    QByteArray buffer(ChunkSize, Qt::Uninitialized);
+    connect(peer, &QIODevice::readyRead, &loop, [&] {
+        while (peer->bytesAvailable())
+            received += peer->read(buffer.data(), buffer.size());
+        if (received >= TotalSize)
+            loop.quit();
+    });
+
+    const QByteArray chunk(ChunkSize, 'q');
+    QBENCHMARK {
+        received = 0;
+        for (qint64 written = 0; written < TotalSize; written += chunk.size())
+            client.write(chunk);
+        loop.exec();
+    }
+    QCOMPARE(received, TotalSize);
+}
+
+QTEST_MAIN(tst_QSslServer)
+
+#include "tst_bench_qsslserver.moc"
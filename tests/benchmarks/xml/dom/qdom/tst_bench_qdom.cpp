@@ -0,0 +1,132 @@
+// Copyright (C) 2022 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QDomDocument>
+#include <QTest>
+
+#if defined(__GLIBC__) && defined(__GLIBC_PREREQ)
+#  if __GLIBC_PREREQ(2, 33)
+#    include <malloc.h>
+#    define HAVE_MALLINFO2
+#  endif
+#endif
+
+class tst_QDom : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase();
+
+    void setContent_data();
+    void setContent();
+    void memoryUsage_data();
+    void memoryUsage();
+    void traverse();
+
+private:
+    QByteArray plain;
+    QByteArray namespaced;
+};
+
+static QByteArray plainDocument(int records)
+{
+    QByteArray xml = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<records>\n";
+    for (int i = 0; i < records; ++i) {
+        const QByteArray n = QByteArray::number(i);
+        xml += "  <record id=\"" + n + "\" type=\"entry\" enabled=\"true\">\n"
+               "    <name>Record " + n + "</name>\n"
+               "    <description>Some description of record number " + n + "</description>\n"
+               "    <value unit=\"ms\">" + QByteArray::number(i * 7) + "</value>\n"
+               "  </record>\n";
+    }
+    xml += "</records>\n";
+    return xml;
+}
+
+static QByteArray namespacedDocument(int records)
+{
+    QByteArray xml = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                     "<r:records xmlns:r=\"http://www.example.com/records\" "
+                     "xmlns:m=\"http://www.example.com/meta\">\n";
+    for (int i = 0; i < records; ++i) {
+        const QByteArray n = QByteArray::number(i);
+        xml += "  <r:record m:id=\"" + n + "\" m:type=\"entry\">\n"
+               "    <r:name>Record " + n + "</r:name>\n"
+               "    <m:value m:unit=\"ms\">" + QByteArray::number(i * 7) + "</m:value>\n"
+               "  </r:record>\n";
+    }
+    xml += "</r:records>\n";
+    return xml;
+}
+
+void tst_QDom::initTestCase()
+{
+    plain = plainDocument(20000);
+    namespaced = namespacedDocument(20000);
+}
+
+void tst_QDom::setContent_data()
+{
+    QTest::addColumn<QByteArray>("xml");
+    QTest::addColumn<bool>("namespaceProcessing");
+
+    QTest::newRow("plain") << plain << false;
+    QTest::newRow("plain-ns") << plain << true;
+    QTest::newRow("namespaced") << namespaced << false;
+    QTest::newRow("namespaced-ns") << namespaced << true;
+}
+
+void tst_QDom::setContent()
+{
+    QFETCH(QByteArray, xml);
+    QFETCH(bool, namespaceProcessing);
+
+    QBENCHMARK {
+        QDomDocument doc;
+        QVERIFY(doc.setContent(xml, namespaceProcessing));
+    }
+}
+
+void tst_QDom::memoryUsage_data()
+{
+    setContent_data();
+}
+
+void tst_QDom::memoryUsage()
+{
+#ifdef HAVE_MALLINFO2
+    QFETCH(QByteArray, xml);
+    QFETCH(bool, namespaceProcessing);
+
+    const size_t before = mallinfo2().uordblks;
+    QDomDocument doc;
+    QVERIFY(doc.setContent(xml, namespaceProcessing));
+    const size_t after = mallinfo2().uordblks;
+    QTest::setBenchmarkResult(qreal(after - before), QTest::BytesAllocated);
+#else
+    QSKIP("Heap usage can only be measured with glibc 2.33 or later");
+#endif
+}
+
+void tst_QDom::traverse()
+{
+    QDomDocument doc;
+    QVERIFY(doc.setContent(plain));
+
+    QBENCHMARK {
+        qsizetype total = 0;
+        for (QDomElement record = doc.documentElement().firstChildElement();
+             !record.isNull(); record = record.nextSiblingElement()) {
+            total += record.attribute(QStringLiteral("id")).size();
+            for (QDomElement child = record.firstChildElement(); !child.isNull();
+                 child = child.nextSiblingElement()) {
+                total += child.tagName().size() + child.text().size();
+            }
+        }
+        QVERIFY(total > 0);
+    }
+}
+
+QTEST_MAIN(tst_QDom)
+
+#include "tst_bench_qdom.moc"